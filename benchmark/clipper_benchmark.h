@@ -0,0 +1,141 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_BENCHMARK_CLIPPER_BENCHMARK_H
+#define CURAENGINE_BENCHMARK_CLIPPER_BENCHMARK_H
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+#include <boost/geometry/geometries/multi_polygon.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+#include <boost/geometry/io/wkt/read.hpp>
+#include <polyclipping/clipper.hpp>
+
+#include "utils/polygon.h"
+
+namespace cura
+{
+/*!
+ * Runs the boolean operations and offsets of Polygons over all shapes of the stress benchmark corpus.
+ */
+class ClipperTestFixture : public benchmark::Fixture
+{
+public:
+    static constexpr coord_t offset_distance = 400;
+
+    std::vector<Polygons> shapes;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        using point_type = boost::geometry::model::d2::point_xy<double>;
+        using polygon_type = boost::geometry::model::polygon<point_type>;
+        using multi_polygon_type = boost::geometry::model::multi_polygon<polygon_type>;
+
+        shapes.clear();
+        const auto resources = std::filesystem::path(__FILE__).parent_path().parent_path().append("stress_benchmark/resources");
+        for (const auto& entry : std::filesystem::directory_iterator(resources))
+        {
+            if (entry.path().extension() != ".wkt")
+            {
+                continue;
+            }
+            std::ifstream file{ entry.path() };
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            multi_polygon_type boost_polygons{};
+            boost::geometry::read_wkt(buffer.str(), boost_polygons);
+
+            Polygons shape;
+            for (const auto& boost_polygon : boost_polygons)
+            {
+                Polygon outer;
+                for (const auto& point : boost_polygon.outer())
+                {
+                    outer.add(Point2LL(point.x(), point.y()));
+                }
+                shape.add(outer);
+                for (const auto& hole : boost_polygon.inners())
+                {
+                    Polygon inner;
+                    for (const auto& point : hole)
+                    {
+                        inner.add(Point2LL(point.x(), point.y()));
+                    }
+                    shape.add(inner);
+                }
+            }
+            shapes.push_back(std::move(shape));
+        }
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+    }
+};
+
+/*!
+ * The way the operations were done before: a new Clipper engine and a new result for every operation.
+ */
+BENCHMARK_DEFINE_F(ClipperTestFixture, fresh_engines)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        for (const Polygons& shape : shapes)
+        {
+            ClipperLib::Paths cleaned; // Polygons::offset unions the shape with itself first.
+            ClipperLib::Clipper clean_clipper(clipper_init);
+            clean_clipper.AddPaths(shape.paths, ClipperLib::ptSubject, true);
+            clean_clipper.Execute(ClipperLib::ctUnion, cleaned, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+
+            ClipperLib::Paths offsetted;
+            ClipperLib::ClipperOffset offsetter(1.2, 10.0);
+            offsetter.AddPaths(cleaned, ClipperLib::jtMiter, ClipperLib::etClosedPolygon);
+            offsetter.Execute(offsetted, -offset_distance);
+
+            ClipperLib::Paths unioned;
+            ClipperLib::Clipper union_clipper(clipper_init);
+            union_clipper.AddPaths(shape.paths, ClipperLib::ptSubject, true);
+            union_clipper.AddPaths(offsetted, ClipperLib::ptSubject, true);
+            union_clipper.Execute(ClipperLib::ctUnion, unioned, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+
+            ClipperLib::Paths differenced;
+            ClipperLib::Clipper difference_clipper(clipper_init);
+            difference_clipper.AddPaths(unioned, ClipperLib::ptSubject, true);
+            difference_clipper.AddPaths(offsetted, ClipperLib::ptClip, true);
+            difference_clipper.Execute(ClipperLib::ctDifference, differenced);
+
+            ClipperLib::Paths intersected;
+            ClipperLib::Clipper intersection_clipper(clipper_init);
+            intersection_clipper.AddPaths(differenced, ClipperLib::ptSubject, true);
+            intersection_clipper.AddPaths(shape.paths, ClipperLib::ptClip, true);
+            intersection_clipper.Execute(ClipperLib::ctIntersection, intersected);
+            benchmark::DoNotOptimize(intersected);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(ClipperTestFixture, fresh_engines);
+
+BENCHMARK_DEFINE_F(ClipperTestFixture, pooled_engines)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        for (const Polygons& shape : shapes)
+        {
+            const Polygons offsetted = shape.offset(-offset_distance);
+            const Polygons unioned = shape.unionPolygons(offsetted);
+            const Polygons differenced = unioned.difference(offsetted);
+            Polygons intersected = differenced.intersection(shape);
+            benchmark::DoNotOptimize(intersected);
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(ClipperTestFixture, pooled_engines);
+
+} // namespace cura
+#endif // CURAENGINE_BENCHMARK_CLIPPER_BENCHMARK_H
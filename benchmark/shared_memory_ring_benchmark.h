@@ -0,0 +1,86 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_BENCHMARK_SHARED_MEMORY_RING_BENCHMARK_H
+#define CURAENGINE_BENCHMARK_SHARED_MEMORY_RING_BENCHMARK_H
+
+#include <filesystem>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include "../tests/ReadTestPolygons.h"
+#include "plugins/sharedmemoryring.h"
+#include "utils/polygon.h"
+
+namespace cura
+{
+/*!
+ * Sends slice polygons to a local echo plugin and back through a pair of shared memory rings, to measure the throughput of the transport.
+ */
+class SharedMemoryRingTestFixture : public benchmark::Fixture
+{
+public:
+    const std::vector<std::string> POLYGON_FILENAMES = { std::filesystem::path(__FILE__).parent_path().parent_path().append("tests/resources/slice_polygon_1.txt").string(),
+                                                         std::filesystem::path(__FILE__).parent_path().parent_path().append("tests/resources/slice_polygon_2.txt").string(),
+                                                         std::filesystem::path(__FILE__).parent_path().parent_path().append("tests/resources/slice_polygon_3.txt").string(),
+                                                         std::filesystem::path(__FILE__).parent_path().parent_path().append("tests/resources/slice_polygon_4.txt").string() };
+
+    std::vector<Polygons> shapes;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        shapes.clear();
+        readTestPolygons(POLYGON_FILENAMES, shapes);
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+    }
+};
+
+BENCHMARK_DEFINE_F(SharedMemoryRingTestFixture, echo_plugin_round_trip)(benchmark::State& st)
+{
+    const std::string name = fmt::format("cura_ring_benchmark_{}", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    plugins::SharedMemoryRing requests = plugins::SharedMemoryRing::create(name + "_request");
+    plugins::SharedMemoryRing responses = plugins::SharedMemoryRing::create(name + "_response");
+
+    std::thread plugin(
+        [&name]()
+        {
+            plugins::SharedMemoryRing plugin_requests = plugins::SharedMemoryRing::open(name + "_request");
+            plugins::SharedMemoryRing plugin_responses = plugins::SharedMemoryRing::open(name + "_response");
+            Polygons shape;
+            while (true)
+            {
+                plugin_requests.pop(shape);
+                if (shape.empty())
+                {
+                    return; // Stop request.
+                }
+                plugin_responses.push(shape);
+            }
+        });
+
+    size_t bytes = 0;
+    Polygons received;
+    for (auto _ : st)
+    {
+        for (const Polygons& shape : shapes)
+        {
+            requests.push(shape);
+            responses.pop(received);
+            bytes += 2 * shape.pointCount() * sizeof(Point2LL);
+        }
+        benchmark::DoNotOptimize(received);
+    }
+    requests.push(Polygons());
+    plugin.join();
+    st.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+
+BENCHMARK_REGISTER_F(SharedMemoryRingTestFixture, echo_plugin_round_trip)->UseRealTime();
+
+} // namespace cura
+#endif // CURAENGINE_BENCHMARK_SHARED_MEMORY_RING_BENCHMARK_H
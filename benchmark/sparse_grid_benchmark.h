@@ -0,0 +1,148 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef CURAENGINE_BENCHMARK_SPARSE_GRID_BENCHMARK_H
+#define CURAENGINE_BENCHMARK_SPARSE_GRID_BENCHMARK_H
+
+#include "../tests/ReadTestPolygons.h"
+#include "utils/SparsePointGridInclusive.h"
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <functional>
+#include <unordered_map>
+
+namespace cura
+{
+class SparseGridTestFixture : public benchmark::Fixture
+{
+public:
+    const std::vector<std::string> POLYGON_FILENAMES = { std::filesystem::path(__FILE__).parent_path().parent_path().append("tests/resources/slice_polygon_1.txt").string(),
+                                                         std::filesystem::path(__FILE__).parent_path().parent_path().append("tests/resources/slice_polygon_2.txt").string(),
+                                                         std::filesystem::path(__FILE__).parent_path().parent_path().append("tests/resources/slice_polygon_3.txt").string(),
+                                                         std::filesystem::path(__FILE__).parent_path().parent_path().append("tests/resources/slice_polygon_4.txt").string() };
+
+    static constexpr coord_t cell_size = 400;
+
+    std::vector<Point2LL> points;
+
+    void SetUp(const ::benchmark::State& state)
+    {
+        std::vector<Polygons> shapes;
+        readTestPolygons(POLYGON_FILENAMES, shapes);
+        points.clear();
+        for (const auto& polys : shapes)
+        {
+            for (const auto& poly : polys)
+            {
+                points.insert(points.end(), poly.begin(), poly.end());
+            }
+        }
+    }
+
+    void TearDown(const ::benchmark::State& state)
+    {
+    }
+};
+
+/*!
+ * The way the grid was implemented before: a node based multimap, visited through a std::function.
+ */
+BENCHMARK_DEFINE_F(SparseGridTestFixture, unordered_multimap_build_and_query)(benchmark::State& st)
+{
+    const SquareGrid square_grid(cell_size);
+    for (auto _ : st)
+    {
+        std::unordered_multimap<Point2LL, size_t> grid;
+        grid.reserve(points.size());
+        for (size_t idx = 0; idx < points.size(); ++idx)
+        {
+            grid.emplace(square_grid.toGridPoint(points[idx]), idx);
+        }
+        size_t found = 0;
+        const std::function<bool(const size_t&)> process_func = [&found](const size_t& idx)
+        {
+            found += idx;
+            return true;
+        };
+        for (const Point2LL& point : points)
+        {
+            square_grid.processNearby(
+                point,
+                cell_size,
+                [&grid, &process_func](const SquareGrid::GridPoint& grid_pt)
+                {
+                    auto range = grid.equal_range(grid_pt);
+                    for (auto it = range.first; it != range.second; ++it)
+                    {
+                        if (! process_func(it->second))
+                        {
+                            return false;
+                        }
+                    }
+                    return true;
+                });
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+BENCHMARK_REGISTER_F(SparseGridTestFixture, unordered_multimap_build_and_query);
+
+BENCHMARK_DEFINE_F(SparseGridTestFixture, sparse_grid_incremental_build_and_query)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        SparsePointGridInclusive<size_t> grid(cell_size, points.size());
+        for (size_t idx = 0; idx < points.size(); ++idx)
+        {
+            grid.insert(points[idx], idx);
+        }
+        size_t found = 0;
+        for (const Point2LL& point : points)
+        {
+            grid.processNearby(
+                point,
+                cell_size,
+                [&found](const SparsePointGridInclusive<size_t>::Elem& elem)
+                {
+                    found += elem.val;
+                    return true;
+                });
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+BENCHMARK_REGISTER_F(SparseGridTestFixture, sparse_grid_incremental_build_and_query);
+
+BENCHMARK_DEFINE_F(SparseGridTestFixture, sparse_grid_compact_build_and_query)(benchmark::State& st)
+{
+    for (auto _ : st)
+    {
+        SparsePointGridInclusive<size_t> grid(cell_size, points.size());
+        for (size_t idx = 0; idx < points.size(); ++idx)
+        {
+            grid.insert(points[idx], idx);
+        }
+        grid.compact();
+        size_t found = 0;
+        for (const Point2LL& point : points)
+        {
+            grid.processNearby(
+                point,
+                cell_size,
+                [&found](const SparsePointGridInclusive<size_t>::Elem& elem)
+                {
+                    found += elem.val;
+                    return true;
+                });
+        }
+        benchmark::DoNotOptimize(found);
+    }
+}
+
+BENCHMARK_REGISTER_F(SparseGridTestFixture, sparse_grid_compact_build_and_query);
+
+} // namespace cura
+#endif // CURAENGINE_BENCHMARK_SPARSE_GRID_BENCHMARK_H
@@ -32,6 +32,7 @@ class CuraEngineConan(ConanFile):
         "enable_plugins": [True, False],
         "enable_sentry": [True, False],
         "enable_remote_plugins": [True, False],
+        "enable_performance_counters": [True, False],
     }
     default_options = {
         "enable_arcus": True,
@@ -40,6 +41,7 @@ class CuraEngineConan(ConanFile):
         "enable_plugins": True,
         "enable_sentry": False,
         "enable_remote_plugins": False,
+        "enable_performance_counters": False,
     }
 
     def set_version(self):
@@ -61,6 +63,7 @@ class CuraEngineConan(ConanFile):
         copy(self, "*", path.join(self.recipe_folder, "include"), path.join(self.export_sources_folder, "include"))
         copy(self, "*", path.join(self.recipe_folder, "benchmark"), path.join(self.export_sources_folder, "benchmark"))
         copy(self, "*", path.join(self.recipe_folder, "stress_benchmark"), path.join(self.export_sources_folder, "stress_benchmark"))
+        copy(self, "*", path.join(self.recipe_folder, "end_to_end_benchmark"), path.join(self.export_sources_folder, "end_to_end_benchmark"))
         copy(self, "*", path.join(self.recipe_folder, "tests"), path.join(self.export_sources_folder, "tests"))
 
     def config_options(self):
@@ -139,6 +142,7 @@ class CuraEngineConan(ConanFile):
         tc.variables["ENABLE_TESTING"] = not self.conf.get("tools.build:skip_test", False, check_type=bool)
         tc.variables["ENABLE_BENCHMARKS"] = self.options.enable_benchmarks
         tc.variables["EXTENSIVE_WARNINGS"] = self.options.enable_extensive_warnings
+        tc.variables["ENABLE_PERFORMANCE_COUNTERS"] = self.options.enable_performance_counters
         tc.variables["OLDER_APPLE_CLANG"] = self.settings.compiler == "apple-clang" and Version(self.settings.compiler.version) < "14"
         tc.variables["ENABLE_THREADING"] = not (self.settings.arch == "wasm" and self.settings.os == "Emscripten")
         if self.options.get_safe("enable_sentry", False):
@@ -164,6 +168,7 @@ class CuraEngineConan(ConanFile):
             if self.options.enable_benchmarks:
                 folder_dists.append("benchmark")
                 folder_dists.append("stress_benchmark")
+                folder_dists.append("end_to_end_benchmark")
 
             for dist_folder in folder_dists:
                 dist_path = path.join(self.build_folder, dist_folder)
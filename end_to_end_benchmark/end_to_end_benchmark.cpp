@@ -0,0 +1,491 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <docopt/docopt.h>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <numbers>
+#include <ostream>
+#include <source_location>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include "Application.h"
+#include "ExtruderTrain.h"
+#include "FffProcessor.h"
+#include "Slice.h"
+#include "communication/CommandLine.h"
+#include "mesh.h"
+#include "progress/Progress.h"
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+#include "utils/Point3LL.h"
+
+
+constexpr std::string_view USAGE = R"(End-to-end Benchmark.
+
+Slices a set of generated models with the whole CuraEngine pipeline and reports
+the wall time, the time per stage, the peak memory use and the G-code throughput
+of each model.
+
+Usage:
+  end_to_end_benchmark -o FILE
+  end_to_end_benchmark (-h | --help)
+  end_to_end_benchmark --version
+
+Options:
+  -h --help                        Show this screen.
+  --version                        Show version.
+  -o FILE                          Specify the output Json file.
+)";
+
+/*!
+ * Builds a mesh out of simple shapes. Coordinates are in microns, with the
+ * origin at the centre of the build plate.
+ */
+class MeshBuilder
+{
+public:
+    explicit MeshBuilder(cura::Settings& parent_settings)
+        : mesh_(parent_settings)
+    {
+    }
+
+    /*!
+     * Add a triangle, with its corners counter-clockwise as seen from the
+     * outside.
+     */
+    void triangle(cura::Point3LL a, cura::Point3LL b, cura::Point3LL c)
+    {
+        mesh_.addFace(a, b, c);
+    }
+
+    void quad(const cura::Point3LL& a, const cura::Point3LL& b, const cura::Point3LL& c, const cura::Point3LL& d)
+    {
+        triangle(a, b, c);
+        triangle(a, c, d);
+    }
+
+    void box(const cura::Point3LL& min, const cura::Point3LL& max)
+    {
+        const auto corner = [&min, &max](const bool x, const bool y, const bool z)
+        {
+            return cura::Point3LL(x ? max.x_ : min.x_, y ? max.y_ : min.y_, z ? max.z_ : min.z_);
+        };
+        quad(corner(0, 0, 0), corner(0, 1, 0), corner(1, 1, 0), corner(1, 0, 0)); // Bottom.
+        quad(corner(0, 0, 1), corner(1, 0, 1), corner(1, 1, 1), corner(0, 1, 1)); // Top.
+        quad(corner(0, 0, 0), corner(1, 0, 0), corner(1, 0, 1), corner(0, 0, 1)); // Front.
+        quad(corner(1, 1, 0), corner(0, 1, 0), corner(0, 1, 1), corner(1, 1, 1)); // Back.
+        quad(corner(0, 1, 0), corner(0, 0, 0), corner(0, 0, 1), corner(0, 1, 1)); // Left.
+        quad(corner(1, 0, 0), corner(1, 1, 0), corner(1, 1, 1), corner(1, 0, 1)); // Right.
+    }
+
+    void cylinder(const cura::coord_t center_x, const cura::coord_t center_y, const cura::coord_t radius, const cura::coord_t bottom, const cura::coord_t top, const size_t segments = 64)
+    {
+        const auto rim = [&](const size_t segment_idx, const cura::coord_t z)
+        {
+            const double angle = 2.0 * std::numbers::pi * static_cast<double>(segment_idx % segments) / static_cast<double>(segments);
+            return cura::Point3LL(center_x + std::llrint(radius * std::cos(angle)), center_y + std::llrint(radius * std::sin(angle)), z);
+        };
+        for (size_t segment_idx = 0; segment_idx < segments; ++segment_idx)
+        {
+            quad(rim(segment_idx, bottom), rim(segment_idx + 1, bottom), rim(segment_idx + 1, top), rim(segment_idx, top));
+            triangle(cura::Point3LL(center_x, center_y, bottom), rim(segment_idx + 1, bottom), rim(segment_idx, bottom));
+            triangle(cura::Point3LL(center_x, center_y, top), rim(segment_idx, top), rim(segment_idx + 1, top));
+        }
+    }
+
+    void sphere(const cura::Point3LL& center, const cura::coord_t radius, const size_t rings = 48, const size_t segments = 96)
+    {
+        const auto vertex = [&](const size_t ring_idx, const size_t segment_idx)
+        {
+            const double polar = std::numbers::pi * static_cast<double>(ring_idx) / static_cast<double>(rings);
+            const double azimuth = 2.0 * std::numbers::pi * static_cast<double>(segment_idx % segments) / static_cast<double>(segments);
+            return center
+                 + cura::Point3LL(
+                       std::llrint(radius * std::sin(polar) * std::cos(azimuth)),
+                       std::llrint(radius * std::sin(polar) * std::sin(azimuth)),
+                       std::llrint(radius * std::cos(polar)));
+        };
+        for (size_t ring_idx = 0; ring_idx < rings; ++ring_idx)
+        {
+            for (size_t segment_idx = 0; segment_idx < segments; ++segment_idx)
+            {
+                const cura::Point3LL a = vertex(ring_idx, segment_idx);
+                const cura::Point3LL b = vertex(ring_idx + 1, segment_idx);
+                const cura::Point3LL c = vertex(ring_idx + 1, segment_idx + 1);
+                const cura::Point3LL d = vertex(ring_idx, segment_idx + 1);
+                if (ring_idx != rings - 1) // At the bottom pole b and c coincide.
+                {
+                    triangle(a, b, c);
+                }
+                if (ring_idx != 0) // At the top pole a and d coincide.
+                {
+                    triangle(a, c, d);
+                }
+            }
+        }
+    }
+
+    cura::Mesh finish(const std::string& name)
+    {
+        mesh_.mesh_name_ = name;
+        mesh_.finish();
+        return std::move(mesh_);
+    }
+
+private:
+    cura::Mesh mesh_;
+};
+
+struct BenchmarkCase
+{
+    std::string name;
+    std::vector<std::pair<std::string, std::string>> settings; //!< Changes to the base settings.
+    std::function<void(cura::Slice&)> add_meshes;
+};
+
+/*!
+ * The results of one case, which are sent from the process that slices to the
+ * parent process as raw bytes.
+ */
+struct CaseResult
+{
+    double wall_time; //!< In seconds.
+    std::array<double, cura::N_PROGRESS_STAGES> stage_times; //!< In seconds.
+    long peak_rss_kib;
+    size_t gcode_bytes;
+};
+
+/*!
+ * Counts the G-code that is written to it and throws it away.
+ */
+class CountingBuffer : public std::streambuf
+{
+public:
+    size_t count() const
+    {
+        return count_;
+    }
+
+protected:
+    int_type overflow(int_type character) override
+    {
+        if (! traits_type::eq_int_type(character, traits_type::eof()))
+        {
+            ++count_;
+        }
+        return traits_type::not_eof(character);
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize count) override
+    {
+        count_ += static_cast<size_t>(count);
+        return count;
+    }
+
+private:
+    size_t count_ = 0;
+};
+
+std::filesystem::path resourcePath()
+{
+    return std::filesystem::path(std::source_location::current().file_name()).parent_path().append("resources");
+}
+
+std::vector<BenchmarkCase> getCases()
+{
+    constexpr cura::coord_t mm = 1000;
+    std::vector<BenchmarkCase> cases;
+
+    // Hundreds of layers with little area each, where the per-layer overhead dominates.
+    cases.push_back(BenchmarkCase{ .name = "tall_thin_parts",
+                                   .settings = { { "machine_extruder_count", "1" }, { "adhesion_type", "skirt" } },
+                                   .add_meshes =
+                                       [](cura::Slice& slice)
+                                   {
+                                       for (int pillar_idx = 0; pillar_idx < 6; ++pillar_idx)
+                                       {
+                                           MeshBuilder builder(slice.scene.extruders[0].settings_);
+                                           const cura::coord_t x = (pillar_idx - 3) * 15 * mm;
+                                           if (pillar_idx % 2 == 0)
+                                           {
+                                               builder.box(cura::Point3LL(x - 2 * mm, -2 * mm, 0), cura::Point3LL(x + 2 * mm, 2 * mm, 150 * mm));
+                                           }
+                                           else
+                                           {
+                                               builder.cylinder(x, 0, 2 * mm, 0, 150 * mm);
+                                           }
+                                           slice.scene.mesh_groups[0].meshes.push_back(builder.finish(fmt::format("pillar_{}", pillar_idx)));
+                                       }
+                                   } });
+
+    // Many islands per layer, which stresses travel planning and ordering.
+    cases.push_back(BenchmarkCase{ .name = "many_small_parts",
+                                   .settings = { { "machine_extruder_count", "1" }, { "adhesion_type", "brim" } },
+                                   .add_meshes =
+                                       [](cura::Slice& slice)
+                                   {
+                                       MeshBuilder builder(slice.scene.extruders[0].settings_);
+                                       for (int row_idx = 0; row_idx < 12; ++row_idx)
+                                       {
+                                           for (int column_idx = 0; column_idx < 12; ++column_idx)
+                                           {
+                                               builder.cylinder((column_idx - 6) * 9 * mm, (row_idx - 6) * 9 * mm, 3 * mm, 0, 5 * mm, 32);
+                                           }
+                                       }
+                                       slice.scene.mesh_groups[0].meshes.push_back(builder.finish("studs"));
+                                   } });
+
+    // Overhangs all around, supported by organic tree support.
+    cases.push_back(BenchmarkCase{ .name = "organic_tree_support",
+                                   .settings = { { "machine_extruder_count", "1" },
+                                                 { "adhesion_type", "none" },
+                                                 { "support_enable", "True" },
+                                                 { "support_structure", "tree" },
+                                                 { "support_type", "everywhere" } },
+                                   .add_meshes =
+                                       [](cura::Slice& slice)
+                                   {
+                                       MeshBuilder mushroom(slice.scene.extruders[0].settings_);
+                                       mushroom.cylinder(-30 * mm, 0, 4 * mm, 0, 40 * mm);
+                                       mushroom.cylinder(-30 * mm, 0, 25 * mm, 40 * mm, 45 * mm);
+                                       slice.scene.mesh_groups[0].meshes.push_back(mushroom.finish("mushroom"));
+
+                                       MeshBuilder ball(slice.scene.extruders[0].settings_);
+                                       ball.sphere(cura::Point3LL(30 * mm, 0, 45 * mm), 25 * mm);
+                                       slice.scene.mesh_groups[0].meshes.push_back(ball.finish("ball"));
+                                   } });
+
+    // Two materials that alternate on every layer, with a prime tower.
+    cases.push_back(BenchmarkCase{ .name = "multi_extruder",
+                                   .settings = { { "machine_extruder_count", "2" }, { "adhesion_type", "skirt" }, { "prime_tower_enable", "True" } },
+                                   .add_meshes =
+                                       [](cura::Slice& slice)
+                                   {
+                                       for (size_t extruder_nr = 0; extruder_nr < 2; ++extruder_nr)
+                                       {
+                                           MeshBuilder builder(slice.scene.extruders[extruder_nr].settings_);
+                                           for (int tower_idx = 0; tower_idx < 3; ++tower_idx)
+                                           {
+                                               const cura::coord_t x = (tower_idx - 1) * 25 * mm;
+                                               const cura::coord_t y = extruder_nr == 0 ? -12 * mm : 12 * mm;
+                                               builder.box(cura::Point3LL(x - 10 * mm, y - 10 * mm, 0), cura::Point3LL(x + 10 * mm, y + 10 * mm, 30 * mm));
+                                           }
+                                           cura::Mesh mesh = builder.finish(fmt::format("extruder_{}", extruder_nr));
+                                           mesh.settings_.add("extruder_nr", std::to_string(extruder_nr));
+                                           slice.scene.mesh_groups[0].meshes.push_back(std::move(mesh));
+                                       }
+                                   } });
+
+    return cases;
+}
+
+void loadSettings(cura::Settings& settings, const std::filesystem::path& settings_file)
+{
+    std::ifstream file{ settings_file };
+    if (! file)
+    {
+        spdlog::critical("Could not read settings from: {}", settings_file.string());
+        exit(EXIT_FAILURE);
+    }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream iss(line);
+        std::string key;
+        std::string value;
+
+        if (std::getline(std::getline(iss, key, '='), value))
+        {
+            settings.add(key, value);
+        }
+    }
+}
+
+void handleChildProcess(const BenchmarkCase& benchmark_case, const int result_fd)
+{
+    spdlog::set_level(spdlog::level::warn); // Don't measure how fast the terminal is.
+
+    cura::Application& application = cura::Application::getInstance();
+    application.communication_ = new cura::CommandLine({}); // The engine reports progress through it, which is only logged on the command line.
+    application.startThreadPool();
+    cura::Progress::init();
+
+    CountingBuffer gcode_buffer;
+    std::ostream gcode(&gcode_buffer);
+    cura::FffProcessor::getInstance()->setTargetStream(&gcode);
+
+    cura::Slice slice(1);
+    application.current_slice_ = &slice;
+    loadSettings(slice.scene.settings, resourcePath().append("base.settings"));
+    for (const auto& [key, value] : benchmark_case.settings)
+    {
+        slice.scene.settings.add(key, value);
+    }
+    const auto extruder_count = slice.scene.settings.get<size_t>("machine_extruder_count");
+    slice.scene.extruders.reserve(extruder_count);
+    for (size_t extruder_nr = 0; extruder_nr < extruder_count; ++extruder_nr)
+    {
+        slice.scene.extruders.emplace_back(extruder_nr, &slice.scene.settings);
+        slice.scene.extruders.back().settings_.add("extruder_nr", std::to_string(extruder_nr));
+    }
+    benchmark_case.add_meshes(slice);
+    slice.scene.mesh_groups[0].finalize();
+
+    const auto start = std::chrono::steady_clock::now();
+    slice.compute();
+    cura::FffProcessor::getInstance()->finalize();
+    gcode.flush();
+    const std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - start;
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    const auto peak_rss_kib = usage.ru_maxrss / 1024; // In bytes on macOS.
+#else
+    const auto peak_rss_kib = usage.ru_maxrss; // In kilobytes on Linux.
+#endif
+
+    const CaseResult result{ .wall_time = wall_time.count(),
+                             .stage_times = cura::Progress::getStageDurations(),
+                             .peak_rss_kib = peak_rss_kib,
+                             .gcode_bytes = gcode_buffer.count() };
+    [[maybe_unused]] const auto written = write(result_fd, &result, sizeof(result));
+    exit(EXIT_SUCCESS);
+}
+
+rapidjson::Value
+    createRapidJSONObject(rapidjson::Document::AllocatorType& allocator, const std::string& test_name, const auto value, const std::string& unit, const std::string& extra_info)
+{
+    rapidjson::Value obj(rapidjson::kObjectType);
+    rapidjson::Value key("name", allocator);
+    rapidjson::Value val1(test_name.c_str(), test_name.length(), allocator);
+    obj.AddMember(key, val1, allocator);
+    key.SetString("unit", allocator);
+    rapidjson::Value val2(unit.c_str(), unit.length(), allocator);
+    obj.AddMember(key, val2, allocator);
+    key.SetString("value", allocator);
+    rapidjson::Value val3(value);
+    obj.AddMember(key, val3, allocator);
+    key.SetString("extra", allocator);
+    rapidjson::Value val4(extra_info.c_str(), extra_info.length(), allocator);
+    obj.AddMember(key, val4, allocator);
+    return obj;
+}
+
+void createAndWriteJson(const std::filesystem::path& out_file, const std::vector<std::pair<std::string, CaseResult>>& results)
+{
+    rapidjson::Document doc;
+    doc.SetArray();
+    rapidjson::Document::AllocatorType& allocator = doc.GetAllocator();
+    for (const auto& [name, result] : results)
+    {
+        auto wall_time_obj = createRapidJSONObject(allocator, fmt::format("{} wall time", name), result.wall_time, "s", "");
+        doc.PushBack(wall_time_obj, allocator);
+        for (size_t stage_idx = 0; stage_idx < cura::N_PROGRESS_STAGES; ++stage_idx)
+        {
+            if (result.stage_times[stage_idx] <= 0.0)
+            {
+                continue;
+            }
+            const std::string_view stage_name = cura::Progress::getStageName(static_cast<cura::Progress::Stage>(stage_idx));
+            auto stage_obj = createRapidJSONObject(allocator, fmt::format("{} {} time", name, stage_name), result.stage_times[stage_idx], "s", "");
+            doc.PushBack(stage_obj, allocator);
+        }
+        auto rss_obj = createRapidJSONObject(allocator, fmt::format("{} peak RSS", name), static_cast<double>(result.peak_rss_kib) / 1024.0, "MiB", "");
+        doc.PushBack(rss_obj, allocator);
+        const double throughput = result.wall_time > 0.0 ? static_cast<double>(result.gcode_bytes) / result.wall_time : 0.0;
+        auto throughput_obj = createRapidJSONObject(allocator, fmt::format("{} G-code throughput", name), throughput, "B/s", fmt::format("{} bytes of G-code", result.gcode_bytes));
+        doc.PushBack(throughput_obj, allocator);
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    doc.Accept(writer);
+
+    spdlog::info("Writing Json results: {}", std::filesystem::absolute(out_file).string());
+    std::ofstream file{ out_file };
+    if (! file)
+    {
+        spdlog::critical("Failed to open the file: {}", out_file.string());
+        exit(EXIT_FAILURE);
+    }
+    file.write(buffer.GetString(), buffer.GetSize());
+    file.close();
+}
+
+int main(int argc, const char** argv)
+{
+    constexpr bool show_help = true;
+    constexpr std::string_view version = "0.1.0";
+    const std::map<std::string, docopt::value> args = docopt::docopt(fmt::format("{}", USAGE), { argv + 1, argv + argc }, show_help, fmt::format("{}", version));
+
+    std::vector<std::pair<std::string, CaseResult>> results;
+    bool all_succeeded = true;
+    for (const BenchmarkCase& benchmark_case : getCases())
+    {
+        spdlog::info("Starting benchmark case {}", benchmark_case.name);
+        int result_pipe[2];
+        if (pipe(result_pipe) == -1)
+        {
+            spdlog::critical("Unable to create a pipe for the results");
+            return EXIT_FAILURE;
+        }
+
+        // Every case is sliced in a process of its own, so that it starts with fresh engine singletons and gets its own peak memory use.
+        const pid_t engine_pid = fork();
+        if (engine_pid == -1)
+        {
+            spdlog::critical("Unable to fork - engine");
+            return EXIT_FAILURE;
+        }
+        if (engine_pid == 0)
+        {
+            close(result_pipe[0]);
+            handleChildProcess(benchmark_case, result_pipe[1]);
+            return EXIT_SUCCESS;
+        }
+
+        close(result_pipe[1]);
+        CaseResult result;
+        const bool has_result = read(result_pipe[0], &result, sizeof(result)) == sizeof(result);
+        close(result_pipe[0]);
+        int status;
+        waitpid(engine_pid, &status, 0);
+        if (! has_result || ! WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+        {
+            spdlog::error("# Benchmark case {} failed", benchmark_case.name);
+            all_succeeded = false;
+            continue;
+        }
+        spdlog::info(
+            "+ Benchmark case {} sliced in {:.3f}s, peak RSS {:.1f} MiB, {} bytes of G-code",
+            benchmark_case.name,
+            result.wall_time,
+            static_cast<double>(result.peak_rss_kib) / 1024.0,
+            result.gcode_bytes);
+        results.emplace_back(benchmark_case.name, result);
+    }
+
+    createAndWriteJson(std::filesystem::path{ args.at("-o").asString() }, results);
+    return all_succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -116,6 +116,14 @@ protected:
      */
     void slice();
 
+    /*!
+     * \brief Enable tracing if the ``--trace <file>`` option was given and
+     * spilling if the ``--spill <directory>`` option was given, and remove
+     * those options from the arguments so that the commands don't need to know
+     * about them.
+     */
+    void extractGlobalArguments();
+
 private:
     /*
      * \brief The number of arguments that the application was called with.
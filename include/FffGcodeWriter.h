@@ -220,6 +220,44 @@ private:
      */
     ProcessLayerResult processLayer(const SliceDataStorage& storage, LayerIndex layer_nr, const size_t total_layers) const;
 
+    /*!
+     * Get how many layers below it \ref FffGcodeWriter::processLayer may read
+     * from the storage while processing a layer, for instance to detect
+     * bridges and overhangs, or support below bridges.
+     *
+     * Layers above are read as well, but those are read by layers that are
+     * processed before them, so they don't hold up the release of a layer.
+     *
+     * \param storage The storage of which the layers are processed.
+     * \return The number of layers below the processed layer that may be read.
+     */
+    LayerIndex::value_type getProcessLayerLookBehind(const SliceDataStorage& storage) const;
+
+    /*!
+     * Get how many layers above it \ref FffGcodeWriter::processLayer may read
+     * from the storage while processing a layer, for instance for the roofing
+     * mask or to support the edges of skin above.
+     *
+     * \param storage The storage of which the layers are processed.
+     * \return The number of layers above the processed layer that may be read.
+     */
+    LayerIndex::value_type getProcessLayerLookAhead(const SliceDataStorage& storage) const;
+
+    /*!
+     * Free the geometry of a layer of all meshes and of the support, and its
+     * cached outlines, once no layer that is still to be processed needs it
+     * anymore.
+     *
+     * This keeps the memory that the slice data takes during G-code generation
+     * bounded to a window of layers, rather than growing with the height of
+     * the print. The heights of the layers are kept.
+     *
+     * \param[in,out] storage The storage to free the layer in.
+     * \param layer_nr The layer to free. Nothing happens for layers that don't
+     * exist, such as raft filler layers.
+     */
+    void releaseLayer(SliceDataStorage& storage, const LayerIndex layer_nr) const;
+
     /*!
      * This function checks whether prime blob should happen for any extruder on the first layer.
      * Priming will always happen, but the actual priming may or may not include a prime blob.
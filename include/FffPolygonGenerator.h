@@ -10,6 +10,7 @@
 namespace cura
 {
 
+class LayerRangeIntersection;
 class MeshGroup;
 class ProgressStageEstimator;
 class SliceDataStorage;
@@ -145,8 +146,10 @@ private:
      * \param mesh Input and Output parameter: fetches the outline information (see SliceLayerPart::outline) and generates the other reachable field of the \p storage
      * \param layer_nr The layer for which to generate the skin areas.
      * \param process_infill Generate infill areas
+     * \param outline_intersections Shared intersections of the outlines of
+     * ranges of layers of the \p mesh, if available.
      */
-    void processSkinsAndInfill(SliceMeshStorage& mesh, const LayerIndex layer_nr, bool process_infill);
+    void processSkinsAndInfill(SliceMeshStorage& mesh, const LayerIndex layer_nr, bool process_infill, const LayerRangeIntersection* outline_intersections = nullptr);
 
     /*!
      * Generate the polygons where the draft screen should be.
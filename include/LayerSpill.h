@@ -0,0 +1,119 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef LAYER_SPILL_H
+#define LAYER_SPILL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "settings/types/LayerIndex.h"
+
+namespace cura
+{
+
+class SliceDataStorage;
+
+/*!
+ * Moves the geometry of the sliced layers out of the way while the G-code is
+ * written, and brings it back a layer at a time as the layers are processed.
+ *
+ * All layers are encoded compactly with a \ref PolygonEncoder, written to an
+ * unnamed scratch file and released. The scratch file is mapped into memory
+ * read-only, so that the operating system pages the layers in and out as
+ * needed. Since G-code is written from the bottom up, only a window
+ * of layers around the layers that are being processed has to be decoded at
+ * any time.
+ *
+ * This is off unless it is enabled, typically with the ``--spill <directory>``
+ * command line option. The layers are only spilled
+ * once they are all generated, so this reduces the memory used while writing
+ * G-code, not the peak while slicing and generating the layers.
+ *
+ * Only the geometry is encoded. The height and thickness of each layer stay in
+ * memory, since they are read for all layers.
+ */
+class LayerSpill
+{
+public:
+    /*!
+     * Spill sliced layers to scratch files in \p directory from now on.
+     */
+    static void enable(const std::filesystem::path& directory);
+
+    static bool isEnabled();
+
+    LayerSpill() = default;
+    LayerSpill(const LayerSpill&) = delete;
+    LayerSpill& operator=(const LayerSpill&) = delete;
+    ~LayerSpill();
+
+    /*!
+     * Encode all layers of the meshes and of the support, releasing every
+     * layer once it is encoded.
+     *
+     * If the scratch file can't be written, the layers from that point on stay
+     * in memory and are never restored.
+     *
+     * \param storage The sliced layers to spill.
+     * \return Whether any layers were spilled.
+     */
+    bool spill(SliceDataStorage& storage);
+
+    /*!
+     * Make sure that all layers from \p min_layer_nr up to and including
+     * \p max_layer_nr are in memory.
+     *
+     * This may be called from multiple threads at once. Every layer is read
+     * back at most once, so a layer that is released after it was restored
+     * stays released.
+     */
+    void restore(SliceDataStorage& storage, LayerIndex min_layer_nr, LayerIndex max_layer_nr);
+
+private:
+    /*!
+     * Where the encoded layers of one layer index are kept.
+     */
+    struct SpilledLayer
+    {
+        size_t offset; //!< Where the layer starts in the scratch file.
+        size_t size;
+        std::once_flag restored;
+    };
+
+    /*!
+     * Decode one layer index of all meshes and the support.
+     */
+    void restoreLayer(SliceDataStorage& storage, LayerIndex layer_nr, std::span<const uint8_t> data) const;
+
+    bool openScratchFile();
+    bool writeToScratchFile(const std::vector<uint8_t>& data);
+
+    /*!
+     * Map the scratch file into memory, if possible. If not, the layers are
+     * read from the file instead.
+     */
+    void mapScratchFile(size_t file_size);
+
+    std::vector<uint8_t> readFromScratchFile(LayerIndex layer_nr, const SpilledLayer& spilled) const;
+
+    /*!
+     * Close the scratch file and unmap it, if it is open.
+     */
+    void close();
+
+    int file_descriptor_{ -1 };
+    const uint8_t* mapping_{ nullptr };
+    size_t mapping_size_{ 0 };
+    std::unique_ptr<SpilledLayer[]> layers_; //!< Indexed by layer number. An array, since \ref std::once_flag can't be moved.
+    size_t layer_count_{ 0 };
+};
+
+} // namespace cura
+
+#endif // LAYER_SPILL_H
@@ -111,6 +111,7 @@ public:
                 line_bucket_grid.insert(polyline->converted_->back(), polyline);
             }
         }
+        line_bucket_grid.compact();
 
         // Create sequences of line segments that get printed together in a monotonic direction.
         // There are several constraints we impose here:
@@ -4,14 +4,17 @@
 #ifndef PATHORDEROPTIMIZER_H
 #define PATHORDEROPTIMIZER_H
 
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <unordered_set>
 
 #include <range/v3/algorithm/partition_copy.hpp>
 #include <range/v3/iterator/insert_iterators.hpp>
-#include <range/v3/view/addressof.hpp>
 #include <range/v3/view/drop_last.hpp>
 #include <range/v3/view/enumerate.hpp>
-#include <range/v3/view/filter.hpp>
 #include <range/v3/view/reverse.hpp>
 #include <spdlog/spdlog.h>
 
@@ -21,6 +24,10 @@
 #include "pathPlanning/LinePolygonsCrossings.h" //To prevent calculating combing distances if we don't cross the combing borders.
 #include "settings/EnumSettings.h" //To get the seam settings.
 #include "settings/ZSeamConfig.h" //To read the seam configuration.
+#include "utils/AABB.h"
+#include "utils/Counters.h"
+#include "utils/RingSearchGrid.h"
+#include "utils/SeamCornerCache.h"
 #include "utils/linearAlg2D.h" //To find the angle of corners to hide seams.
 #include "utils/polygonUtils.h"
 #include "utils/views/dfs.h"
@@ -153,6 +160,9 @@ public:
         {
             return;
         }
+        Counters::add(Counter::PATH_ORDER_OPTIMIZER_CALLS);
+        Counters::add(Counter::PATH_ORDER_OPTIMIZER_PATHS, paths_.size());
+        Counters::record(Histogram::PATH_ORDER_OPTIMIZER_PATHS, paths_.size());
 
         // Get the vertex data and store it in the paths.
         for (auto& path : paths_)
@@ -196,6 +206,7 @@ public:
                 line_bucket_grid.insert(path.converted_->back(), i);
             }
         }
+        line_bucket_grid.compact();
 
         // For some Z seam types the start position can be pre-computed.
         // This is faster since we don't need to re-compute the start position at each step then.
@@ -245,6 +256,13 @@ protected:
      */
     constexpr static coord_t _coincident_point_distance = 10;
 
+    /*!
+     * With more paths than this, travel moves that would cross the combing
+     * boundary are penalised with a factor instead of computing the actual
+     * combing distance, which would get too expensive.
+     */
+    constexpr static size_t max_paths_to_comb_ = 100;
+
     /*!
      * Bucket grid to store the locations of the combing boundary.
      *
@@ -292,48 +310,57 @@ protected:
      */
     const std::unordered_multimap<Path, Path>* order_requirements_;
 
-    std::vector<OrderablePath> getOptimizedOrder(SparsePointGridInclusive<size_t> line_bucket_grid, size_t snap_radius)
+    std::vector<OrderablePath> getOptimizedOrder(const SparsePointGridInclusive<size_t>& line_bucket_grid, size_t snap_radius)
     {
         std::vector<OrderablePath> optimized_order; // To store our result in.
 
         Point2LL current_position = start_point_;
 
-        std::unordered_map<OrderablePath*, bool> picked(paths_.size()); // Fixed size boolean flag for whether each path is already in the optimized vector.
+        std::vector<bool> picked(paths_.size(), false); // Fixed size boolean flag for whether each path is already in the optimized vector.
 
-        auto notPicked = [&picked](OrderablePath* c)
+        // With many paths, finding the closest one among all paths that are left takes most of the time, so search them spatially.
+        std::optional<RingSearchGrid<size_t>> nearest_grid;
+        if (paths_.size() > max_paths_to_comb_)
         {
-            return ! picked[c];
-        };
+            nearest_grid = buildNearestGrid();
+        }
+        std::vector<size_t> last_evaluated(paths_.size(), std::numeric_limits<size_t>::max()); // For each path, in which step its distance was computed last.
 
         while (optimized_order.size() < paths_.size())
         {
             // Use bucket grid to find paths within snap_radius
-            std::vector<OrderablePath*> nearby_candidates;
+            std::vector<OrderablePath*> available_candidates;
             for (const auto i : line_bucket_grid.getNearbyVals(current_position, snap_radius))
             {
-                nearby_candidates.push_back(&paths_[i]); // Convert bucket indexes to corresponding paths
+                if (! picked[i])
+                {
+                    available_candidates.push_back(&paths_[i]); // Convert bucket indexes to corresponding paths
+                }
             }
 
-            std::vector<OrderablePath*> available_candidates;
-            available_candidates.reserve(nearby_candidates.size());
-            for (auto candidate : nearby_candidates | ranges::views::filter(notPicked))
+            OrderablePath* best_path;
+            if (! available_candidates.empty())
             {
-                available_candidates.push_back(candidate);
+                best_path = findClosestPath(current_position, available_candidates);
             }
-
-            if (available_candidates.empty()) // We need to broaden our search through all candidates
+            else if (nearest_grid.has_value())
+            {
+                best_path = findClosestPathInGrid(current_position, *nearest_grid, picked, last_evaluated, optimized_order.size());
+            }
+            else // We need to broaden our search through all candidates
             {
-                for (auto path : paths_ | ranges::views::addressof | ranges::views::filter(notPicked))
+                for (size_t i = 0; i < paths_.size(); ++i)
                 {
-                    available_candidates.push_back(path);
+                    if (! picked[i])
+                    {
+                        available_candidates.push_back(&paths_[i]);
+                    }
                 }
+                best_path = findClosestPath(current_position, available_candidates);
             }
 
-            auto best_candidate = findClosestPath(current_position, available_candidates);
-
-            auto best_path = best_candidate;
             optimized_order.push_back(*best_path);
-            picked[best_path] = true;
+            picked[best_path - paths_.data()] = true;
 
             if (! best_path->converted_->empty()) // If all paths were empty, the best path is still empty. We don't upate the current position then.
             {
@@ -352,6 +379,133 @@ protected:
         return optimized_order;
     }
 
+    /*!
+     * Put the vertices where each path may start in a grid that can be
+     * searched from near to far.
+     *
+     * Polygons may start at any vertex, polylines only at their endpoints.
+     * Since the start of each path is always one of these vertices, the
+     * distance to its closest vertex is a lower bound for the distance to the
+     * start of the path.
+     */
+    RingSearchGrid<size_t> buildNearestGrid() const
+    {
+        AABB bounds;
+        size_t vertex_count = 0;
+        for (const OrderablePath& path : paths_)
+        {
+            if (path.converted_->empty())
+            {
+                continue;
+            }
+            for (const Point2LL& point : *path.converted_)
+            {
+                bounds.include(point);
+            }
+            vertex_count += path.is_closed_ ? path.converted_->size() : 2;
+        }
+
+        // Aim for about one vertex per cell. The cells shouldn't get too small for the grid to stay sparse though.
+        constexpr coord_t min_cell_size = 100;
+        const coord_t side = vertex_count == 0 ? 0 : std::max(bounds.max_.X - bounds.min_.X, bounds.max_.Y - bounds.min_.Y);
+        const coord_t cell_size = std::max(min_cell_size, static_cast<coord_t>(side / std::sqrt(std::max(vertex_count, size_t(1)))));
+
+        RingSearchGrid<size_t> grid(cell_size);
+        for (const auto& [i, path] : paths_ | ranges::views::enumerate)
+        {
+            if (path.converted_->empty())
+            {
+                continue; // Empty paths can't be found by their position. They're picked when nothing else is left.
+            }
+            if (path.is_closed_)
+            {
+                for (const Point2LL& point : *path.converted_)
+                {
+                    grid.insert(point, i);
+                }
+            }
+            else
+            {
+                grid.insert(path.converted_->front(), i);
+                grid.insert(path.converted_->back(), i);
+            }
+        }
+        return grid;
+    }
+
+    /*!
+     * Find the path that \ref findClosestPath would pick among all paths that
+     * are not picked yet, but only compute the distance to the paths whose
+     * vertices are close enough to possibly beat the closest one.
+     *
+     * This relies on the distances of \ref findClosestPath never being shorter
+     * than the direct distance, which holds when there are more paths than
+     * \ref max_paths_to_comb_.
+     *
+     * \param start_position The position to find the closest path to.
+     * \param grid The grid of vertices of all paths. Vertices of picked paths
+     * are removed from it as they are found.
+     * \param picked For each path, whether it has been picked already.
+     * \param[in,out] last_evaluated For each path, the step in which its
+     * distance was computed last, so that its distance is computed once per
+     * step even though it has many vertices.
+     * \param step A number that is unique to this search.
+     */
+    OrderablePath* findClosestPathInGrid(
+        const Point2LL& start_position,
+        RingSearchGrid<size_t>& grid,
+        const std::vector<bool>& picked,
+        std::vector<size_t>& last_evaluated,
+        const size_t step)
+    {
+        coord_t best_distance2 = std::numeric_limits<coord_t>::max();
+        size_t best_idx = paths_.size();
+        grid.processByDistance(
+            start_position,
+            [&best_distance2](const coord_t min_distance2)
+            {
+                return min_distance2 <= best_distance2;
+            },
+            [&](const typename RingSearchGrid<size_t>::Elem& elem)
+            {
+                const size_t path_idx = elem.val;
+                if (picked[path_idx])
+                {
+                    return false; // Never needed again.
+                }
+                if (last_evaluated[path_idx] == step || getDirectDistance(start_position, elem.point) > best_distance2)
+                {
+                    return true;
+                }
+                last_evaluated[path_idx] = step;
+                // Also compute the combing distance if the direct distance ties, to know whether this path really ties.
+                const coord_t combing_threshold2 = best_distance2 == std::numeric_limits<coord_t>::max() ? best_distance2 : best_distance2 + 1;
+                const coord_t distance2 = getPathDistance(start_position, paths_[path_idx], combing_threshold2);
+                // Break ties like a search through all paths in their order would.
+                if (distance2 < best_distance2 || (distance2 == best_distance2 && path_idx < best_idx))
+                {
+                    best_distance2 = distance2;
+                    best_idx = path_idx;
+                }
+                return true;
+            });
+        if (best_idx < paths_.size())
+        {
+            return &paths_[best_idx];
+        }
+
+        // Only paths without vertices are left. Pick them in the same order as a search through all paths would.
+        for (size_t path_idx = paths_.size(); path_idx-- > 0;)
+        {
+            if (! picked[path_idx])
+            {
+                return &paths_[path_idx];
+            }
+        }
+        assert(false && "There should be a path left to pick.");
+        return nullptr;
+    }
+
     std::vector<OrderablePath> getOptimizerOrderWithConstraints(const std::unordered_multimap<Path, Path>& order_requirements)
     {
         std::vector<OrderablePath> optimized_order; // To store our result in.
@@ -577,23 +731,7 @@ protected:
                 continue;
             }
 
-            const bool precompute_start
-                = seam_config_.type_ == EZSeamType::RANDOM || seam_config_.type_ == EZSeamType::USER_SPECIFIED || seam_config_.type_ == EZSeamType::SHARPEST_CORNER;
-            if (! path->is_closed_ || ! precompute_start) // Find the start location unless we've already precomputed it.
-            {
-                path->start_vertex_ = findStartLocation(*path, start_position);
-                if (! path->is_closed_) // Open polylines start at vertex 0 or vertex N-1. Indicate that they should be reversed if they start at N-1.
-                {
-                    path->backwards_ = path->start_vertex_ > 0;
-                }
-            }
-            const Point2LL candidate_position = (*path->converted_)[path->start_vertex_];
-            coord_t distance2 = getDirectDistance(start_position, candidate_position);
-            if (distance2 < best_distance2
-                && combing_boundary_) // If direct distance is longer than best combing distance, the combing distance can never be better, so only compute combing if necessary.
-            {
-                distance2 = getCombingDistance(start_position, candidate_position);
-            }
+            const coord_t distance2 = getPathDistance(start_position, *path, best_distance2);
             if (distance2 < best_distance2) // Closer than the best candidate so far.
             {
                 best_candidate = path;
@@ -604,6 +742,39 @@ protected:
         return best_candidate;
     }
 
+    /*!
+     * Choose where to start a non-empty path when coming from
+     * \p start_position, and compute the squared travel distance to that start.
+     *
+     * \param start_position Where the travel move to the path starts.
+     * \param path The path to travel to. Its start vertex and direction are
+     * updated.
+     * \param best_distance2 The distance of the best path found so far. The
+     * combing distance is only computed if the direct distance is shorter.
+     * \return The squared direct distance or combing distance to the start.
+     */
+    coord_t getPathDistance(const Point2LL& start_position, OrderablePath& path, const coord_t best_distance2)
+    {
+        const bool precompute_start
+            = seam_config_.type_ == EZSeamType::RANDOM || seam_config_.type_ == EZSeamType::USER_SPECIFIED || seam_config_.type_ == EZSeamType::SHARPEST_CORNER;
+        if (! path.is_closed_ || ! precompute_start) // Find the start location unless we've already precomputed it.
+        {
+            path.start_vertex_ = findStartLocation(path, start_position);
+            if (! path.is_closed_) // Open polylines start at vertex 0 or vertex N-1. Indicate that they should be reversed if they start at N-1.
+            {
+                path.backwards_ = path.start_vertex_ > 0;
+            }
+        }
+        const Point2LL candidate_position = (*path.converted_)[path.start_vertex_];
+        coord_t distance2 = getDirectDistance(start_position, candidate_position);
+        if (distance2 < best_distance2
+            && combing_boundary_) // If direct distance is longer than best combing distance, the combing distance can never be better, so only compute combing if necessary.
+        {
+            distance2 = getCombingDistance(start_position, candidate_position);
+        }
+        return distance2;
+    }
+
     /*!
      * Find the vertex which will be the starting point of printing a polygon or
      * polyline.
@@ -647,16 +818,21 @@ protected:
             return vert;
         }
 
-        // Precompute segments lengths because we are going to need them multiple times
-        std::vector<coord_t> segments_sizes(path.converted_->size());
-        coord_t total_length = 0;
-        for (size_t i = 0; i < path.converted_->size(); ++i)
+        // The corner angles only depend on the shape of the polygon, so large polygons that come back on other layers or in other copies reuse them.
+        // Without a corner preference the angles don't affect the score, so they are neither computed nor cached then.
+        const bool use_corner_angles = seam_config_.corner_pref_ != EZSeamCornerPrefType::Z_SEAM_CORNER_PREF_NONE;
+        const std::function<SeamCornerCache::Angles()> compute_angles = [&path]()
         {
-            const Point2LL& here = path.converted_->at(i);
-            const Point2LL& next = path.converted_->at((i + 1) % path.converted_->size());
-            const coord_t segment_size = vSize(next - here);
-            segments_sizes[i] = segment_size;
-            total_length += segment_size;
+            return cornerAngles(path);
+        };
+        std::shared_ptr<const SeamCornerCache::Angles> cached_angles;
+        if (use_corner_angles && path.converted_->size() >= SeamCornerCache::min_vertex_count)
+        {
+            cached_angles = SeamCornerCache::get(*path.converted_, compute_angles);
+        }
+        else if (use_corner_angles)
+        {
+            cached_angles = std::make_shared<const SeamCornerCache::Angles>(compute_angles());
         }
 
         size_t best_i;
@@ -669,7 +845,7 @@ protected:
                                             ? MM2INT(10)
                                             : vSize2(here - target_pos);
 
-            double corner_angle = cornerAngle(path, i, segments_sizes, total_length);
+            const double corner_angle = use_corner_angles ? (*cached_angles)[i] : 0.0;
             // angles < 0 are concave (left turning)
             // angles > 0 are convex (right turning)
 
@@ -821,6 +997,38 @@ protected:
         return angle / std::numbers::pi;
     }
 
+    /*!
+     * Calculate the corner angle of every vertex of a closed path that can be a
+     * seam, which is every vertex but the last.
+     * \param path The vertex data of a path
+     * \return The corner angles, weighed to [-1.0 ; 1.0], by vertex index.
+     */
+    static SeamCornerCache::Angles cornerAngles(const OrderablePath& path)
+    {
+        // Precompute segments lengths because we are going to need them multiple times
+        std::vector<coord_t> segments_sizes(path.converted_->size());
+        coord_t total_length = 0;
+        for (size_t i = 0; i < path.converted_->size(); ++i)
+        {
+            const Point2LL& here = path.converted_->at(i);
+            const Point2LL& next = path.converted_->at((i + 1) % path.converted_->size());
+            const coord_t segment_size = vSize(next - here);
+            segments_sizes[i] = segment_size;
+            total_length += segment_size;
+        }
+
+        SeamCornerCache::Angles angles;
+        if (path.converted_->size() > 1)
+        {
+            angles.reserve(path.converted_->size() - 1);
+        }
+        for (size_t i = 0; i + 1 < path.converted_->size(); ++i)
+        {
+            angles.push_back(cornerAngle(path, i, segments_sizes, total_length));
+        }
+        return angles;
+    }
+
     /*!
      * Calculate the direct Euclidean distance to move from one point to
      * another.
@@ -849,7 +1057,7 @@ protected:
         {
             return getDirectDistance(a, b); // No collision with any line. Just compute the direct distance then.
         }
-        if (paths_.size() > 100)
+        if (paths_.size() > max_paths_to_comb_)
         {
             /* If we have many paths to optimize the order for, this combing
             calculation can become very expensive. Instead, penalize travels
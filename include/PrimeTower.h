@@ -29,7 +29,6 @@ class PrimeTower
 {
 private:
     using MovesByExtruder = std::vector<Polygons>;
-    using MovesByLayer = std::vector<MovesByExtruder>;
 
     size_t extruder_count_; //!< Number of extruders
 
@@ -51,11 +50,27 @@ private:
      */
     std::map<size_t, std::map<size_t, Polygons>> sparse_pattern_per_extruders_;
 
-    MovesByLayer base_extra_moves_; //!< For each layer and each extruder, the extra moves to be processed for better adhesion/strength
+    /*!
+     * One distinct set of extra rings of the base of the tower.
+     *
+     * The base narrows down over its height, but consecutive layers usually
+     * have the same number of extra rings, so only a few of these exist. They
+     * are shared by all layers that print them.
+     */
+    struct BaseVariant
+    {
+        size_t extruder_nr; //!< The extruder that prints the rings.
+        size_t extra_rings; //!< How many rings are printed outside the tower.
+        Polygons moves; //!< The extra rings themselves.
+        Polygons outline; //!< The outline of the tower including the rings.
+    };
+
+    std::vector<BaseVariant> base_variants_; //!< All distinct sets of extra rings of the base.
+    std::vector<std::vector<size_t>> base_extra_moves_; //!< For each extruder and each layer, the index in \ref base_variants_ of the extra moves to be processed for better adhesion/strength
     MovesByExtruder inset_extra_moves_; //!< For each extruder, the extra inset moves to be processed for better adhesion on initial layer
 
     Polygons outer_poly_; //!< The outline of the outermost prime tower.
-    std::vector<Polygons> outer_poly_base_; //!< The outline of the layers having extra width for the base
+    std::vector<size_t> outer_poly_base_; //!< For the layers having extra width for the base, the index in \ref base_variants_ of their outline
 
 public:
     bool enabled_; //!< Whether the prime tower is enabled.
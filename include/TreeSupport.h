@@ -7,6 +7,7 @@
 #include "TreeModelVolumes.h"
 #include "TreeSupportBaseCircle.h"
 #include "TreeSupportElement.h"
+#include "TreeSupportElementPool.h"
 #include "TreeSupportEnums.h"
 #include "TreeSupportSettings.h"
 #include "boost/functional/hash.hpp" // For combining hashes
@@ -113,7 +114,7 @@ private:
      * \param move_bounds[out] Storage for the influence areas.
      * \param storage[in] Background storage, required for adding roofs.
      */
-    void generateInitialAreas(const SliceMeshStorage& mesh, std::vector<std::set<TreeSupportElement*>>& move_bounds, SliceDataStorage& storage);
+    void generateInitialAreas(const SliceMeshStorage& mesh, std::vector<TreeSupportElementSet>& move_bounds, SliceDataStorage& storage);
 
 
     /*!
@@ -225,7 +226,7 @@ private:
      *
      * \param move_bounds[in,out] All currently existing influence areas
      */
-    void createLayerPathing(std::vector<std::set<TreeSupportElement*>>& move_bounds);
+    void createLayerPathing(std::vector<TreeSupportElementSet>& move_bounds);
 
 
     /*!
@@ -243,14 +244,14 @@ private:
      * \param layer_idx[in] The current layer.
      * \return Should elem be deleted.
      */
-    bool setToModelContact(std::vector<std::set<TreeSupportElement*>>& move_bounds, TreeSupportElement* first_elem, const LayerIndex layer_idx);
+    bool setToModelContact(std::vector<TreeSupportElementSet>& move_bounds, TreeSupportElement* first_elem, const LayerIndex layer_idx);
 
     /*!
      * \brief Set the result_on_layer point for all influence areas
      *
      * \param move_bounds[in,out] All currently existing influence areas
      */
-    void createNodesFromArea(std::vector<std::set<TreeSupportElement*>>& move_bounds);
+    void createNodesFromArea(std::vector<TreeSupportElementSet>& move_bounds);
 
     /*!
      * \brief Draws circles around result_on_layer points of the influence areas
@@ -308,7 +309,7 @@ private:
      * \param move_bounds[in] All currently existing influence areas
      * \param storage[in,out] The storage where the support should be stored.
      */
-    void drawAreas(std::vector<std::set<TreeSupportElement*>>& move_bounds, SliceDataStorage& storage);
+    void drawAreas(std::vector<TreeSupportElementSet>& move_bounds, SliceDataStorage& storage);
 
     /*!
      * \brief Settings with the indexes of meshes that use these settings.
@@ -331,6 +332,11 @@ private:
      */
     TreeModelVolumes volumes_;
 
+    /*!
+     * \brief Storage for all elements of the mesh group that is currently processed.
+     */
+    TreeSupportElementPool element_pool_;
+
     /*!
      * \brief Contains config settings to avoid loading them in every function. This was done to improve readability of the code.
      */
@@ -2,7 +2,10 @@
 #ifndef TREESUPPORTELEMENT_H
 #define TREESUPPORTELEMENT_H
 
+#include <algorithm>
+#include <cassert>
 #include <map>
+#include <set>
 #include <unordered_map>
 
 #include <boost/container_hash/hash.hpp>
@@ -358,6 +361,12 @@ struct TreeSupportElement
      */
     std::vector<Point2LL> additional_ovalization_targets_;
 
+    /*!
+     * \brief Identifier handed out by TreeSupportElementPool::assignIds, which orders the elements of a layer.
+     * Elements that aren't numbered yet, and elements that are constructed outside of the pool, such as the keys of the maps of influence areas, have 0.
+     */
+    size_t id_ = 0;
+
 
     bool operator==(const TreeSupportElement& other) const
     {
@@ -440,6 +449,84 @@ struct TreeSupportElement
     }
 };
 
+/*!
+ * \brief The elements of one layer, in a flat vector sorted by their identifiers.
+ *
+ * The identifiers are handed out by TreeSupportElementPool::assignIds in an order that doesn't depend on how the threads that created the elements were scheduled, so
+ * iterating over the elements of a layer is deterministic.
+ */
+class TreeSupportElementSet
+{
+public:
+    using const_iterator = std::vector<TreeSupportElement*>::const_iterator;
+
+    const_iterator begin() const
+    {
+        return elements_.begin();
+    }
+
+    const_iterator end() const
+    {
+        return elements_.end();
+    }
+
+    bool empty() const
+    {
+        return elements_.empty();
+    }
+
+    size_t size() const
+    {
+        return elements_.size();
+    }
+
+    /*!
+     * \brief Add elements that were given their identifiers after all elements that are in this set already.
+     * \param elements The elements to add, in the order of their identifiers.
+     */
+    void append(const std::vector<TreeSupportElement*>& elements)
+    {
+        assert((elements.empty() || elements_.empty() || elements_.back()->id_ < elements.front()->id_) && "Elements are appended in the order of their identifiers.");
+        elements_.insert(elements_.end(), elements.begin(), elements.end());
+    }
+
+    /*!
+     * \brief Remove an element from the set, if it's in there.
+     */
+    void erase(TreeSupportElement* element)
+    {
+        const auto position = std::lower_bound(
+            elements_.begin(),
+            elements_.end(),
+            element,
+            [](const TreeSupportElement* a, const TreeSupportElement* b)
+            {
+                return a->id_ < b->id_;
+            });
+        if (position != elements_.end() && *position == element)
+        {
+            elements_.erase(position);
+        }
+    }
+
+    /*!
+     * \brief Remove many elements at once, in a single pass over the set.
+     */
+    template<typename Container>
+    void eraseAll(const Container& elements)
+    {
+        std::erase_if(
+            elements_,
+            [&elements](TreeSupportElement* element)
+            {
+                return elements.contains(element);
+            });
+    }
+
+private:
+    std::vector<TreeSupportElement*> elements_;
+};
+
 } // namespace cura
 
 namespace std
@@ -0,0 +1,135 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef TREESUPPORTELEMENTPOOL_H
+#define TREESUPPORTELEMENTPOOL_H
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "TreeSupportElement.h"
+#include "utils/NoCopy.h"
+
+namespace cura
+{
+
+/*!
+ * \brief Storage for all the support elements of one tree support generation.
+ *
+ * Tree support creates many thousands of elements, which used to be allocated one by one with new and deleted one by one at the end. The pool keeps them in large blocks
+ * instead, which are all freed together when the pool is cleared. Element addresses stay valid until then.
+ *
+ * Elements are created from parallel loops, so the order in which they are created depends on how the threads are scheduled. They are only given their identifiers once
+ * all elements of a layer are created, with \ref assignIds, in an order that only depends on the elements themselves. The identifiers order the elements of each layer (see
+ * TreeSupportElementSet).
+ *
+ * Creating elements is thread-safe.
+ */
+class TreeSupportElementPool : public NoCopy
+{
+public:
+    /*!
+     * \brief Construct a new element in the pool.
+     * \param args The arguments for the constructor of TreeSupportElement.
+     * \return The new element, which stays valid until the pool is cleared.
+     */
+    template<typename... Args>
+    TreeSupportElement* create(Args&&... args)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        TreeSupportElement& element = elements_.emplace_back(std::forward<Args>(args)...);
+        element.id_ = 0; // Not numbered until assignIds is called.
+        return &element;
+    }
+
+    /*!
+     * \brief Number new elements in an order that doesn't depend on the order in which they were created.
+     *
+     * The elements are sorted by their position, the layer they are heading to and the identifiers of their parents, which were numbered before, and then get identifiers
+     * that are higher than those of all elements numbered before. Elements with equal keys keep the order they are given in, so that equal elements don't get their
+     * identifiers in an order that depends on the sorting algorithm.
+     * \param elements[in,out] The new elements of one layer. Sorted by their new identifiers afterwards.
+     */
+    void assignIds(std::vector<TreeSupportElement*>& elements)
+    {
+        std::stable_sort(
+            elements.begin(),
+            elements.end(),
+            [](const TreeSupportElement* a, const TreeSupportElement* b)
+            {
+                return orderKey(*a) < orderKey(*b);
+            });
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (TreeSupportElement* element : elements)
+        {
+            element->id_ = ++last_id_; // Start at 1, so that 0 remains for elements that are not numbered.
+        }
+    }
+
+    /*!
+     * \brief Free the memory held by an element that is no longer used.
+     *
+     * The element itself stays in the pool until the pool is cleared, but it must not be used any more. Its area is not owned by the pool and has to be deleted separately.
+     */
+    void release(TreeSupportElement* element)
+    {
+        element->parents_ = {};
+        element->all_tips_ = {};
+        element->influence_area_limit_area_ = Polygons();
+        element->additional_ovalization_targets_ = {};
+        element->area_ = nullptr;
+    }
+
+    /*!
+     * \brief Free all elements at once. None of the elements created by this pool may be used afterwards.
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        elements_.clear();
+        elements_.shrink_to_fit();
+        last_id_ = 0;
+    }
+
+    /*!
+     * \brief The number of elements that were created in this pool.
+     */
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return elements_.size();
+    }
+
+private:
+    /*!
+     * \brief What new elements are sorted by before they are numbered. Elements of one layer that have the same key are equal for all that matters to tree support.
+     */
+    using OrderKey = std::tuple<LayerIndex::value_type, coord_t, coord_t, coord_t, coord_t, coord_t, coord_t, size_t, size_t, size_t>;
+
+    static OrderKey orderKey(const TreeSupportElement& element)
+    {
+        const size_t first_parent_id = element.parents_.empty() ? 0 : element.parents_.front()->id_;
+        return OrderKey(
+            element.target_height_.value,
+            element.target_position_.X,
+            element.target_position_.Y,
+            element.next_position_.X,
+            element.next_position_.Y,
+            element.result_on_layer_.X,
+            element.result_on_layer_.Y,
+            element.distance_to_top_,
+            element.parents_.size(),
+            first_parent_id);
+    }
+
+    mutable std::mutex mutex_;
+    std::deque<TreeSupportElement> elements_; //!< A deque never moves its elements when growing at the end.
+    size_t last_id_ = 0;
+};
+
+} // namespace cura
+
+#endif // TREESUPPORTELEMENTPOOL_H
@@ -16,6 +16,9 @@ And all every bit inside a single part can be printed without the nozzle leaving
 It's also the first step that stores the result in the "data storage" so all other steps can access it.
 */
 
+#include <utility>
+#include <vector>
+
 namespace cura
 {
 
@@ -36,11 +39,28 @@ void createLayerWithParts(const Settings& settings, SliceLayer& storageLayer, Sl
 
 /*!
  * \brief Split all layers into parts.
+ *
+ * Each layer of the slicer is emptied as soon as it is split, to free its
+ * polygons.
  * \param mesh The mesh of which to split the layers into parts.
  * \param slicer The slicer to get the layers from.
  */
 void createLayerParts(SliceMeshStorage& mesh, Slicer* slicer);
 
+/*!
+ * \brief Split all layers of several meshes into parts.
+ *
+ * The layers of all meshes are split in the same parallel loop, which keeps
+ * all threads busy when there are many meshes with few layers each. Each
+ * layer of a slicer is emptied as soon as it is split, so that the sliced
+ * polygons of all meshes don't have to be in memory at the same time as their
+ * parts. The progress of the parts stage is reported whenever all layers of a
+ * mesh are done.
+ * \param meshes The meshes of which to split the layers into parts, each with
+ * the slicer to get its layers from.
+ */
+void createLayerParts(const std::vector<std::pair<SliceMeshStorage*, Slicer*>>& meshes);
+
 }//namespace cura
 
 #endif//LAYERPART_H
@@ -12,8 +12,9 @@
 #include <agrpc/use_awaitable.hpp>
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/co_spawn.hpp>
-#include <boost/asio/detached.hpp>
+#include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/use_future.hpp>
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 #include <range/v3/utility/semiregular_box.hpp>
@@ -37,6 +38,7 @@
 #include <experimental/coroutine>
 #define USE_EXPERIMENTAL_COROUTINE
 #endif
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
@@ -44,6 +46,60 @@
 
 namespace cura::plugins
 {
+namespace details
+{
+
+/**
+ * @brief A gRPC context that lives as long as the plugin it talks to, with its own thread that runs it.
+ *
+ * Creating a context and running it to completion for every single plugin call is relatively expensive, and it means that the calling thread blocks until the plugin
+ * replies. Instead, calls are spawned on this context from any thread, while the context keeps running in the background. The caller gets a future, so it can continue with
+ * other work (or issue more calls, which then are in flight together on the same channel) and only wait when it needs the result.
+ */
+class PersistentGrpcContext
+{
+public:
+    PersistentGrpcContext()
+        : work_guard_{ boost::asio::make_work_guard(grpc_context_) }
+        , thread_{ [this]()
+                   {
+                       grpc_context_.run();
+                   } }
+    {
+    }
+
+    PersistentGrpcContext(const PersistentGrpcContext&) = delete;
+    PersistentGrpcContext& operator=(const PersistentGrpcContext&) = delete;
+
+    ~PersistentGrpcContext()
+    {
+        work_guard_.reset(); // Let the context run out of work, so that its thread finishes the calls that are still in flight and then stops.
+        thread_.join();
+    }
+
+    agrpc::GrpcContext& get() noexcept
+    {
+        return grpc_context_;
+    }
+
+    /**
+     * @brief Spawn a coroutine on the context. This may be called from any thread, but not from within a coroutine running on this context.
+     *
+     * @param coroutine A callable returning a boost::asio::awaitable<void>.
+     * @return A future that becomes ready when the coroutine has finished, or holds the exception it threw.
+     */
+    std::future<void> spawn(auto&& coroutine)
+    {
+        return boost::asio::co_spawn(grpc_context_, std::forward<decltype(coroutine)>(coroutine), boost::asio::use_future);
+    }
+
+private:
+    agrpc::GrpcContext grpc_context_;
+    boost::asio::executor_work_guard<agrpc::GrpcContext::executor_type> work_guard_;
+    std::thread thread_;
+};
+
+} // namespace details
 
 /**
  * @brief A plugin proxy class template.
@@ -70,7 +126,7 @@ class PluginProxy
     using invoke_stub_t = Stub;
     using broadcast_stub_t = slots::broadcast::v0::BroadcastService::Stub;
 
-    ranges::semiregular_box<invoke_stub_t> invoke_stub_; ///< The gRPC Invoke stub for communication.
+    std::shared_ptr<invoke_stub_t> invoke_stub_; ///< The gRPC Invoke stub for communication, shared with the calls that are still in flight.
     ranges::semiregular_box<broadcast_stub_t> broadcast_stub_; ///< The gRPC Broadcast stub for communication.
 public:
     /**
@@ -87,22 +143,22 @@ public:
     constexpr PluginProxy() = default;
 
     PluginProxy(const std::string& name, const std::string& version, std::shared_ptr<grpc::Channel> channel)
-        : invoke_stub_{ channel }
+        : invoke_stub_{ std::make_shared<invoke_stub_t>(channel) }
         , broadcast_stub_{ channel }
+        , grpc_context_{ std::make_shared<details::PersistentGrpcContext>() }
     {
         // Connect to the plugin and exchange a handshake
-        agrpc::GrpcContext grpc_context;
         grpc::Status status;
         slots::handshake::v0::HandshakeService::Stub handshake_stub(channel);
         plugin_metadata plugin_info;
+        const std::thread::id thread_id = std::this_thread::get_id();
 
-        boost::asio::co_spawn(
-            grpc_context,
-            [this, &grpc_context, &status, &plugin_info, &handshake_stub, &name, &version]() -> boost::asio::awaitable<void>
+        grpc_context_->spawn(
+            [this, &status, &plugin_info, &handshake_stub, &name, &version, thread_id]() -> boost::asio::awaitable<void>
             {
                 using RPC = agrpc::ClientRPC<&slots::handshake::v0::HandshakeService::Stub::PrepareAsyncCall>;
                 grpc::ClientContext client_context{};
-                prep_client_context(client_context, slot_info_);
+                prep_client_context(client_context, slot_info_, thread_id);
 
                 // Construct request
                 handshake_request handshake_req;
@@ -110,7 +166,7 @@ public:
 
                 // Make unary request
                 handshake_response::value_type response;
-                status = co_await RPC::request(grpc_context, handshake_stub, client_context, request, response, boost::asio::use_awaitable);
+                status = co_await RPC::request(grpc_context_->get(), handshake_stub, client_context, request, response, boost::asio::use_awaitable);
                 handshake_response handshake_rsp;
                 plugin_info = handshake_rsp(response, client_context.peer());
                 valid_ = validator_type{ slot_info_, plugin_info };
@@ -122,9 +178,8 @@ public:
                         spdlog::info("Subscribing plugin '{}' to the following broadcasts {}", plugin_info.plugin_name, plugin_info.broadcast_subscriptions);
                     }
                 }
-            },
-            boost::asio::detached);
-        grpc_context.run();
+            })
+            .get();
 
         if (! status.ok()) // TODO: handle different kind of status codes
         {
@@ -145,6 +200,7 @@ public:
         {
             invoke_stub_ = other.invoke_stub_;
             broadcast_stub_ = other.broadcast_stub_;
+            grpc_context_ = other.grpc_context_;
             valid_ = other.valid_;
             plugin_info_ = other.plugin_info_;
             slot_info_ = other.slot_info_;
@@ -157,6 +213,7 @@ public:
         {
             invoke_stub_ = std::move(other.invoke_stub_);
             broadcast_stub_ = std::move(other.broadcast_stub_);
+            grpc_context_ = std::move(other.grpc_context_);
             valid_ = std::move(other.valid_);
             plugin_info_ = std::move(other.plugin_info_);
             slot_info_ = std::move(other.slot_info_);
@@ -167,68 +224,57 @@ public:
 
     value_type generate(auto&&... args)
     {
-        agrpc::GrpcContext grpc_context;
-        value_type ret_value{};
-        grpc::Status status;
-
-        boost::asio::co_spawn(
-            grpc_context,
-            [this, &grpc_context, &status, &ret_value, &args...]()
-            {
-                return this->generateCall(grpc_context, status, ret_value, std::forward<decltype(args)>(args)...);
-            },
-            boost::asio::detached);
-        grpc_context.run();
+        return generateAsync(std::forward<decltype(args)>(args)...).get();
+    }
 
-        if (! status.ok()) // TODO: handle different kind of status codes
-        {
-            if (plugin_info_.has_value())
+    /**
+     * @brief Send a generate request to the plugin, without waiting for the reply.
+     *
+     * The request is converted before this returns, so the arguments don't need to outlive the call. Neither does this proxy: the call and its future only hold on to
+     * copies of what they need.
+     *
+     * @return A future for the generated value. Retrieving it throws a RemoteException if the plugin call failed.
+     */
+    std::future<value_type> generateAsync(auto&&... args)
+    {
+        auto call = std::make_shared<pending_call<decltype(req_(std::forward<decltype(args)>(args)...))>>(req_(std::forward<decltype(args)>(args)...));
+        std::future<void> done = spawnInvokeCall(call);
+        return std::async(
+            std::launch::deferred,
+            [call, done = std::move(done), rsp = rsp_, slot_info = slot_info_, plugin_info = plugin_info_]() mutable -> value_type
             {
-                spdlog::error(
-                    "Plugin '{}' running at [{}] for slot {} failed with error: {}",
-                    plugin_info_.value().plugin_name,
-                    plugin_info_.value().peer,
-                    slot_info_.slot_id,
-                    status.error_message());
-                throw exceptions::RemoteException(slot_info_, plugin_info_.value(), status.error_message());
-            }
-            spdlog::error("Plugin for slot {} failed with error: {}", slot_info_.slot_id, status.error_message());
-            throw exceptions::RemoteException(slot_info_, status.error_message());
-        }
-        return ret_value;
+                done.get();
+                checkStatus(call->status, slot_info, plugin_info);
+                return rsp(call->response);
+            });
     }
 
     value_type modify(auto& original_value, auto&&... args)
     {
-        agrpc::GrpcContext grpc_context;
-        value_type ret_value{};
-        grpc::Status status;
-
-        boost::asio::co_spawn(
-            grpc_context,
-            [this, &grpc_context, &status, &ret_value, &original_value, &args...]()
-            {
-                return this->modifyCall(grpc_context, status, ret_value, original_value, std::forward<decltype(args)>(args)...);
-            },
-            boost::asio::detached);
-        grpc_context.run();
+        return modifyAsync(original_value, std::forward<decltype(args)>(args)...).get();
+    }
 
-        if (! status.ok()) // TODO: handle different kind of status codes
-        {
-            if (plugin_info_.has_value())
+    /**
+     * @brief Send a modify request to the plugin, without waiting for the reply.
+     *
+     * Several requests can be in flight at the same time, so a caller with many values to modify can first send all of them and then collect the replies.
+     *
+     * @param original_value The value to modify. The response is applied to it when the result is retrieved, so it has to stay alive until then. This proxy does not.
+     * @return A future for the modified value. Retrieving it throws a RemoteException if the plugin call failed.
+     */
+    std::future<value_type> modifyAsync(auto& original_value, auto&&... args)
+    {
+        auto call
+            = std::make_shared<pending_call<decltype(req_(original_value, std::forward<decltype(args)>(args)...))>>(req_(original_value, std::forward<decltype(args)>(args)...));
+        std::future<void> done = spawnInvokeCall(call);
+        return std::async(
+            std::launch::deferred,
+            [call, done = std::move(done), &original_value, rsp = rsp_, slot_info = slot_info_, plugin_info = plugin_info_]() mutable -> value_type
             {
-                spdlog::error(
-                    "Plugin '{}' running at [{}] for slot {} failed with error: {}",
-                    plugin_info_.value().plugin_name,
-                    plugin_info_.value().peer,
-                    slot_info_.slot_id,
-                    status.error_message());
-                throw exceptions::RemoteException(slot_info_, plugin_info_.value(), status.error_message());
-            }
-            spdlog::error("Plugin for slot {} failed with error: {}", slot_info_.slot_id, status.error_message());
-            throw exceptions::RemoteException(slot_info_, status.error_message());
-        }
-        return ret_value;
+                done.get();
+                checkStatus(call->status, slot_info, plugin_info);
+                return rsp(original_value, call->response);
+            });
     }
 
     template<plugins::v0::SlotID Subscription>
@@ -238,104 +284,119 @@ public:
         {
             return;
         }
-        agrpc::GrpcContext grpc_context;
         grpc::Status status;
+        const std::thread::id thread_id = std::this_thread::get_id();
 
-        boost::asio::co_spawn(
-            grpc_context,
-            [this, &grpc_context, &status, &args...]()
-            {
-                return this->broadcastCall<Subscription>(grpc_context, status, std::forward<decltype(args)>(args)...);
-            },
-            boost::asio::detached);
-        grpc_context.run();
+        grpc_context_
+            ->spawn(
+                [this, &status, thread_id, &args...]()
+                {
+                    return this->broadcastCall<Subscription>(status, thread_id, std::forward<decltype(args)>(args)...);
+                })
+            .get();
+        checkStatus(status, slot_info_, plugin_info_);
+    }
 
-        if (! status.ok()) // TODO: handle different kind of status codes
+private:
+    /**
+     * @brief The state of one invoke call, shared between the coroutine that performs it and the future that collects its result.
+     */
+    template<typename Request>
+    struct pending_call
+    {
+        explicit pending_call(Request&& value)
+            : request{ std::move(value) }
         {
-            if (plugin_info_.has_value())
-            {
-                spdlog::error(
-                    "Plugin '{}' running at [{}] for slot {} failed with error: {}",
-                    plugin_info_.value().plugin_name,
-                    plugin_info_.value().peer,
-                    slot_info_.slot_id,
-                    status.error_message());
-                throw exceptions::RemoteException(slot_info_, plugin_info_.value(), status.error_message());
-            }
-            spdlog::error("Plugin for slot {} failed with error: {}", slot_info_.slot_id, status.error_message());
-            throw exceptions::RemoteException(slot_info_, status.error_message());
         }
-    }
 
-private:
-    inline static void prep_client_context(grpc::ClientContext& client_context, const slot_metadata& slot_info, const std::chrono::milliseconds& timeout = std::chrono::minutes(5))
+        Request request;
+        rsp_msg_type response{};
+        grpc::Status status{};
+    };
+
+    inline static void prep_client_context(
+        grpc::ClientContext& client_context,
+        const slot_metadata& slot_info,
+        const std::thread::id thread_id,
+        const std::chrono::milliseconds& timeout = std::chrono::minutes(5))
     {
         // Set time-out
         client_context.set_deadline(std::chrono::system_clock::now() + timeout);
 
         // Metadata
         client_context.AddMetadata("cura-engine-uuid", slot_info.engine_uuid.data());
-        client_context.AddMetadata("cura-thread-id", fmt::format("{}", std::this_thread::get_id()));
+        client_context.AddMetadata("cura-thread-id", fmt::format("{}", thread_id));
     }
 
     /**
-     * @brief Executes the invokeCall operation with the plugin.
-     *
-     * Sends a request to the plugin and saves the response.
+     * @brief Log and throw if a call to the plugin failed.
      *
-     * @param grpc_context - The gRPC context to use for the call
-     * @param status - Status of the gRPC call which gets updated in this method
-     * @param ret_value - Reference to the value in which response to be stored
-     * @param args - Request arguments
-     * @return A boost::asio::awaitable<void> indicating completion of the operation
+     * @param status - Status of the finished gRPC call
+     * @param slot_info - The slot the call was made for
+     * @param plugin_info - The plugin the call was made to, if the handshake told which one it is
      */
-    boost::asio::awaitable<void> generateCall(agrpc::GrpcContext& grpc_context, grpc::Status& status, value_type& ret_value, auto&&... args)
+    static void checkStatus(const grpc::Status& status, const slot_metadata& slot_info, const std::optional<plugin_metadata>& plugin_info)
     {
-        using RPC = agrpc::ClientRPC<&invoke_stub_t::PrepareAsyncCall>;
-        grpc::ClientContext client_context{};
-        prep_client_context(client_context, slot_info_);
-
-        // Construct request
-        auto request{ req_(std::forward<decltype(args)>(args)...) };
-
-        // Make unary request
-        rsp_msg_type response;
-        status = co_await RPC::request(grpc_context, invoke_stub_, client_context, request, response, boost::asio::use_awaitable);
-        ret_value = rsp_(response);
-        co_return;
+        if (status.ok()) // TODO: handle different kind of status codes
+        {
+            return;
+        }
+        if (plugin_info.has_value())
+        {
+            spdlog::error(
+                "Plugin '{}' running at [{}] for slot {} failed with error: {}",
+                plugin_info.value().plugin_name,
+                plugin_info.value().peer,
+                slot_info.slot_id,
+                status.error_message());
+            throw exceptions::RemoteException(slot_info, plugin_info.value(), status.error_message());
+        }
+        spdlog::error("Plugin for slot {} failed with error: {}", slot_info.slot_id, status.error_message());
+        throw exceptions::RemoteException(slot_info, status.error_message());
     }
 
-    boost::asio::awaitable<void> modifyCall(agrpc::GrpcContext& grpc_context, grpc::Status& status, value_type& ret_value, auto& original_value, auto&&... args)
+    /**
+     * @brief Start the invoke call with the plugin on the persistent context.
+     *
+     * Sends the request of the call to the plugin and saves the response and status in the call. The coroutine doesn't refer to this proxy, since the proxy may be a
+     * copy that is destroyed before the call finishes. The context itself outlives the call, because its destructor waits for the calls in flight.
+     *
+     * @param call - The request, which also receives the response and status
+     * @return A future that becomes ready when the response has been received
+     */
+    template<typename Request>
+    std::future<void> spawnInvokeCall(std::shared_ptr<pending_call<Request>> call)
     {
-        using RPC = agrpc::ClientRPC<&invoke_stub_t::PrepareAsyncCall>;
-        grpc::ClientContext client_context{};
-        prep_client_context(client_context, slot_info_);
-
-        // Construct request
-        auto request{ req_(original_value, std::forward<decltype(args)>(args)...) };
+        const std::thread::id thread_id = std::this_thread::get_id(); // Report the thread that needs the result, rather than the thread that runs the context.
+        return grpc_context_->spawn(
+            [&grpc_context = grpc_context_->get(), invoke_stub = invoke_stub_, slot_info = slot_info_, call, thread_id]() -> boost::asio::awaitable<void>
+            {
+                using RPC = agrpc::ClientRPC<&invoke_stub_t::PrepareAsyncCall>;
+                grpc::ClientContext client_context{};
+                prep_client_context(client_context, slot_info, thread_id);
 
-        // Make unary request
-        rsp_msg_type response;
-        status = co_await RPC::request(grpc_context, invoke_stub_, client_context, request, response, boost::asio::use_awaitable);
-        ret_value = std::move(rsp_(original_value, response));
-        co_return;
+                // Make unary request
+                call->status = co_await RPC::request(grpc_context, *invoke_stub, client_context, call->request, call->response, boost::asio::use_awaitable);
+                co_return;
+            });
     }
 
     template<plugins::v0::SlotID Subscription>
-    boost::asio::awaitable<void> broadcastCall(agrpc::GrpcContext& grpc_context, grpc::Status& status, auto&&... args)
+    boost::asio::awaitable<void> broadcastCall(grpc::Status& status, const std::thread::id thread_id, auto&&... args)
     {
         grpc::ClientContext client_context{};
-        prep_client_context(client_context, slot_info_);
+        prep_client_context(client_context, slot_info_, thread_id);
         using RPC = agrpc::ClientRPC<&broadcast_stub_t::PrepareAsyncBroadcastSettings>;
 
         details::broadcast_rpc<Subscription, broadcast_stub_t> requester{};
         auto request = requester(std::forward<decltype(args)>(args)...);
 
         auto response = google::protobuf::Empty{};
-        status = co_await RPC::request(grpc_context, broadcast_stub_, client_context, request, response, boost::asio::use_awaitable);
+        status = co_await RPC::request(grpc_context_->get(), broadcast_stub_, client_context, request, response, boost::asio::use_awaitable);
         co_return;
     }
 
+    std::shared_ptr<details::PersistentGrpcContext> grpc_context_; ///< The context on which all calls to the plugin run, shared between copies of this proxy.
     validator_type valid_{}; ///< The validator object for plugin validation.
     req_converter_type req_{}; ///< The Invoke request converter object.
     rsp_converter_type rsp_{}; ///< The Invoke response converter object.
@@ -0,0 +1,175 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#ifndef PLUGINS_SHAREDMEMORYRING_H
+#define PLUGINS_SHAREDMEMORYRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+namespace cura
+{
+class Polygons;
+}
+
+namespace cura::plugins
+{
+
+/**
+ * @brief A single-producer, single-consumer ring buffer of messages in named shared memory.
+ *
+ * This is meant as a transport for the bulk data of plugins that run on the same host as the engine, such as the coordinates of paths and polygons. Sending those through
+ * gRPC means converting them to protobuf messages, serializing, copying them through a socket and parsing them again on the other side. With a ring, the coordinates are
+ * copied once into memory that both processes have mapped, in a flat binary layout, and gRPC is left with the small control messages.
+ *
+ * One side creates the ring and the other side opens it by name. Each direction of communication needs its own ring, since only one process may push to a ring and only one
+ * process may pop from it. Both processes have to run on the same machine with the same byte order and point layout, which is the case for local plugins.
+ *
+ * Messages are stored as a 64-bit size followed by the payload, padded to a multiple of 8 bytes. Polygons are stored as the number of polygons, the number of points of each
+ * polygon and then all points of all polygons as consecutive Point2LL.
+ */
+class SharedMemoryRing
+{
+public:
+    static constexpr size_t default_capacity = 64 * 1024 * 1024; ///< Large enough for the paths of a big layer.
+
+    /**
+     * @brief Create a new ring. It is removed from the system again when this object is destroyed.
+     *
+     * An existing ring with the same name, for instance left behind by a crashed process, is replaced.
+     *
+     * @param name The name with which the other process can open the ring.
+     * @param capacity The number of bytes available for messages, rounded up to a multiple of 8.
+     * @throws boost::interprocess::interprocess_exception if the shared memory can't be created.
+     */
+    static SharedMemoryRing create(const std::string& name, size_t capacity = default_capacity);
+
+    /**
+     * @brief Open a ring that was created by another process (or another part of this process).
+     *
+     * @throws boost::interprocess::interprocess_exception if there is no ring with this name.
+     */
+    static SharedMemoryRing open(const std::string& name);
+
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+    SharedMemoryRing(SharedMemoryRing&& other) noexcept;
+    SharedMemoryRing& operator=(SharedMemoryRing&&) = delete;
+    ~SharedMemoryRing();
+
+    /**
+     * @brief The number of bytes available for messages, including their size fields and padding.
+     */
+    [[nodiscard]] size_t capacity() const noexcept;
+
+    /**
+     * @brief Add a message to the ring, if there is room for it.
+     *
+     * @return Whether the message was added. A message that is larger than the capacity never fits.
+     */
+    bool tryPush(std::span<const std::byte> message);
+
+    /**
+     * @brief Add polygons to the ring in the flat layout, if there is room for them.
+     *
+     * @return Whether the polygons were added.
+     */
+    bool tryPush(const Polygons& polygons);
+
+    /**
+     * @brief Take the oldest message from the ring, if there is one.
+     *
+     * @param[out] message Gets replaced by the message.
+     * @return Whether there was a message.
+     */
+    bool tryPop(std::vector<std::byte>& message);
+
+    /**
+     * @brief Take the oldest message from the ring, if there is one, and read it as polygons in the flat layout.
+     *
+     * @param[out] polygons Gets replaced by the polygons.
+     * @return Whether there was a message.
+     * @throws std::runtime_error if the message is not a valid flat layout. The message is dropped from the ring.
+     */
+    bool tryPop(Polygons& polygons);
+
+    /**
+     * @brief Add a message to the ring, waiting for the consumer to make room if needed.
+     *
+     * @throws std::length_error if the message is larger than the capacity.
+     */
+    void push(std::span<const std::byte> message);
+    void push(const Polygons& polygons);
+
+    /**
+     * @brief Take the oldest message from the ring, waiting for the producer if there is none.
+     */
+    void pop(std::vector<std::byte>& message);
+    void pop(Polygons& polygons);
+
+private:
+    /**
+     * @brief The part of the shared memory in front of the messages.
+     *
+     * The positions count the bytes that were ever pushed and popped, so they only increase. The producer only writes the push position and the consumer only writes the pop
+     * position, each on its own cache line.
+     */
+    struct Header
+    {
+        alignas(64) std::atomic<uint64_t> push_position;
+        alignas(64) std::atomic<uint64_t> pop_position;
+        alignas(64) uint64_t capacity;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "The positions are shared between processes, so they may not use a lock that lives in one of them.");
+
+    SharedMemoryRing(std::string name, boost::interprocess::shared_memory_object shared_memory, bool is_owner);
+
+    /**
+     * @brief The space a message with a payload of \p payload_size takes, including the size field and the padding.
+     */
+    static size_t recordSize(size_t payload_size) noexcept;
+
+    /**
+     * @brief Copy bytes into the ring, wrapping around at the end.
+     */
+    void write(uint64_t position, const void* source, size_t size) noexcept;
+
+    /**
+     * @brief Copy bytes out of the ring, wrapping around at the end.
+     */
+    void read(uint64_t position, void* destination, size_t size) const noexcept;
+
+    /**
+     * @brief Whether there is room for a message with a payload of \p payload_size bytes.
+     *
+     * @param[out] position Where the message has to be written.
+     */
+    bool reserve(size_t payload_size, uint64_t& position) const noexcept;
+
+    /**
+     * @brief Whether there is a message to pop.
+     *
+     * @param[out] position Where the message starts.
+     * @param[out] payload_size The size of the message.
+     */
+    bool peek(uint64_t& position, uint64_t& payload_size) const noexcept;
+
+    std::string name_;
+    boost::interprocess::shared_memory_object shared_memory_;
+    boost::interprocess::mapped_region region_;
+    Header* header_{ nullptr };
+    std::byte* data_{ nullptr };
+    bool is_owner_{ false };
+};
+
+} // namespace cura::plugins
+
+#endif // PLUGINS_SHAREDMEMORYRING_H
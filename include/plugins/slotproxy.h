@@ -6,9 +6,12 @@
 
 #include <concepts>
 #include <functional>
+#include <future>
 #include <grpcpp/channel.h>
 #include <memory>
 #include <optional>
+#include <tuple>
+#include <utility>
 
 #include <boost/asio/use_awaitable.hpp>
 
@@ -96,6 +99,35 @@ public:
         return std::invoke(default_process, original_value, std::forward<decltype(args)>(args)...);
     }
 
+    /**
+     * @brief Starts the plugin operation without waiting for its result.
+     *
+     * With a plugin, the request is sent right away, so that the plugin can work on it while the caller continues. Without a plugin, the default behavior is deferred until
+     * the result is retrieved.
+     *
+     * @param original_value The value to modify, which has to stay alive until the result is retrieved.
+     * @param args The arguments for the plugin request. They are copied (or moved) for the default behavior, so they don't have to outlive this call.
+     * @return A future for the result of the plugin request or the default behavior.
+     */
+    auto modifyAsync(auto& original_value, auto&&... args)
+    {
+        if (plugin_.has_value())
+        {
+            return plugin_.value().modifyAsync(original_value, std::forward<decltype(args)>(args)...);
+        }
+        return std::async(
+            std::launch::deferred,
+            [process = default_process, &original_value, arguments = std::make_tuple(std::forward<decltype(args)>(args)...)]() mutable
+            {
+                return std::apply(
+                    [&process, &original_value](auto&&... unpacked_args)
+                    {
+                        return std::invoke(process, original_value, std::forward<decltype(unpacked_args)>(unpacked_args)...);
+                    },
+                    std::move(arguments));
+            });
+    }
+
     template<v0::SlotID S>
     void broadcast(auto&&... args)
     {
@@ -6,6 +6,7 @@
 
 #ifdef ENABLE_PLUGINS
 #include <exception>
+#include <future>
 #include <memory>
 #include <tuple>
 #include <utility>
@@ -156,6 +157,12 @@ public:
         return get<S>().modify(original_value, std::forward<decltype(args)>(args)...);
     }
 
+    template<v0::SlotID S>
+    auto modifyAsync(auto& original_value, auto&&... args)
+    {
+        return get<S>().modifyAsync(original_value, std::forward<decltype(args)>(args)...);
+    }
+
     template<v0::SlotID S>
     constexpr auto generate(auto&&... args)
     {
@@ -239,6 +246,9 @@ using slots = plugins::details::SingletonRegistry<plugins::SlotTypes, plugins::d
 } // namespace cura
 
 #else // No Engine plugin support
+#include <future>
+#include <type_traits>
+
 namespace cura
 {
 
@@ -271,6 +281,17 @@ struct Slots
         return std::forward<decltype(data)>(data);
     }
 
+    template<plugins::v0::SlotID S>
+    auto modifyAsync(auto& data, auto&&... args)
+    {
+        return std::async(
+            std::launch::deferred,
+            [&data]()
+            {
+                return std::remove_cvref_t<decltype(data)>(data);
+            });
+    }
+
     template<plugins::v0::SlotID S>
     constexpr auto broadcast(auto&&... args) noexcept
     {
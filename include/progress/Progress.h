@@ -56,6 +56,7 @@ private:
     static std::array<double, N_PROGRESS_STAGES> accumulated_times; //!< Time past before each stage
     static double total_timing; //!< An estimate of the total time
     static std::optional<LayerIndex> first_skipped_layer; //!< The index of the layer for which we skipped time reporting
+    static std::array<double, N_PROGRESS_STAGES> stage_durations; //!< Time spent in each stage since the start of the process, in seconds
     /*!
      * Give an estimate between 0 and 1 of how far the process is.
      *
@@ -95,6 +96,15 @@ public:
      *                       because it is not relevant
      */
     static void messageProgressLayer(LayerIndex layer_nr, size_t total_layers, double total_time, const TimeKeeper::RegisteredTimes& stages, double skip_threshold = 0.1);
+
+    /*!
+     * Get the time spent in each stage, summed over all mesh groups and slices
+     * since the start of the process, in seconds. Only stages that were
+     * reported with a time keeper are timed.
+     */
+    static const std::array<double, N_PROGRESS_STAGES>& getStageDurations();
+
+    static std::string_view getStageName(Stage stage);
 };
 
 
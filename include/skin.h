@@ -4,13 +4,16 @@
 #ifndef SKIN_H
 #define SKIN_H
 
+#include <optional>
+
 #include "settings/types/LayerIndex.h"
 #include "utils/Coord_t.h"
+#include "utils/LayerRangeIntersection.h"
+#include "utils/polygon.h"
 
 namespace cura
 {
 
-class Polygons;
 class SkinPart;
 class SliceLayerPart;
 class SliceMeshStorage;
@@ -30,8 +33,23 @@ public:
      * stored and where the skin insets and fill areas (output) are stored.
      * \param process_infill Whether to process infill, i.e. whether there's a
      * positive infill density or there are infill meshes modifying this mesh.
+     * \param outline_intersections Optional table of the intersections of the
+     * layer outlines of the \p mesh, as made by \ref buildOutlineIntersections.
+     * Without it, the intersections of the layers above and below are computed
+     * from scratch for every part.
+     */
+    SkinInfillAreaComputation(const LayerIndex& layer_nr, SliceMeshStorage& mesh, bool process_infill, const LayerRangeIntersection* outline_intersections = nullptr);
+
+    /*!
+     * \brief Precompute the intersections of the outlines of ranges of layers
+     * of a mesh, which the top and bottom skin computation of all layers can
+     * then share.
+     *
+     * \param mesh The mesh, of which the outlines must be final.
+     * \return The table, or nothing if the skin settings of the mesh don't
+     * intersect multiple layers anyway.
      */
-    SkinInfillAreaComputation(const LayerIndex& layer_nr, SliceMeshStorage& mesh, bool process_infill);
+    static std::optional<LayerRangeIntersection> buildOutlineIntersections(const SliceMeshStorage& mesh);
 
     /*!
      * Generate the skin areas and its insets.
@@ -177,6 +195,10 @@ protected:
     coord_t top_skin_expand_distance_; //!< The distance by which the top skins should be larger than the original top skins.
     coord_t bottom_skin_expand_distance_; //!< The distance by which the bottom skins should be larger than the original bottom skins.
 
+    const LayerRangeIntersection* outline_intersections_; //!< Shared intersections of the outlines of ranges of layers, if available.
+    std::optional<Polygons> not_air_below_; //!< The area covered by all bottom skin layers below this layer, for all parts at once. Computed on first use.
+    std::optional<Polygons> not_air_above_; //!< The area covered by all top skin layers above this layer, for all parts at once. Computed on first use.
+
 private:
     static coord_t getSkinLineWidth(const SliceMeshStorage& mesh, const LayerIndex& layer_nr); //!< Compute the skin line width, which might be different for the first layer.
 
@@ -192,6 +214,14 @@ private:
      * \param layer2_nr The layer index from which to gather the outlines.
      */
     Polygons getOutlineOnLayer(const SliceLayerPart& part_here, const LayerIndex layer2_nr);
+
+    /*!
+     * Helper function to get the polygons of \p area which might intersect
+     * with \p part_here.
+     * \param part_here The part for which to check.
+     * \param area The area of all parts of a layer or layer range.
+     */
+    Polygons getAreaNearPart(const SliceLayerPart& part_here, const Polygons& area);
 };
 
 } // namespace cura
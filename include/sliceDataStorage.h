@@ -4,9 +4,12 @@
 #ifndef SLICE_DATA_STORAGE_H
 #define SLICE_DATA_STORAGE_H
 
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
 
 #include "PrimeTower.h"
 #include "RetractionConfig.h"
@@ -200,6 +203,12 @@ public:
      */
     void getOutlines(Polygons& result, bool external_polys_only = false) const;
 
+    /*!
+     * Free the memory of all geometry in this layer, once it's no longer
+     * needed. The height and thickness of the layer are kept.
+     */
+    void release();
+
     ~SliceLayer();
 };
 
@@ -219,6 +228,12 @@ public:
     Polygons support_mesh; //!< Areas from support meshes which should NOT be supported by more support
     Polygons anti_overhang; //!< Areas where no overhang should be detected.
 
+    /*!
+     * Free the memory of all support areas in this layer, once they are no
+     * longer needed.
+     */
+    void release();
+
     /*!
      * Exclude the given polygons from the support infill areas and update the SupportInfillParts.
      *
@@ -421,6 +436,14 @@ public:
      * \param include_models Whether to include the models in the outline
      * \param external_polys_only Whether to disregard all hole polygons.
      * \param extruder_nr (optional) only give back outlines for this extruder (where the walls are printed with this extruder)
+     *
+     * The outlines are cached per combination of parameters, so asking for the
+     * same outlines again is cheap. The cache holds a bounded number of
+     * vertices, dropping the layers that were cached first when it's full.
+     * Functions that modify the support, prime tower or raft outlines must call
+     * \ref invalidateLayerOutlines afterwards.
+     * The models themselves are expected to be final by the time the outlines
+     * are first asked for.
      */
     Polygons getLayerOutlines(
         const LayerIndex layer_nr,
@@ -430,6 +453,19 @@ public:
         const int extruder_nr = -1,
         const bool include_models = true) const;
 
+    /*!
+     * Drop the cached layer outlines that include support, the prime tower or
+     * the raft, because those were changed. Outlines of only the models are
+     * kept.
+     */
+    void invalidateLayerOutlines();
+
+    /*!
+     * Drop the cached outlines of a layer that won't be asked for any more,
+     * such as a layer that is released after its G-code is written.
+     */
+    void forgetLayerOutlines(const LayerIndex layer_nr);
+
     /*!
      * Get the extruders used.
      *
@@ -463,6 +499,54 @@ public:
     Polygons getMachineBorder(int extruder_nr = -1) const;
 
 private:
+    /*!
+     * The parameters of a \ref getLayerOutlines call, apart from the layer.
+     */
+    struct LayerOutlinesKey
+    {
+        int extruder_nr;
+        bool include_support;
+        bool include_prime_tower;
+        bool external_polys_only;
+        bool include_models;
+
+        bool operator==(const LayerOutlinesKey& other) const = default;
+    };
+
+    struct CachedLayerOutlines
+    {
+        LayerOutlinesKey key;
+        Polygons outlines;
+    };
+
+    /*!
+     * The most vertices that the cached layer outlines may have together. Past
+     * this, the layers that were cached first are dropped.
+     */
+    static constexpr size_t max_cached_layer_outline_vertices = size_t(1) << 22;
+
+    mutable std::mutex layer_outlines_cache_mutex_; //!< Guards the cache, since the outlines are asked for from parallel loops over the layers.
+    mutable std::unordered_map<LayerIndex, std::vector<CachedLayerOutlines>> layer_outlines_cache_; //!< Per layer, since only a few combinations of arguments are used.
+    mutable std::deque<LayerIndex> layer_outlines_cache_order_; //!< The cached layers, in the order in which they were first cached.
+    mutable size_t layer_outlines_cache_vertices_ = 0;
+
+    /*!
+     * Drop the cached outlines of one layer. The cache must be locked.
+     */
+    void eraseCachedLayerOutlines(const LayerIndex layer_nr) const;
+
+    /*!
+     * Compute the outlines of \ref getLayerOutlines without looking at the
+     * cache.
+     */
+    Polygons computeLayerOutlines(
+        const LayerIndex layer_nr,
+        const bool include_support,
+        const bool include_prime_tower,
+        const bool external_polys_only,
+        const int extruder_nr,
+        const bool include_models) const;
+
     /*!
      * Construct the retraction_wipe_config_per_extruder
      */
@@ -6,7 +6,6 @@
 
 #include <optional>
 #include <queue>
-#include <unordered_map>
 
 #include "settings/EnumSettings.h"
 #include "utils/polygon.h"
@@ -56,8 +55,13 @@ public:
 class SlicerLayer
 {
 public:
+    /*!
+     * The segments of this layer, in order of SlicerSegment::faceIndex.
+     *
+     * Every face creates at most one segment per layer, so the segment of a
+     * face is found with a binary search rather than through a map per layer.
+     */
     std::vector<SlicerSegment> segments;
-    std::unordered_map<int, int> face_idx_to_segment_idx; // topology
 
     int z = -1;
     Polygons polygons;
@@ -400,6 +404,14 @@ private:
      */
     int tryFaceNextSegmentIdx(const SlicerSegment& segment, const int face_idx, const size_t start_segment_idx) const;
 
+    /*!
+     * Find the segment that face \p face_idx created in this layer.
+     *
+     * \param[in] face_idx The index of the face in the mesh.
+     * \return The index of the segment, or -1 if the face doesn't intersect this layer.
+     */
+    int findSegmentIdx(const int face_idx) const;
+
     /*!
      * Find possible allowed stitches in goodness order.
      *
@@ -485,8 +497,63 @@ public:
 
     Slicer(Mesh* mesh, const coord_t thickness, const size_t slice_layer_count, bool use_variable_layer_heights, std::vector<AdaptiveLayer>* adaptive_layers);
 
+    /*!
+     * \brief Slice all meshes of a mesh group at once.
+     *
+     * Constructing a slicer per mesh goes through the layers of one mesh at a
+     * time in parallel. This slices the layers of all meshes in the same
+     * parallel loops instead, which saves most of the waiting for each loop to
+     * finish when there are many meshes with few layers each.
+     * \param meshes The meshes to slice.
+     * \param thickness Thickness of the layers (apart from the first one).
+     * \param slice_layer_count The amount of layers to slice.
+     * \param use_variable_layer_heights Whether to use adaptive layer heights.
+     * \param adaptive_layers Adaptive layers (if use_variable_layer_heights).
+     * \return A slicer for every mesh, in the same order as the meshes. The
+     * caller takes ownership of them.
+     */
+    static std::vector<Slicer*>
+        sliceMeshes(std::vector<Mesh>& meshes, const coord_t thickness, const size_t slice_layer_count, bool use_variable_layer_heights, std::vector<AdaptiveLayer>* adaptive_layers);
 
 private:
+    /*!
+     * The slicing tolerance and offsets that are applied to the sliced
+     * polygons of a mesh, and the state to apply them to all layers in
+     * parallel.
+     */
+    struct PolygonAdjustment
+    {
+        SlicingTolerance slicing_tolerance = SlicingTolerance::MIDDLE;
+        coord_t xy_offset = 0;
+        coord_t xy_offset_0 = 0;
+        coord_t xy_offset_hole = 0;
+        coord_t hole_offset_max_diameter = 0;
+        double max_hole_area = 0.0;
+        size_t layer_apply_initial_xy_offset = 0; //!< Up to which layer the initial layer offset is used.
+        std::vector<Polygons> tolerance_polygons; //!< The layers after applying the slicing tolerance, if it combines them with the layers above them.
+    };
+
+    /*!
+     * Create a slicer for a mesh without any layers yet.
+     */
+    explicit Slicer(Mesh* mesh);
+
+    /*!
+     * Create the layers to slice the mesh in, at their heights.
+     * \param thickness Thickness of the layers (apart from the first one).
+     * \param slice_layer_count The amount of layers to slice.
+     * \param use_variable_layer_heights Whether to use adaptive layer heights.
+     * \param adaptive_layers Adaptive layers (if use_variable_layer_heights).
+     */
+    void buildLayers(const coord_t thickness, const size_t slice_layer_count, bool use_variable_layer_heights, std::vector<AdaptiveLayer>* adaptive_layers);
+
+    /*!
+     * Slice the layers of all slicers in the same parallel loops.
+     * \param slicers The slicers, of which the layers have been built.
+     * \param meshes The mesh of each slicer.
+     */
+    static void slice(const std::vector<Slicer*>& slicers, const std::vector<Mesh*>& meshes);
+
     /*!
      * \brief Linear interpolation between coordinates of a line.
      *
@@ -521,12 +588,42 @@ private:
      */
     static std::vector<std::pair<int32_t, int32_t>> buildZHeightsForFaces(const Mesh& mesh);
 
-    /*! Creates the polygons in layers.
-     * \param[in] mesh The mesh which is analyzed.
+    /*!
+     * Get the settings to apply the slicing tolerance and offsets to the sliced
+     * polygons of a mesh with, and apply the slicing tolerance to its first
+     * layer already.
+     * \param[in] mesh The mesh which is sliced.
      * \param[in] slicing_tolerance The way the slicing tolerance should be applied (MIDDLE/INCLUSIVE/EXCLUSIVE).
-     * \param[in, out] layers The polygon are created here.
+     * \param[in] layers The sliced layers of the mesh.
+     */
+    static PolygonAdjustment prepareAdjustment(const Mesh& mesh, const SlicingTolerance slicing_tolerance, const std::vector<SlicerLayer>& layers);
+
+    /*!
+     * Combine the polygons of a layer with those of the layer above it,
+     * according to an inclusive or exclusive slicing tolerance.
+     * \param[in] slicing_tolerance The way the slicing tolerance should be applied (INCLUSIVE/EXCLUSIVE).
+     * \param[in] layers The sliced layers, before any of them are combined.
+     * \param[in] layer_nr The layer to combine.
+     * \return The combined polygons of the layer.
+     */
+    static Polygons applySlicingTolerance(const SlicingTolerance slicing_tolerance, const std::vector<SlicerLayer>& layers, const size_t layer_nr);
+
+    /*!
+     * Apply the slicing tolerance and offsets to one layer. This can be done
+     * for all layers in parallel.
+     * \param[in, out] adjustment The adjustment as prepared for the mesh.
+     * \param[in, out] layers The sliced layers of the mesh.
+     * \param[in] layer_nr The layer to adjust.
+     */
+    static void adjustLayer(PolygonAdjustment& adjustment, std::vector<SlicerLayer>& layers, const size_t layer_nr);
+
+    /*!
+     * Store the adjusted polygons in the layers, once all of them are adjusted.
+     * \param[in, out] adjustment The adjustment of which all layers are done.
+     * \param[in, out] layers The sliced layers of the mesh.
+     * \param[in, out] mesh The mesh, of which the bounding box is expanded by the offset.
      */
-    static void makePolygons(Mesh& mesh, SlicingTolerance slicing_tolerance, std::vector<SlicerLayer>& layers);
+    static void finishAdjustment(PolygonAdjustment& adjustment, std::vector<SlicerLayer>& layers, Mesh& mesh);
 
     /*! Creates a vector of layers and set their z value.
      * \param[in] mesh The mesh which is analyzed.
@@ -546,14 +643,13 @@ private:
         bool use_variable_layer_heights,
         const std::vector<AdaptiveLayer>* adaptive_layers);
 
-    /*! Creates the segments and write them into the layers.
+    /*! Creates the segments of a layer and write them into it.
      * \param[in] mesh The mesh which is analyzed.
      * \param[in] zbboxes The z part of the bounding boxes of the faces of the mesh.
      * \param[in] slicing_tolderance Slicing tolerance in order to figure out what happens when vertices are exactly on the slicing boundary.
-     * \param[in, out] layers The segments are created here.
+     * \param[in, out] layer The segments are created here.
      */
-    static void
-        buildSegments(const Mesh& mesh, const std::vector<std::pair<int32_t, int32_t>>& zbboxes, const SlicingTolerance& slicing_tolerance, std::vector<SlicerLayer>& layers);
+    static void buildSegments(const Mesh& mesh, const std::vector<std::pair<int32_t, int32_t>>& zbboxes, const SlicingTolerance& slicing_tolerance, SlicerLayer& layer);
 };
 
 } // namespace cura
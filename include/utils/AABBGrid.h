@@ -0,0 +1,176 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_AABB_GRID_H
+#define UTILS_AABB_GRID_H
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include "AABB.h"
+#include "SquareGrid.h"
+
+namespace cura
+{
+
+/*!
+ * Grid index on bounding boxes, to find the boxes that might overlap with a
+ * query box without checking all of them.
+ *
+ * Each box is registered in every cell it covers. Boxes that would cover many
+ * cells are kept in a separate list that every query returns, so that a few
+ * huge boxes don't fill the grid.
+ *
+ * The grid only stores handles; the boxes themselves stay with the caller.
+ * The results of a query are a superset of the handles whose boxes overlap the
+ * query box, so the caller still has to check the actual overlap.
+ *
+ * \tparam Handle A cheap to copy, ordered reference to a box, such as a
+ * pointer.
+ */
+template<typename Handle>
+class AABBGrid
+{
+public:
+    /*!
+     * Create an empty grid.
+     *
+     * \param cell_size The size of the grid cells. This is best chosen around
+     * the typical size of the boxes.
+     * \param max_cells_per_box Boxes that cover more cells than this are kept
+     * in the list of large boxes instead.
+     */
+    explicit AABBGrid(const coord_t cell_size, const size_t max_cells_per_box = 64)
+        : grid_(std::max(coord_t(1), cell_size))
+        , max_cells_per_box_(max_cells_per_box)
+    {
+    }
+
+    /*!
+     * Add a box to the grid. Boxes that are not valid (with a minimum beyond
+     * their maximum) can't overlap anything and are not stored.
+     */
+    void insert(const Handle& handle, const AABB& box)
+    {
+        forEachCell(
+            box,
+            [&](std::vector<Handle>& cell)
+            {
+                cell.push_back(handle);
+            });
+    }
+
+    /*!
+     * Remove a box from the grid. The box must be the same as when the handle
+     * was inserted.
+     */
+    void remove(const Handle& handle, const AABB& box)
+    {
+        forEachCell(
+            box,
+            [&](std::vector<Handle>& cell)
+            {
+                const auto found = std::find(cell.begin(), cell.end(), handle);
+                if (found != cell.end())
+                {
+                    *found = cell.back();
+                    cell.pop_back();
+                }
+            });
+    }
+
+    /*!
+     * Get the handles of all boxes that might overlap with \p box, each once.
+     *
+     * \param box The box to look around.
+     * \param[out] result The handles get appended to this. They are in no
+     * particular order.
+     */
+    void query(const AABB& box, std::vector<Handle>& result) const
+    {
+        const size_t start = result.size();
+        result.insert(result.end(), large_boxes_.begin(), large_boxes_.end());
+        if (box.min_.X > box.max_.X || box.min_.Y > box.max_.Y)
+        {
+            return;
+        }
+        const Point2LL min_cell = grid_.toGridPoint(box.min_);
+        const Point2LL max_cell = grid_.toGridPoint(box.max_);
+        if (cellCount(min_cell, max_cell) > static_cast<double>(cells_.size()))
+        {
+            // Cheaper to go over the cells that exist than over all cells that the box covers.
+            for (const auto& [cell_location, cell] : cells_)
+            {
+                if (cell_location.X >= min_cell.X && cell_location.X <= max_cell.X && cell_location.Y >= min_cell.Y && cell_location.Y <= max_cell.Y)
+                {
+                    result.insert(result.end(), cell.begin(), cell.end());
+                }
+            }
+        }
+        else
+        {
+            for (coord_t x = min_cell.X; x <= max_cell.X; ++x)
+            {
+                for (coord_t y = min_cell.Y; y <= max_cell.Y; ++y)
+                {
+                    const auto cell = cells_.find(Point2LL(x, y));
+                    if (cell != cells_.end())
+                    {
+                        result.insert(result.end(), cell->second.begin(), cell->second.end());
+                    }
+                }
+            }
+        }
+        // Boxes spanning multiple cells are found more than once.
+        const auto new_begin = result.begin() + start;
+        std::sort(new_begin, result.end());
+        result.erase(std::unique(new_begin, result.end()), result.end());
+    }
+
+private:
+    SquareGrid grid_;
+    size_t max_cells_per_box_;
+    std::unordered_map<Point2LL, std::vector<Handle>> cells_;
+    std::vector<Handle> large_boxes_; //!< Boxes that cover too many cells to register in each of them.
+
+    /*!
+     * The number of cells in a rectangle of cells, as a double so that huge
+     * boxes can't overflow it.
+     */
+    static double cellCount(const Point2LL& min_cell, const Point2LL& max_cell)
+    {
+        return (static_cast<double>(max_cell.X - min_cell.X) + 1.0) * (static_cast<double>(max_cell.Y - min_cell.Y) + 1.0);
+    }
+
+    /*!
+     * Call \p func with the handle list of every cell that \p box is stored
+     * in, or with the list of large boxes.
+     */
+    template<typename F>
+    void forEachCell(const AABB& box, F&& func)
+    {
+        if (box.min_.X > box.max_.X || box.min_.Y > box.max_.Y)
+        {
+            return;
+        }
+        const Point2LL min_cell = grid_.toGridPoint(box.min_);
+        const Point2LL max_cell = grid_.toGridPoint(box.max_);
+        if (cellCount(min_cell, max_cell) > static_cast<double>(max_cells_per_box_))
+        {
+            func(large_boxes_);
+            return;
+        }
+        for (coord_t x = min_cell.X; x <= max_cell.X; ++x)
+        {
+            for (coord_t y = min_cell.Y; y <= max_cell.Y; ++y)
+            {
+                func(cells_[Point2LL(x, y)]);
+            }
+        }
+    }
+};
+
+} // namespace cura
+
+#endif // UTILS_AABB_GRID_H
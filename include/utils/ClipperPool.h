@@ -0,0 +1,107 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_CLIPPER_POOL_H
+#define UTILS_CLIPPER_POOL_H
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <polyclipping/clipper.hpp>
+
+namespace cura
+{
+
+/*!
+ * Clipper engine borrowed from a per-thread pool for the duration of one
+ * boolean operation or offset.
+ *
+ * Constructing a ClipperLib::Clipper or ClipperLib::ClipperOffset for every
+ * operation allocates its internal tables (local minima, scanbeams, output
+ * records, normals) from scratch, which adds up when it's done millions of
+ * times per slice. Engines in the pool are cleared between uses but keep the
+ * capacity of those tables.
+ *
+ * Every thread has its own pool, so no locking is needed. Leases can be
+ * nested: an operation that needs another engine while it holds one simply
+ * gets a second engine from the pool.
+ *
+ * \tparam Engine Either ClipperLib::Clipper or ClipperLib::ClipperOffset.
+ */
+template<typename Engine>
+class PooledClipper
+{
+public:
+    /*!
+     * Borrow an engine for a boolean operation. Its options are reset to the
+     * defaults that ``Clipper(clipper_init)`` would have.
+     */
+    PooledClipper()
+        requires std::is_same_v<Engine, ClipperLib::Clipper>
+        : engine_(acquire())
+    {
+        engine_->ReverseSolution(false);
+        engine_->StrictlySimple(false);
+        engine_->PreserveCollinear(false);
+    }
+
+    /*!
+     * Borrow an engine for offsetting, with the same parameters as the
+     * ClipperOffset constructor.
+     */
+    PooledClipper(const double miter_limit, const double arc_tolerance)
+        requires std::is_same_v<Engine, ClipperLib::ClipperOffset>
+        : engine_(acquire())
+    {
+        engine_->MiterLimit = miter_limit;
+        engine_->ArcTolerance = arc_tolerance;
+    }
+
+    PooledClipper(const PooledClipper&) = delete;
+    PooledClipper& operator=(const PooledClipper&) = delete;
+
+    ~PooledClipper()
+    {
+        engine_->Clear();
+        freeList().push_back(std::move(engine_));
+    }
+
+    Engine* operator->()
+    {
+        return engine_.get();
+    }
+
+    Engine& operator*()
+    {
+        return *engine_;
+    }
+
+private:
+    std::unique_ptr<Engine> engine_;
+
+    static std::vector<std::unique_ptr<Engine>>& freeList()
+    {
+        thread_local std::vector<std::unique_ptr<Engine>> free_list;
+        return free_list;
+    }
+
+    static std::unique_ptr<Engine> acquire()
+    {
+        std::vector<std::unique_ptr<Engine>>& free_list = freeList();
+        if (free_list.empty())
+        {
+            return std::make_unique<Engine>();
+        }
+        std::unique_ptr<Engine> engine = std::move(free_list.back());
+        free_list.pop_back();
+        return engine;
+    }
+};
+
+using PooledClipperBoolean = PooledClipper<ClipperLib::Clipper>;
+using PooledClipperOffset = PooledClipper<ClipperLib::ClipperOffset>;
+
+} // namespace cura
+
+#endif // UTILS_CLIPPER_POOL_H
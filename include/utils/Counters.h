@@ -0,0 +1,224 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_COUNTERS_H
+#define UTILS_COUNTERS_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string_view>
+
+namespace cura
+{
+
+/*!
+ * Events on the hot paths of the engine that are counted.
+ */
+enum class Counter : size_t
+{
+    CLIPPER_BOOLEAN_CALLS,
+    CLIPPER_BOOLEAN_VERTICES,
+    CLIPPER_OFFSET_CALLS,
+    CLIPPER_OFFSET_VERTICES,
+    SETTINGS_GET_CALLS, // Including the lookups in parent settings that they fall back to.
+    COMB_ATTEMPTS,
+    COMB_FALLBACKS, // Travel moves that couldn't be combed.
+    SKELETAL_TRAPEZOIDATION_GRAPHS,
+    SKELETAL_TRAPEZOIDATION_NODES,
+    PATH_ORDER_OPTIMIZER_CALLS,
+    PATH_ORDER_OPTIMIZER_PATHS,
+    SEAM_CORNER_CACHE_HITS,
+    SEAM_CORNER_CACHE_MISSES,
+    COUNT // Not a counter, but the number of counters.
+};
+
+/*!
+ * Quantities on the hot paths of the engine of which the distribution is
+ * recorded, in buckets per power of two.
+ */
+enum class Histogram : size_t
+{
+    CLIPPER_BOOLEAN_VERTICES,
+    CLIPPER_OFFSET_VERTICES,
+    SKELETAL_TRAPEZOIDATION_NODES,
+    PATH_ORDER_OPTIMIZER_PATHS,
+    COUNT // Not a histogram, but the number of histograms.
+};
+
+/*!
+ * Registry of counters and histograms of what the engine does on its hot paths,
+ * such as how many polygon operations it performs on how many vertices, to
+ * find out why one slice takes so much longer than a similar one.
+ *
+ * The counters are only collected when the engine is built with
+ * ``ENABLE_PERFORMANCE_COUNTERS``. Otherwise \ref add and \ref record compile
+ * to nothing, so the calls can be left in the hot paths.
+ *
+ * Every thread counts in a shard of its own, so counting doesn't contend
+ * between threads. The shards are merged when the counters are read.
+ */
+class Counters
+{
+public:
+#ifdef CURA_PERFORMANCE_COUNTERS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    static constexpr size_t counter_count = static_cast<size_t>(Counter::COUNT);
+    static constexpr size_t histogram_count = static_cast<size_t>(Histogram::COUNT);
+
+    /*!
+     * Bucket 0 holds the value 0, bucket i holds the values from 2^(i-1) up to
+     * 2^i and the last bucket holds everything that's larger.
+     */
+    static constexpr size_t bucket_count = 33;
+
+    /*!
+     * The merged values of all shards at one point in time.
+     */
+    struct Snapshot
+    {
+        struct HistogramData
+        {
+            uint64_t count{ 0 };
+            uint64_t sum{ 0 };
+            std::array<uint64_t, bucket_count> buckets{};
+        };
+
+        std::array<uint64_t, counter_count> counters{};
+        std::array<HistogramData, histogram_count> histograms{};
+
+        uint64_t operator[](const Counter counter) const
+        {
+            return counters[static_cast<size_t>(counter)];
+        }
+
+        const HistogramData& operator[](const Histogram histogram) const
+        {
+            return histograms[static_cast<size_t>(histogram)];
+        }
+
+        Snapshot& operator+=(const Snapshot& other);
+
+        /*!
+         * Write the counters and the non-empty buckets of the histograms as a
+         * JSON object.
+         */
+        void writeJson(std::ostream& out) const;
+    };
+
+    /*!
+     * Increase a counter of the current thread.
+     */
+    static void add([[maybe_unused]] const Counter counter, [[maybe_unused]] const uint64_t amount = 1)
+    {
+        if constexpr (enabled)
+        {
+            std::atomic<uint64_t>& value = localShard().counters[static_cast<size_t>(counter)];
+            value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed); // Only this thread writes it.
+        }
+    }
+
+    /*!
+     * Add a value to a histogram of the current thread.
+     */
+    static void record([[maybe_unused]] const Histogram histogram, [[maybe_unused]] const uint64_t value)
+    {
+        if constexpr (enabled)
+        {
+            HistogramShard& shard = localShard().histograms[static_cast<size_t>(histogram)];
+            const auto increase = [](std::atomic<uint64_t>& field, const uint64_t amount)
+            {
+                field.store(field.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+            };
+            increase(shard.count, 1);
+            increase(shard.sum, value);
+            increase(shard.buckets[bucket(value)], 1);
+        }
+    }
+
+    /*!
+     * The histogram bucket that \p value falls in.
+     */
+    static constexpr size_t bucket(const uint64_t value)
+    {
+        const size_t width = static_cast<size_t>(std::bit_width(value));
+        return width < bucket_count ? width : bucket_count - 1;
+    }
+
+    /*!
+     * The name of a counter as it appears in the JSON output.
+     */
+    static std::string_view name(Counter counter);
+    static std::string_view name(Histogram histogram);
+
+    /*!
+     * Merge the shards of all threads.
+     *
+     * The result is only exact if no other thread is counting at the same
+     * time.
+     */
+    static Snapshot snapshot();
+
+    /*!
+     * Set all counters of all threads back to zero.
+     *
+     * This must only be called when no other thread is counting.
+     */
+    static void reset();
+
+    /*!
+     * Write the counters to \p output_file when \ref write is called.
+     */
+    static void setOutputFile(const std::filesystem::path& output_file);
+
+    /*!
+     * Write a snapshot to the output file, if counters are enabled and an
+     * output file was set.
+     */
+    static void write();
+
+private:
+    struct HistogramShard
+    {
+        std::atomic<uint64_t> count{ 0 };
+        std::atomic<uint64_t> sum{ 0 };
+        std::array<std::atomic<uint64_t>, bucket_count> buckets{};
+    };
+
+    /*!
+     * The counters of one thread. Only that thread writes to it, but the
+     * values are atomic so that they can be read while it's counting.
+     */
+    struct Shard
+    {
+        std::array<std::atomic<uint64_t>, counter_count> counters{};
+        std::array<HistogramShard, histogram_count> histograms{};
+    };
+
+    static Shard& localShard()
+    {
+        thread_local Shard* shard = registerShard();
+        return *shard;
+    }
+
+    /*!
+     * Create a shard for the current thread, which lives until the end of the
+     * program so that the counts of threads that ended are kept.
+     */
+    static Shard* registerShard();
+
+    struct State;
+    static State& state();
+};
+
+} // namespace cura
+
+#endif // UTILS_COUNTERS_H
@@ -0,0 +1,315 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_FLAT_GRID_MAP_H
+#define UTILS_FLAT_GRID_MAP_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Point2LL.h"
+
+namespace cura
+{
+
+/*!
+ * Cache-friendly multimap from grid cells to elements, used as storage for the
+ * \ref SparseGrid.
+ *
+ * Cells are kept in an open-addressing (linear probing) hash table. Elements
+ * are stored in a single flat vector, in one of two layouts:
+ *  - While the grid is being filled incrementally, each cell holds a chain of
+ *    element indices through a parallel ``next_`` array, so inserting is
+ *    amortized O(1) and never allocates a node per element. New elements are
+ *    put at the front of the chain of their cell.
+ *  - After \ref compact() has been called, the elements of every cell are
+ *    stored contiguously (CSR layout), so visiting a cell is a linear scan over
+ *    adjacent memory. Inserting again after compaction is allowed; the map
+ *    then silently reverts to the chained layout.
+ *
+ * Within a cell, elements are visited from the most recently inserted one to
+ * the oldest one. This is the order in which the std::unordered_multimap that
+ * used to back the grid visited them, and users that keep the first of several
+ * equally good elements depend on it.
+ *
+ * \tparam ElemT The element type to store.
+ */
+template<class ElemT>
+class FlatGridMap
+{
+public:
+    using GridPoint = Point2LL;
+    using value_type = std::pair<GridPoint, ElemT>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    /*!
+     * \param max_load_factor The maximum ratio of occupied cells to hash slots
+     * before the table grows. Clamped to a range where linear probing stays
+     * fast.
+     */
+    explicit FlatGridMap(double max_load_factor = 0.5)
+    {
+        setMaxLoadFactor(max_load_factor);
+    }
+
+    void setMaxLoadFactor(double max_load_factor)
+    {
+        max_load_factor_ = std::clamp(max_load_factor, 0.25, 0.75);
+    }
+
+    /*!
+     * Reserve space for a number of elements.
+     *
+     * The hash table is sized as if every element would land in its own cell,
+     * which is the worst case.
+     */
+    void reserve(size_t elem_count)
+    {
+        elems_.reserve(elem_count);
+        next_.reserve(elem_count);
+        const size_t required_slots = static_cast<size_t>(static_cast<double>(elem_count) / max_load_factor_) + 1;
+        if (required_slots > slots_.size())
+        {
+            rehash(required_slots);
+        }
+    }
+
+    /*!
+     * Add an element to a cell.
+     */
+    void emplace(const GridPoint& grid_pt, const ElemT& elem)
+    {
+        assert(elems_.size() < static_cast<size_t>(NONE));
+        if (compacted_)
+        {
+            uncompact();
+        }
+        if (static_cast<double>(cell_count_ + 1) > static_cast<double>(slots_.size()) * max_load_factor_)
+        {
+            rehash(std::max(size_t(16), slots_.size() * 2));
+        }
+
+        const auto elem_idx = static_cast<uint32_t>(elems_.size());
+        elems_.emplace_back(grid_pt, elem);
+        next_.push_back(NONE);
+
+        Cell& cell = slots_[findSlot(grid_pt)];
+        if (cell.count == 0)
+        {
+            cell.key = grid_pt;
+            cell_count_++;
+        }
+        next_[elem_idx] = cell.first;
+        cell.first = elem_idx;
+        cell.count++;
+    }
+
+    /*!
+     * Call \p visit for every element in the cell at \p grid_pt, from the most
+     * recently inserted one to the oldest one, until it returns ``false``.
+     *
+     * \return Whether to continue processing after this cell, i.e. ``false``
+     * if \p visit requested to stop.
+     */
+    template<typename Visitor>
+    bool visitCell(const GridPoint& grid_pt, Visitor&& visit) const
+    {
+        if (cell_count_ == 0)
+        {
+            return true;
+        }
+        const Cell& cell = slots_[findSlot(grid_pt)];
+        if (cell.count == 0)
+        {
+            return true;
+        }
+        if (compacted_)
+        {
+            const uint32_t end = cell.first + cell.count;
+            for (uint32_t elem_idx = cell.first; elem_idx < end; ++elem_idx)
+            {
+                if (! visit(elems_[elem_idx].second))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        for (uint32_t elem_idx = cell.first; elem_idx != NONE; elem_idx = next_[elem_idx])
+        {
+            if (! visit(elems_[elem_idx].second))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*!
+     * Reorder the elements so that each cell is stored contiguously.
+     *
+     * Call this after a grid has been bulk-built and before it is queried.
+     * Iteration order over the whole map changes, but the order within each
+     * cell is preserved.
+     */
+    void compact()
+    {
+        if (compacted_)
+        {
+            return;
+        }
+        std::vector<value_type> sorted;
+        sorted.reserve(elems_.size());
+        for (Cell& cell : slots_)
+        {
+            if (cell.count == 0)
+            {
+                continue;
+            }
+            const auto first = static_cast<uint32_t>(sorted.size());
+            for (uint32_t elem_idx = cell.first; elem_idx != NONE; elem_idx = next_[elem_idx])
+            {
+                sorted.push_back(std::move(elems_[elem_idx]));
+            }
+            cell.first = first;
+        }
+        elems_ = std::move(sorted);
+        next_.clear();
+        next_.shrink_to_fit();
+        compacted_ = true;
+    }
+
+    size_t size() const
+    {
+        return elems_.size();
+    }
+
+    bool empty() const
+    {
+        return elems_.empty();
+    }
+
+    void clear()
+    {
+        elems_.clear();
+        next_.clear();
+        std::fill(slots_.begin(), slots_.end(), Cell{});
+        cell_count_ = 0;
+        compacted_ = false;
+    }
+
+    iterator begin()
+    {
+        return elems_.begin();
+    }
+
+    iterator end()
+    {
+        return elems_.end();
+    }
+
+    const_iterator begin() const
+    {
+        return elems_.begin();
+    }
+
+    const_iterator end() const
+    {
+        return elems_.end();
+    }
+
+private:
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    /*!
+     * A slot in the hash table. A slot is free when its count is zero.
+     */
+    struct Cell
+    {
+        GridPoint key{};
+        uint32_t first = NONE; //!< Index of the first element of this cell to visit, which is the most recently inserted one.
+        uint32_t count = 0;
+    };
+
+    std::vector<Cell> slots_; //!< Hash table of cells. Its size is always zero or a power of two.
+    std::vector<value_type> elems_; //!< All elements, with the cell they are in.
+    std::vector<uint32_t> next_; //!< For each element, the next element in the same cell. Only used when not compacted.
+    size_t cell_count_ = 0; //!< The number of occupied slots.
+    double max_load_factor_ = 0.5;
+    bool compacted_ = false;
+
+    static size_t hash(const GridPoint& grid_pt)
+    {
+        uint64_t h = static_cast<uint64_t>(grid_pt.X) * 0x9E3779B97F4A7C15ULL;
+        h ^= static_cast<uint64_t>(grid_pt.Y) * 0xC2B2AE3D27D4EB4FULL;
+        h ^= h >> 31;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 29;
+        return static_cast<size_t>(h);
+    }
+
+    /*!
+     * Find the slot holding \p grid_pt, or the free slot where it should go.
+     *
+     * The table must not be empty, and must have at least one free slot.
+     */
+    size_t findSlot(const GridPoint& grid_pt) const
+    {
+        const size_t mask = slots_.size() - 1;
+        size_t slot_idx = hash(grid_pt) & mask;
+        while (slots_[slot_idx].count != 0 && slots_[slot_idx].key != grid_pt)
+        {
+            slot_idx = (slot_idx + 1) & mask;
+        }
+        return slot_idx;
+    }
+
+    void rehash(size_t min_slot_count)
+    {
+        size_t slot_count = 16;
+        while (slot_count < min_slot_count)
+        {
+            slot_count *= 2;
+        }
+        std::vector<Cell> old_slots(slot_count);
+        std::swap(old_slots, slots_);
+        for (const Cell& cell : old_slots)
+        {
+            if (cell.count != 0)
+            {
+                slots_[findSlot(cell.key)] = cell;
+            }
+        }
+    }
+
+    /*!
+     * Go back from the contiguous layout to the chained layout, so that more
+     * elements can be inserted.
+     */
+    void uncompact()
+    {
+        next_.assign(elems_.size(), NONE);
+        for (const Cell& cell : slots_)
+        {
+            if (cell.count == 0)
+            {
+                continue;
+            }
+            const uint32_t last = cell.first + cell.count - 1;
+            for (uint32_t elem_idx = cell.first; elem_idx < last; ++elem_idx)
+            {
+                next_[elem_idx] = elem_idx + 1;
+            }
+        }
+        compacted_ = false;
+    }
+};
+
+} // namespace cura
+
+#endif // UTILS_FLAT_GRID_MAP_H
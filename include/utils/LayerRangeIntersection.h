@@ -0,0 +1,59 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_LAYER_RANGE_INTERSECTION_H
+#define UTILS_LAYER_RANGE_INTERSECTION_H
+
+#include <cstddef>
+#include <vector>
+
+#include "polygon.h"
+
+namespace cura
+{
+
+/*!
+ * Sparse table of the intersections of per-layer areas over ranges of
+ * consecutive layers, up to a maximum range length.
+ *
+ * Entry ``k`` of layer ``i`` holds the intersection of the areas of layers
+ * ``i`` up to ``i + 2^k - 1``. Since intersecting a shape with itself doesn't
+ * change it, any range of at most the maximum length is covered by two
+ * (possibly overlapping) entries, so a query costs a single intersection
+ * instead of one per layer in the range.
+ *
+ * Building the table costs one intersection per layer per level, and there
+ * are ``log2(max_range_length) + 1`` levels.
+ */
+class LayerRangeIntersection
+{
+public:
+    /*!
+     * Build the table.
+     *
+     * \param layer_areas The area of every layer.
+     * \param max_range_length The longest range that will be queried.
+     */
+    LayerRangeIntersection(std::vector<Polygons> layer_areas, size_t max_range_length);
+
+    /*!
+     * Get the intersection of the areas of layers \p first up to and including
+     * \p last.
+     *
+     * Layers beyond the end of the table count as empty. The range may not be
+     * longer than the maximum range length the table was built for.
+     */
+    Polygons query(size_t first, size_t last) const;
+
+    /*!
+     * The number of layers in the table.
+     */
+    size_t size() const;
+
+private:
+    std::vector<std::vector<Polygons>> levels_; //!< For every level k, the intersection of 2^k layers starting at each layer.
+};
+
+} // namespace cura
+
+#endif // UTILS_LAYER_RANGE_INTERSECTION_H
@@ -0,0 +1,86 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_POLYGON_CODEC_H
+#define UTILS_POLYGON_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "utils/Point2LL.h"
+#include "utils/polygon.h"
+
+namespace cura
+{
+
+/*!
+ * Writes geometry to a byte buffer in a compact binary encoding.
+ *
+ * Integers are written as variable-length integers of 7 bits per byte, with
+ * signed integers zigzag-encoded first so that small negative numbers stay
+ * small. Every point is written as the difference to the point written before
+ * it. Since consecutive vertices of a polygon tend to lie close together, most
+ * coordinates take one or two bytes instead of eight.
+ *
+ * The result can only be read back with a \ref PolygonDecoder that reads the
+ * same values in the same order.
+ */
+class PolygonEncoder
+{
+public:
+    explicit PolygonEncoder(std::vector<uint8_t>& buffer);
+
+    void writeUnsigned(uint64_t value);
+    void writeSigned(int64_t value);
+
+    /*!
+     * Write a point, relative to the previously written point.
+     */
+    void writePoint(const Point2LL& point);
+
+    void writePolygons(const Polygons& polygons);
+
+    /*!
+     * How many points were written, to compare the encoded size with the size
+     * of the points themselves.
+     */
+    size_t pointCount() const;
+
+private:
+    std::vector<uint8_t>& buffer_;
+    Point2LL previous_point_{ 0, 0 };
+    size_t point_count_{ 0 };
+};
+
+/*!
+ * Reads geometry that was written by a \ref PolygonEncoder.
+ *
+ * Reading past the end of the data is a programming error, since the decoder
+ * is only meant for data that this engine wrote itself.
+ */
+class PolygonDecoder
+{
+public:
+    explicit PolygonDecoder(std::span<const uint8_t> data);
+
+    uint64_t readUnsigned();
+    int64_t readSigned();
+    Point2LL readPoint();
+    Polygons readPolygons();
+
+    /*!
+     * Whether all data has been read.
+     */
+    bool atEnd() const;
+
+private:
+    std::span<const uint8_t> data_;
+    size_t position_{ 0 };
+    Point2LL previous_point_{ 0, 0 };
+};
+
+} // namespace cura
+
+#endif // UTILS_POLYGON_CODEC_H
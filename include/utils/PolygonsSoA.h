@@ -0,0 +1,114 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_POLYGONS_SOA_H
+#define UTILS_POLYGONS_SOA_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Coord_t.h"
+#include "Point2LL.h"
+
+namespace cura
+{
+
+class Polygons;
+
+/*!
+ * Read-only structure-of-arrays view on a set of polygons, for answering the
+ * same kind of query many times against the same (large) shape.
+ *
+ * The polygons are flattened into their edges, with the start and end
+ * coordinates of all edges in separate x/y arrays. The queries on this view
+ * then run over these arrays with AVX2 (x86-64) or NEON (AArch64) kernels,
+ * selected at runtime, or with plain scalar code on CPUs without them.
+ *
+ * Flattening costs a copy of all vertices, which only pays off for large
+ * polygons that get queried repeatedly. For small shapes the view does not
+ * copy anything and delegates to the regular \ref Polygons functions instead,
+ * so it's always safe to use. Either way, the source polygons must outlive the
+ * view and must not be modified while it is in use.
+ *
+ * The answers are identical to those of the corresponding \ref Polygons
+ * functions.
+ */
+class PolygonsSoA
+{
+public:
+    /*!
+     * Below this number of vertices, the view delegates to the polygons
+     * directly instead of flattening them.
+     */
+    static constexpr size_t MIN_VERTICES_FOR_VIEW = 64;
+
+    /*!
+     * Create a view on \p polygons. The coordinate arrays are only built if
+     * the polygons have at least \p min_vertices vertices.
+     */
+    explicit PolygonsSoA(const Polygons& polygons, size_t min_vertices = MIN_VERTICES_FOR_VIEW);
+
+    /*!
+     * Whether the coordinate arrays were built, or this view just delegates to
+     * the source polygons.
+     */
+    bool isFlattened() const;
+
+    /*!
+     * Whether the current CPU can run the vectorized kernels.
+     */
+    static bool isSimdAvailable();
+
+    /*!
+     * Same as \ref Polygons::inside.
+     *
+     * \param p The point to test.
+     * \param border_result What to return when the point is exactly on the
+     * border.
+     */
+    bool inside(Point2LL p, bool border_result = false) const;
+
+    /*!
+     * Bounding box of all vertices.
+     *
+     * The minimum is ``(POINT_MAX, POINT_MAX)`` and the maximum is
+     * ``(POINT_MIN, POINT_MIN)`` if there are no vertices.
+     */
+    Point2LL min() const;
+    Point2LL max() const;
+
+    /*!
+     * Compute the bounding box of a series of points with the vectorized
+     * kernels. This works directly on the point array, without building a
+     * view.
+     *
+     * \param points The start of the point array.
+     * \param count The number of points.
+     * \param[in,out] min Gets lowered to the minimum of the points.
+     * \param[in,out] max Gets raised to the maximum of the points.
+     */
+    static void boundingBox(const Point2LL* points, size_t count, Point2LL& min, Point2LL& max);
+
+private:
+    const Polygons& source_; //!< The polygons this is a view on.
+    bool flattened_ = false; //!< Whether the arrays below are filled in.
+
+    /*!
+     * Whether all coordinates are small enough for the kernels that convert
+     * coordinate differences to doubles by bit manipulation.
+     */
+    bool coordinates_in_simd_range_ = false;
+
+    // Start and end of each edge. Edges of polygons with fewer than three vertices are not included, just like ClipperLib::PointInPolygon ignores them.
+    std::vector<coord_t> x0_;
+    std::vector<coord_t> y0_;
+    std::vector<coord_t> x1_;
+    std::vector<coord_t> y1_;
+
+    Point2LL min_;
+    Point2LL max_;
+};
+
+} // namespace cura
+
+#endif // UTILS_POLYGONS_SOA_H
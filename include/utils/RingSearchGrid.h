@@ -0,0 +1,158 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_RING_SEARCH_GRID_H
+#define UTILS_RING_SEARCH_GRID_H
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/Point2LL.h"
+#include "utils/SquareGrid.h"
+
+namespace cura
+{
+
+/*!
+ * \brief Grid of points that can be searched from near to far, with removal.
+ *
+ * Cells are visited in square rings around the query point, from the inside
+ * out. All points in a ring are at least a known distance away from the query
+ * point, so a nearest neighbour search can stop as soon as that distance
+ * exceeds the best candidate found so far, however sparse the grid is around
+ * the query point.
+ *
+ * Elements can be dropped while they are visited, so that a search that is
+ * repeated while elements get used up, such as a greedy tour, only keeps
+ * visiting the elements that are still available.
+ *
+ * \tparam Val The type of the values stored with the points.
+ */
+template<class Val>
+class RingSearchGrid : public SquareGrid
+{
+public:
+    struct Elem
+    {
+        Point2LL point;
+        Val val;
+    };
+
+    /*!
+     * \param cell_size The size of a cell. Searches are fastest if there are
+     * about as many cells as points.
+     */
+    explicit RingSearchGrid(const coord_t cell_size)
+        : SquareGrid(cell_size)
+    {
+    }
+
+    void insert(const Point2LL& point, const Val& val)
+    {
+        const GridPoint cell = toGridPoint(point);
+        if (cells_.empty())
+        {
+            min_cell_ = cell;
+            max_cell_ = cell;
+        }
+        else
+        {
+            min_cell_ = Point2LL(std::min(min_cell_.X, cell.X), std::min(min_cell_.Y, cell.Y));
+            max_cell_ = Point2LL(std::max(max_cell_.X, cell.X), std::max(max_cell_.Y, cell.Y));
+        }
+        cells_[cell].push_back(Elem{ point, val });
+    }
+
+    bool empty() const
+    {
+        return cells_.empty();
+    }
+
+    /*!
+     * \brief Visit the elements ring by ring around \p query_pt.
+     *
+     * \param query_pt The point to search around.
+     * \param continue_func Called before each ring with the squared distance
+     * that all elements in that ring and all rings after it are at least away
+     * from \p query_pt. Return ``false`` to stop searching.
+     * \param process_func Called with each element in the ring. Return whether
+     * to keep the element in the grid.
+     */
+    template<typename ContinueFunc, typename ProcessFunc>
+    void processByDistance(const Point2LL& query_pt, ContinueFunc&& continue_func, ProcessFunc&& process_func)
+    {
+        const GridPoint center = toGridPoint(query_pt);
+        for (grid_coord_t ring = 0;; ++ring)
+        {
+            // Past the bounds of the grid on all sides, there are no elements left to visit.
+            if (cells_.empty()
+                || (center.X - ring < min_cell_.X && center.X + ring > max_cell_.X && center.Y - ring < min_cell_.Y && center.Y + ring > max_cell_.Y))
+            {
+                return;
+            }
+            // A point in a cell of this ring is at least one cell less than the ring number away, since the query point may lie anywhere in the center cell.
+            const coord_t min_distance = std::max(grid_coord_t(0), ring - 1) * cell_size_;
+            if (! continue_func(min_distance * min_distance))
+            {
+                return;
+            }
+
+            const grid_coord_t min_x = std::max(center.X - ring, min_cell_.X);
+            const grid_coord_t max_x = std::min(center.X + ring, max_cell_.X);
+            const grid_coord_t min_y = std::max(center.Y - ring, min_cell_.Y);
+            const grid_coord_t max_y = std::min(center.Y + ring, max_cell_.Y);
+            for (grid_coord_t y = min_y; y <= max_y; ++y)
+            {
+                const bool is_edge_row = y == center.Y - ring || y == center.Y + ring;
+                for (grid_coord_t x = min_x; x <= max_x; ++x)
+                {
+                    if (! is_edge_row && x != center.X - ring && x != center.X + ring)
+                    {
+                        // Jump over the inside of the ring, which has been visited before.
+                        x = std::max(x, center.X + ring - 1);
+                        continue;
+                    }
+                    processCell(GridPoint(x, y), process_func);
+                }
+            }
+        }
+    }
+
+private:
+    template<typename ProcessFunc>
+    void processCell(const GridPoint& cell, ProcessFunc& process_func)
+    {
+        auto cell_it = cells_.find(cell);
+        if (cell_it == cells_.end())
+        {
+            return;
+        }
+        std::vector<Elem>& elems = cell_it->second;
+        for (size_t elem_idx = 0; elem_idx < elems.size();)
+        {
+            if (process_func(elems[elem_idx]))
+            {
+                ++elem_idx;
+            }
+            else
+            {
+                elems[elem_idx] = elems.back();
+                elems.pop_back();
+            }
+        }
+        if (elems.empty())
+        {
+            cells_.erase(cell_it);
+        }
+    }
+
+    std::unordered_map<GridPoint, std::vector<Elem>> cells_;
+    GridPoint min_cell_; //!< The lowest cell that ever held an element.
+    GridPoint max_cell_; //!< The highest cell that ever held an element.
+};
+
+} // namespace cura
+
+#endif // UTILS_RING_SEARCH_GRID_H
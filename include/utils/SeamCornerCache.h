@@ -0,0 +1,60 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_SEAM_CORNER_CACHE_H
+#define UTILS_SEAM_CORNER_CACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "utils/polygon.h"
+
+namespace cura
+{
+
+/*!
+ * Remembers the corner angles of the polygons that seams are placed on.
+ *
+ * Computing the corner angles of a polygon is the most expensive part of
+ * choosing its seam, and the same outlines come back over and over: on every
+ * layer of a prismatic part, for every copy of a part, and for every extruder
+ * plan that orders the same walls. The angles only depend on the shape of a
+ * polygon, not on where it is, so polygons are identified by the offsets of
+ * their vertices to the first vertex.
+ *
+ * The cache is shared by all threads. It holds a bounded number of vertices
+ * and starts over when it is full.
+ */
+class SeamCornerCache
+{
+public:
+    using Angles = std::vector<double>;
+
+    /*!
+     * Polygons with fewer vertices than this are cheaper to compute the
+     * angles of than to look up.
+     */
+    static constexpr size_t min_vertex_count = 16;
+
+    /*!
+     * Get the corner angles of a polygon with the same shape as \p polygon,
+     * or compute them with \p compute_angles and remember them.
+     *
+     * \param polygon The polygon to get the corner angles of.
+     * \param compute_angles Computes the corner angles of \p polygon.
+     * \return The corner angles. These stay valid even if the cache is
+     * cleared.
+     */
+    static std::shared_ptr<const Angles> get(ConstPolygonRef polygon, const std::function<Angles()>& compute_angles);
+
+    /*!
+     * Forget all polygons, to free the memory they take.
+     */
+    static void clear();
+};
+
+} // namespace cura
+
+#endif // UTILS_SEAM_CORNER_CACHE_H
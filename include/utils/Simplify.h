@@ -4,6 +4,10 @@
 #ifndef UTILS_SIMPLIFY_H
 #define UTILS_SIMPLIFY_H
 
+#include <limits>
+#include <queue> //Priority queue to prioritise removing unimportant vertices.
+#include <vector>
+
 #include "../settings/Settings.h" //To load the parameters from a Settings object.
 #include "ExtrusionLine.h"
 #include "linearAlg2D.h" //To calculate line deviations and intersecting lines.
@@ -133,6 +137,63 @@ protected:
      */
     constexpr static coord_t min_resolution = 5; // 5 units, regardless of how big those are, to allow for rounding errors.
 
+    /*!
+     * The vertices of a polygonal chain that are not deleted yet, linked into a
+     * loop, so that the neighbours of a vertex are found without scanning past
+     * all the deleted vertices in between.
+     *
+     * The vertices are linked into a loop for polylines too. The endpoints of a
+     * polyline are never deleted, so the link between them is never followed.
+     */
+    class RemainingVertices
+    {
+    public:
+        /*!
+         * Start with all of \p size vertices.
+         */
+        explicit RemainingVertices(const size_t size);
+
+        bool isDeleted(const size_t index) const
+        {
+            return next_[index] == deleted;
+        }
+
+        /*!
+         * The index of the first vertex after a vertex that is not deleted.
+         * \param index The index of a vertex that is not deleted.
+         */
+        size_t next(const size_t index) const
+        {
+            return next_[index];
+        }
+
+        /*!
+         * The index of the last vertex before a vertex that is not deleted.
+         * \param index The index of a vertex that is not deleted.
+         */
+        size_t previous(const size_t index) const
+        {
+            return previous_[index];
+        }
+
+        /*!
+         * Delete a vertex, linking its neighbours to each other.
+         * \param index The index of a vertex that is not deleted.
+         */
+        void remove(const size_t index)
+        {
+            next_[previous_[index]] = next_[index];
+            previous_[next_[index]] = previous_[index];
+            next_[index] = deleted;
+        }
+
+    private:
+        constexpr static size_t deleted = std::numeric_limits<size_t>::max();
+
+        std::vector<size_t> previous_;
+        std::vector<size_t> next_; //!< Or \ref deleted for deleted vertices.
+    };
+
     template<typename Polygonal>
     bool detectSmall(const Polygonal& polygon, const coord_t& min_size) const
     {
@@ -174,28 +235,48 @@ protected:
             return polygon;
         }
 
-        std::vector<bool> to_delete(polygon.size(), false);
+        // Compute the importance of all vertices in one sweep. If none of them can be removed, as is the case for polygons that are sparse already or that were
+        // simplified before, the polygon is returned as is.
+        RemainingVertices remaining(polygon.size());
+        std::vector<std::pair<size_t, coord_t>> importances;
+        importances.reserve(polygon.size());
+        bool any_removable = false;
+        for (size_t i = 0; i < polygon.size(); ++i)
+        {
+            const coord_t vertex_importance = importance(polygon, remaining, i, is_closed);
+            any_removable |= vertex_importance <= max_deviation_ * max_deviation_;
+            importances.emplace_back(i, vertex_importance);
+        }
+        if (! any_removable)
+        {
+            return polygon;
+        }
+
         auto comparator = [](const std::pair<size_t, coord_t>& vertex_a, const std::pair<size_t, coord_t>& vertex_b)
         {
             return vertex_a.second > vertex_b.second || (vertex_a.second == vertex_b.second && vertex_a.first > vertex_b.first);
         };
-        std::priority_queue<std::pair<size_t, coord_t>, std::vector<std::pair<size_t, coord_t>>, decltype(comparator)> by_importance(comparator);
+        using ByImportance = std::priority_queue<std::pair<size_t, coord_t>, std::vector<std::pair<size_t, coord_t>>, decltype(comparator)>;
 
         Polygonal result = polygon; // Make a copy so that we can also shift vertices.
         for (int64_t current_removed = -1; (polygon.size() - current_removed) > min_size && current_removed != 0;)
         {
             current_removed = 0;
 
-            // Add the initial points.
-            for (size_t i = 0; i < result.size(); ++i)
+            // Add the initial points. The importance of all of them is known already in the first pass.
+            if (importances.empty())
             {
-                if (to_delete[i])
+                for (size_t i = 0; i < result.size(); ++i)
                 {
-                    continue;
+                    if (remaining.isDeleted(i))
+                    {
+                        continue;
+                    }
+                    importances.emplace_back(i, importance(result, remaining, i, is_closed));
                 }
-                const coord_t vertex_importance = importance(result, to_delete, i, is_closed);
-                by_importance.emplace(i, vertex_importance);
             }
+            ByImportance by_importance(comparator, std::move(importances)); // Builds the heap in linear time.
+            importances.clear();
 
             // Iteratively remove the least important point until a threshold.
             coord_t vertex_importance = 0;
@@ -205,7 +286,7 @@ protected:
                 by_importance.pop();
                 // The importance may have changed since this vertex was inserted. Re-compute it now.
                 // If it doesn't change, it's safe to process.
-                vertex_importance = importance(result, to_delete, vertex.first, is_closed);
+                vertex_importance = importance(result, remaining, vertex.first, is_closed);
                 if (vertex_importance != vertex.second)
                 {
                     by_importance.emplace(vertex.first, vertex_importance); // Re-insert with updated importance.
@@ -214,7 +295,7 @@ protected:
 
                 if (vertex_importance <= max_deviation_ * max_deviation_)
                 {
-                    current_removed += remove(result, to_delete, vertex.first, vertex_importance, is_closed) ? 1 : 0;
+                    current_removed += remove(result, remaining, vertex.first, vertex_importance, is_closed) ? 1 : 0;
                 }
             }
         }
@@ -223,7 +304,7 @@ protected:
         Polygonal filtered = createEmpty(polygon);
         for (size_t i = 0; i < result.size(); ++i)
         {
-            if (! to_delete[i])
+            if (! remaining.isDeleted(i))
             {
                 appendVertex(filtered, result[i]);
             }
@@ -240,7 +321,7 @@ protected:
      * A measure of the importance of a vertex.
      * \tparam Polygonal A polygonal object, which is a list of vertices.
      * \param polygon The polygon or polyline the vertex is part of.
-     * \param to_delete For each vertex, whether it is set to be deleted.
+     * \param remaining The vertices that are not deleted yet.
      * \param index The vertex index to compute the importance of.
      * \param is_closed Whether the polygon is closed (a polygon) or open
      * (a polyline).
@@ -248,7 +329,7 @@ protected:
      * that the vertex should probably be retained in the output.
      */
     template<typename Polygonal>
-    coord_t importance(const Polygonal& polygon, const std::vector<bool>& to_delete, const size_t index, const bool is_closed) const
+    coord_t importance(const Polygonal& polygon, const RemainingVertices& remaining, const size_t index, const bool is_closed) const
     {
         const size_t poly_size = polygon.size();
         if (! is_closed && (index == 0 || index == poly_size - 1))
@@ -258,8 +339,8 @@ protected:
         // From here on out we can safely look at the vertex neighbors and assume it's a polygon. We won't go out of bounds of the polyline.
 
         const Point2LL& vertex = getPosition(polygon[index]);
-        const size_t before_index = previousNotDeleted(index, to_delete);
-        const size_t after_index = nextNotDeleted(index, to_delete);
+        const size_t before_index = remaining.previous(index);
+        const size_t after_index = remaining.next(index);
 
         const coord_t area_deviation = getAreaDeviation(polygon[before_index], polygon[index], polygon[after_index]);
         if (area_deviation > max_area_deviation_) // Removing this line causes the variable line width to get flattened out too much.
@@ -289,8 +370,8 @@ protected:
      * to delete an edge, fusing two vertices together.
      * \tparam Polygonal A polygonal object, which is a list of vertices.
      * \param polygon The polygon to remove a vertex from.
-     * \param to_delete The vertices that have been marked for deletion so far.
-     * This will be edited in-place.
+     * \param remaining The vertices that are not deleted yet. This will be
+     * edited in-place.
      * \param vertex The index of the vertex to remove.
      * \param deviation2 The previously found deviation for this vertex.
      * \param is_closed Whether we're working on a closed polygon or an open
@@ -298,18 +379,18 @@ protected:
      * polyline.
      */
     template<typename Polygonal>
-    bool remove(Polygonal& polygon, std::vector<bool>& to_delete, const size_t vertex, const coord_t deviation2, const bool is_closed) const
+    bool remove(Polygonal& polygon, RemainingVertices& remaining, const size_t vertex, const coord_t deviation2, const bool is_closed) const
     {
         if (deviation2 <= min_resolution * min_resolution)
         {
             // At less than the minimum resolution we're always allowed to delete the vertex.
             // Even if the adjacent line segments are very long.
-            to_delete[vertex] = true;
+            remaining.remove(vertex);
             return true;
         }
 
-        const size_t before = previousNotDeleted(vertex, to_delete);
-        const size_t after = nextNotDeleted(vertex, to_delete);
+        const size_t before = remaining.previous(vertex);
+        const size_t after = remaining.next(vertex);
         const Point2LL& vertex_position = getPosition(polygon[vertex]);
         const Point2LL& before_position = getPosition(polygon[before]);
         const Point2LL& after_position = getPosition(polygon[after]);
@@ -319,7 +400,7 @@ protected:
         if (length2_before <= max_resolution_ * max_resolution_ && length2_after <= max_resolution_ * max_resolution_) // Both adjacent line segments are short.
         {
             // Removing this vertex does little harm. No long lines will be shifted.
-            to_delete[vertex] = true;
+            remaining.remove(vertex);
             return true;
         }
 
@@ -333,7 +414,7 @@ protected:
             {
                 return false; // Edge cannot be deleted without shifting a long edge. Don't remove anything.
             }
-            const size_t before_before = previousNotDeleted(before, to_delete);
+            const size_t before_before = remaining.previous(before);
             before_from = getPosition(polygon[before_before]);
             before_to = getPosition(polygon[before]);
             after_from = getPosition(polygon[vertex]);
@@ -345,7 +426,7 @@ protected:
             {
                 return false; // Edge cannot be deleted without shifting a long edge. Don't remove anything.
             }
-            const size_t after_after = nextNotDeleted(after, to_delete);
+            const size_t after_after = remaining.next(after);
             before_from = getPosition(polygon[before]);
             before_to = getPosition(polygon[vertex]);
             after_from = getPosition(polygon[after]);
@@ -360,39 +441,13 @@ protected:
         const coord_t intersection_deviation = LinearAlg2D::getDist2FromLineSegment(before_to, intersection, after_from);
         if (intersection_deviation <= max_deviation_ * max_deviation_) // Intersection point doesn't deviate too much. Use it!
         {
-            to_delete[vertex] = true;
+            remaining.remove(vertex);
             polygon[length2_before <= length2_after ? before : after] = createIntersection(polygon[before], intersection, polygon[after]);
             return true;
         }
         return false;
     }
 
-    /*!
-     * Helper method to find the index of the next vertex that is not about to
-     * get deleted.
-     *
-     * This method assumes that the polygon is looping. If it is a polyline, the
-     * endpoints of the polyline may never be deleted so it should never be an
-     * issue.
-     * \param index The index of the current vertex.
-     * \param to_delete For each vertex, whether it is to be deleted.
-     * \return The index of the vertex afterwards.
-     */
-    size_t nextNotDeleted(size_t index, const std::vector<bool>& to_delete) const;
-
-    /*!
-     * Helper method to find the index of the previous vertex that is not about
-     * to get deleted.
-     *
-     * This method assumes that the polygon is looping. If it is a polyline, the
-     * endpoints of the polyline may never be deleted so it should never be an
-     * issue.
-     * \param index The index of the current vertex.
-     * \param to_delete For each vertex, whether it is to be deleted.
-     * \return The index of the vertex before it.
-     */
-    size_t previousNotDeleted(size_t index, const std::vector<bool>& to_delete) const;
-
     /*!
      * Create an empty polygon with the same properties as an original polygon,
      * but without the vertex data.
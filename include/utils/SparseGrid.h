@@ -7,9 +7,9 @@
 
 #include <cassert>
 #include <functional>
-#include <unordered_map>
 #include <vector>
 
+#include "FlatGridMap.h"
 #include "Point2LL.h"
 #include "SquareGrid.h"
 
@@ -31,7 +31,7 @@ public:
 
     using GridPoint = SquareGrid::GridPoint;
     using grid_coord_t = SquareGrid::grid_coord_t;
-    using GridMap = std::unordered_multimap<GridPoint, Elem>;
+    using GridMap = FlatGridMap<Elem>;
 
     using iterator = typename GridMap::iterator;
     using const_iterator = typename GridMap::const_iterator;
@@ -41,9 +41,25 @@ public:
      * \param[in] cell_size The size to use for a cell (square) in the grid.
      *    Typical values would be around 0.5-2x of expected query radius.
      * \param[in] elem_reserve Number of elements to research space for.
-     * \param[in] max_load_factor Maximum average load factor before rehashing.
+     * \param[in] max_load_factor Maximum ratio of occupied cells to hash slots
+     *    before rehashing. See \ref FlatGridMap.
      */
-    SparseGrid(coord_t cell_size, size_t elem_reserve = 0U, double max_load_factor = 1.0);
+    SparseGrid(coord_t cell_size, size_t elem_reserve = 0U, double max_load_factor = 0.5);
+
+    /*! \brief Store the elements of every cell contiguously.
+     *
+     * Call this when the grid has been filled in bulk and is about to be
+     * queried a lot. Inserting afterwards is still allowed.
+     */
+    void compact()
+    {
+        grid_.compact();
+    }
+
+    size_t size() const
+    {
+        return grid_.size();
+    }
 
     iterator begin()
     {
@@ -94,7 +110,8 @@ public:
      *    to be considered for output
      * \return True if and only if an object has been found within the radius.
      */
-    bool getNearest(const Point2LL& query_pt, coord_t radius, Elem& elem_nearest, const std::function<bool(const Elem& elem)> precondition = no_precondition) const;
+    template<typename Precondition = std::function<bool(const Elem&)>>
+    bool getNearest(const Point2LL& query_pt, coord_t radius, Elem& elem_nearest, const Precondition& precondition = no_precondition) const;
 
     /*! \brief Process elements from cells that might contain sought after points.
      *
@@ -109,7 +126,8 @@ public:
      *    called for each element in the cell. Processing stops if function returns false.
      * \return Whether we need to continue processing after this function
      */
-    bool processNearby(const Point2LL& query_pt, coord_t radius, const std::function<bool(const ElemT&)>& process_func) const;
+    template<typename ProcessFunc>
+    bool processNearby(const Point2LL& query_pt, coord_t radius, ProcessFunc&& process_func) const;
 
     /*! \brief Process elements from cells that might contain sought after points along a line.
      *
@@ -121,7 +139,8 @@ public:
      *    called for each element in the cells. Processing stops if function returns false.
      * \return Whether we need to continue processing after this function
      */
-    bool processLine(const std::pair<Point2LL, Point2LL> query_line, const std::function<bool(const Elem&)>& process_elem_func) const;
+    template<typename ProcessFunc>
+    bool processLine(const std::pair<Point2LL, Point2LL> query_line, ProcessFunc&& process_elem_func) const;
 
 protected:
     /*! \brief Process elements from the cell indicated by \p grid_pt.
@@ -131,7 +150,8 @@ protected:
      *    called for each element in the cell. Processing stops if function returns false.
      * \return Whether we need to continue processing a next cell.
      */
-    bool processFromCell(const GridPoint& grid_pt, const std::function<bool(const Elem&)>& process_func) const;
+    template<typename ProcessFunc>
+    bool processFromCell(const GridPoint& grid_pt, ProcessFunc&& process_func) const;
 
     /*! \brief Map from grid locations (GridPoint) to elements (Elem). */
     GridMap grid_;
@@ -146,7 +166,7 @@ SGI_THIS::SparseGrid(coord_t cell_size, size_t elem_reserve, double max_load_fac
     : SquareGrid(cell_size)
 {
     // Must be before the reserve call.
-    grid_.max_load_factor(max_load_factor);
+    grid_.setMaxLoadFactor(max_load_factor);
     if (elem_reserve != 0U)
     {
         grid_.reserve(elem_reserve);
@@ -154,51 +174,56 @@ SGI_THIS::SparseGrid(coord_t cell_size, size_t elem_reserve, double max_load_fac
 }
 
 SGI_TEMPLATE
-bool SGI_THIS::processFromCell(const GridPoint& grid_pt, const std::function<bool(const Elem&)>& process_func) const
+template<typename ProcessFunc>
+bool SGI_THIS::processFromCell(const GridPoint& grid_pt, ProcessFunc&& process_func) const
 {
-    auto grid_range = grid_.equal_range(grid_pt);
-    for (auto iter = grid_range.first; iter != grid_range.second; ++iter)
+    return grid_.visitCell(grid_pt, process_func);
+}
+
+SGI_TEMPLATE
+template<typename ProcessFunc>
+bool SGI_THIS::processNearby(const Point2LL& query_pt, coord_t radius, ProcessFunc&& process_func) const
+{
+    // Same cell range as SquareGrid::processNearby, but without going through a std::function per cell.
+    const GridPoint min_grid = toGridPoint(Point2LL(query_pt.X - radius, query_pt.Y - radius));
+    const GridPoint max_grid = toGridPoint(Point2LL(query_pt.X + radius, query_pt.Y + radius));
+    for (grid_coord_t grid_y = min_grid.Y; grid_y <= max_grid.Y; ++grid_y)
     {
-        if (! process_func(iter->second))
+        for (grid_coord_t grid_x = min_grid.X; grid_x <= max_grid.X; ++grid_x)
         {
-            return false;
+            if (! processFromCell(GridPoint(grid_x, grid_y), process_func))
+            {
+                return false;
+            }
         }
     }
     return true;
 }
 
 SGI_TEMPLATE
-bool SGI_THIS::processNearby(const Point2LL& query_pt, coord_t radius, const std::function<bool(const Elem&)>& process_func) const
+template<typename ProcessFunc>
+bool SGI_THIS::processLine(const std::pair<Point2LL, Point2LL> query_line, ProcessFunc&& process_elem_func) const
 {
-    return SquareGrid::processNearby(
-        query_pt,
-        radius,
-        [&process_func, this](const GridPoint& grid_pt)
+    return processLineCells(
+        query_line,
+        [&process_elem_func, this](GridPoint grid_loc)
         {
-            return processFromCell(grid_pt, process_func);
+            return processFromCell(grid_loc, process_elem_func);
         });
 }
 
-SGI_TEMPLATE
-bool SGI_THIS::processLine(const std::pair<Point2LL, Point2LL> query_line, const std::function<bool(const Elem&)>& process_elem_func) const
-{
-    const std::function<bool(const GridPoint&)> process_cell_func = [&process_elem_func, this](GridPoint grid_loc)
-    {
-        return processFromCell(grid_loc, process_elem_func);
-    };
-    return processLineCells(query_line, process_cell_func);
-}
-
 SGI_TEMPLATE
 std::vector<typename SGI_THIS::Elem> SGI_THIS::getNearby(const Point2LL& query_pt, coord_t radius) const
 {
     std::vector<Elem> ret;
-    const std::function<bool(const Elem&)> process_func = [&ret](const Elem& elem)
-    {
-        ret.push_back(elem);
-        return true;
-    };
-    processNearby(query_pt, radius, process_func);
+    processNearby(
+        query_pt,
+        radius,
+        [&ret](const Elem& elem)
+        {
+            ret.push_back(elem);
+            return true;
+        });
     return ret;
 }
 
@@ -209,11 +234,12 @@ const std::function<bool(const typename SGI_THIS::Elem&)> SGI_THIS::no_precondit
 };
 
 SGI_TEMPLATE
-bool SGI_THIS::getNearest(const Point2LL& query_pt, coord_t radius, Elem& elem_nearest, const std::function<bool(const Elem& elem)> precondition) const
+template<typename Precondition>
+bool SGI_THIS::getNearest(const Point2LL& query_pt, coord_t radius, Elem& elem_nearest, const Precondition& precondition) const
 {
     bool found = false;
     int64_t best_dist2 = static_cast<int64_t>(radius) * radius;
-    const std::function<bool(const Elem&)> process_func = [&query_pt, &elem_nearest, &found, &best_dist2, &precondition](const Elem& elem)
+    const auto process_func = [&query_pt, &elem_nearest, &found, &best_dist2, &precondition](const Elem& elem)
     {
         if (! precondition(elem))
         {
@@ -36,9 +36,10 @@ public:
      * \param[in] cell_size The size to use for a cell (square) in the grid.
      *    Typical values would be around 0.5-2x of expected query radius.
      * \param[in] elem_reserve Number of elements to research space for.
-     * \param[in] max_load_factor Maximum average load factor before rehashing.
+     * \param[in] max_load_factor Maximum ratio of occupied cells to hash slots
+     *    before rehashing. See \ref FlatGridMap.
      */
-    SparseLineGrid(coord_t cell_size, size_t elem_reserve = 0U, double max_load_factor = 1.0);
+    SparseLineGrid(coord_t cell_size, size_t elem_reserve = 0U, double max_load_factor = 0.5);
 
     /*! \brief Inserts elem into the sparse grid.
      *
@@ -62,9 +62,10 @@ public:
      * \param[in] cell_size The size to use for a cell (square) in the grid.
      *    Typical values would be around 0.5-2x of expected query radius.
      * \param[in] elem_reserve Number of elements to research space for.
-     * \param[in] max_load_factor Maximum average load factor before rehashing.
+     * \param[in] max_load_factor Maximum ratio of occupied cells to hash slots
+     *    before rehashing. See \ref FlatGridMap.
      */
-    SparsePointGridInclusive(coord_t cell_size, size_t elem_reserve = 0U, double max_load_factor = 1.0);
+    SparsePointGridInclusive(coord_t cell_size, size_t elem_reserve = 0U, double max_load_factor = 0.5);
 
     /*! \brief Inserts an element with specified point and value into the sparse grid.
      *
@@ -109,12 +110,14 @@ SG_TEMPLATE
 std::vector<Val> SG_THIS::getNearbyVals(const Point2LL& query_pt, coord_t radius) const
 {
     std::vector<Val> ret;
-    std::function<bool(const SparsePointGridInclusiveImpl::SparsePointGridInclusiveElem<Val>&)> process_func = [&ret](const typename SG_THIS::Elem& elem)
-    {
-        ret.push_back(elem.val);
-        return true;
-    };
-    this->processNearby(query_pt, radius, process_func);
+    this->processNearby(
+        query_pt,
+        radius,
+        [&ret](const typename SG_THIS::Elem& elem)
+        {
+            ret.push_back(elem.val);
+            return true;
+        });
     return ret;
 }
 
@@ -0,0 +1,118 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#ifndef UTILS_TRACE_H
+#define UTILS_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <string_view>
+
+namespace cura
+{
+
+/*!
+ * Records where the engine spends its time, on which thread, for a whole run.
+ *
+ * Tracing is off unless it is enabled, typically with the ``--trace <file>``
+ * command line option. When it is off, a \ref TraceSpan costs one relaxed
+ * atomic load. When it is on, every thread appends its spans to a buffer of
+ * its own, without any locking. The buffers are written to a Chrome trace
+ * JSON file at the end of the run, which can be opened in Perfetto or in
+ * ``chrome://tracing`` to see which stages are on the critical path and when
+ * threads are idle.
+ */
+class Trace
+{
+public:
+    /*!
+     * Start recording spans, to be written to \p output_file.
+     */
+    static void enable(const std::filesystem::path& output_file);
+
+    static bool isEnabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * Write all recorded spans to the output file and stop recording.
+     *
+     * This must only be called when no other thread is recording spans any
+     * more, such as at the end of the run.
+     */
+    static void write();
+
+private:
+    friend class TraceSpan;
+
+    /*!
+     * Add a finished span to the buffer of the current thread.
+     */
+    static void record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end, int64_t layer_nr, std::string_view mesh);
+
+    static std::atomic<bool> enabled_;
+};
+
+/*!
+ * Records the time from its construction until its destruction as a span in
+ * the trace, if tracing is enabled.
+ *
+ * \code
+ * TraceSpan trace_span("processLayer", layer_nr);
+ * \endcode
+ */
+class TraceSpan
+{
+public:
+    static constexpr int64_t no_layer = std::numeric_limits<int64_t>::min();
+
+    /*!
+     * \param name The name of the stage. This is not copied, so it has to be
+     * a string literal or otherwise live until the trace is written.
+     * \param layer_nr The layer that is processed in this span, if any.
+     * \param mesh The name of the mesh that is processed in this span, if
+     * any. It is copied when the span ends.
+     */
+    explicit TraceSpan(const char* name, const int64_t layer_nr = no_layer, const std::string_view mesh = {})
+        : name_(name)
+        , layer_nr_(layer_nr)
+        , mesh_(mesh)
+    {
+        if (Trace::isEnabled())
+        {
+            start_ = std::chrono::steady_clock::now();
+            active_ = true;
+        }
+    }
+
+    TraceSpan(const char* name, const std::string_view mesh)
+        : TraceSpan(name, no_layer, mesh)
+    {
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    ~TraceSpan()
+    {
+        if (active_)
+        {
+            Trace::record(name_, start_, std::chrono::steady_clock::now(), layer_nr_, mesh_);
+        }
+    }
+
+private:
+    const char* name_;
+    int64_t layer_nr_;
+    std::string_view mesh_;
+    std::chrono::steady_clock::time_point start_;
+    bool active_ = false; //!< Whether tracing was enabled when this span started.
+};
+
+} // namespace cura
+
+#endif // UTILS_TRACE_H
@@ -11,12 +11,15 @@
 #include <initializer_list>
 #include <limits> // int64_t.min
 #include <list>
+#include <span>
 #include <polyclipping/clipper.hpp>
 #include <unordered_map>
 #include <vector>
 
 #include "../settings/types/Angle.h" //For angles between vertices.
 #include "../settings/types/Ratio.h"
+#include "ClipperPool.h"
+#include "Counters.h"
 #include "Point2LL.h"
 
 #define CHECK_POLY_ACCESS
@@ -1016,19 +1019,21 @@ public:
     Polygons difference(const Polygons& other) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.AddPaths(other.paths, ClipperLib::ptClip, true);
-        clipper.Execute(ClipperLib::ctDifference, ret.paths);
+        countBooleanOperation(paths, other.paths);
+        PooledClipperBoolean clipper;
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->AddPaths(other.paths, ClipperLib::ptClip, true);
+        clipper->Execute(ClipperLib::ctDifference, ret.paths);
         return ret;
     }
     Polygons unionPolygons(const Polygons& other, ClipperLib::PolyFillType fill_type = ClipperLib::pftNonZero) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.AddPaths(other.paths, ClipperLib::ptSubject, true);
-        clipper.Execute(ClipperLib::ctUnion, ret.paths, fill_type, fill_type);
+        countBooleanOperation(paths, other.paths);
+        PooledClipperBoolean clipper;
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->AddPaths(other.paths, ClipperLib::ptSubject, true);
+        clipper->Execute(ClipperLib::ctUnion, ret.paths, fill_type, fill_type);
         return ret;
     }
     /*!
@@ -1041,10 +1046,11 @@ public:
     Polygons intersection(const Polygons& other) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.AddPaths(other.paths, ClipperLib::ptClip, true);
-        clipper.Execute(ClipperLib::ctIntersection, ret.paths);
+        countBooleanOperation(paths, other.paths);
+        PooledClipperBoolean clipper;
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->AddPaths(other.paths, ClipperLib::ptClip, true);
+        clipper->Execute(ClipperLib::ctIntersection, ret.paths);
         return ret;
     }
 
@@ -1083,24 +1089,67 @@ public:
     Polygons xorPolygons(const Polygons& other, ClipperLib::PolyFillType pft = ClipperLib::pftEvenOdd) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.AddPaths(other.paths, ClipperLib::ptClip, true);
-        clipper.Execute(ClipperLib::ctXor, ret.paths, pft);
+        countBooleanOperation(paths, other.paths);
+        PooledClipperBoolean clipper;
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->AddPaths(other.paths, ClipperLib::ptClip, true);
+        clipper->Execute(ClipperLib::ctXor, ret.paths, pft);
         return ret;
     }
 
     Polygons execute(ClipperLib::PolyFillType pft = ClipperLib::pftEvenOdd) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.Execute(ClipperLib::ctXor, ret.paths, pft);
+        PooledClipperBoolean clipper;
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->Execute(ClipperLib::ctXor, ret.paths, pft);
         return ret;
     }
 
     Polygons offset(coord_t distance, ClipperLib::JoinType joinType = ClipperLib::jtMiter, double miter_limit = 1.2) const;
 
+    /*!
+     * Apply a series of offsets one after another, like
+     * ``offset(distances[0]).offset(distances[1])...``.
+     *
+     * The output of an offset is already a clean union, so unlike chaining
+     * \ref offset calls, the shape only gets unioned once before the first
+     * offset. The result is the same area, but vertices may start at a
+     * different position in the polygons.
+     *
+     * \param distances The offsets to apply, in order.
+     */
+    Polygons offsetSequence(const std::vector<coord_t>& distances, ClipperLib::JoinType join_type = ClipperLib::jtMiter, double miter_limit = 1.2) const;
+
+    /*!
+     * Morphological opening: shrink by \p distance and grow back, which
+     * removes parts thinner than twice the distance.
+     */
+    Polygons morphologicalOpen(coord_t distance, ClipperLib::JoinType join_type = ClipperLib::jtMiter, double miter_limit = 1.2) const
+    {
+        return offsetSequence({ -distance, distance }, join_type, miter_limit);
+    }
+
+    /*!
+     * Morphological closing: grow by \p distance and shrink back, which fills
+     * gaps narrower than twice the distance.
+     */
+    Polygons morphologicalClose(coord_t distance, ClipperLib::JoinType join_type = ClipperLib::jtMiter, double miter_limit = 1.2) const
+    {
+        return offsetSequence({ distance, -distance }, join_type, miter_limit);
+    }
+
+    /*!
+     * Offset this shape by each of several distances, each offset starting
+     * from the original shape. Equivalent to calling \ref offset for each
+     * distance, but the shape is only unioned and loaded into the offsetter
+     * once.
+     *
+     * \param distances The offset distances.
+     * \return One offsetted shape per distance, in the same order.
+     */
+    std::vector<Polygons> offsetMulti(const std::vector<coord_t>& distances, ClipperLib::JoinType join_type = ClipperLib::jtMiter, double miter_limit = 1.2) const;
+
     Polygons offsetPolyLine(int distance, ClipperLib::JoinType joinType = ClipperLib::jtMiter, bool inputPolyIsClosed = false) const
     {
         Polygons ret;
@@ -1118,10 +1167,10 @@ public:
         {
             end_type = ClipperLib::etOpenRound;
         }
-        ClipperLib::ClipperOffset clipper(miterLimit, 10.0);
-        clipper.AddPaths(paths, joinType, end_type);
-        clipper.MiterLimit = miterLimit;
-        clipper.Execute(ret.paths, distance);
+        countOffset(paths);
+        PooledClipperOffset clipper(miterLimit, 10.0);
+        clipper->AddPaths(paths, joinType, end_type);
+        clipper->Execute(ret.paths, distance);
         return ret;
     }
 
@@ -1291,6 +1340,46 @@ public:
     Polygons tubeShape(const coord_t inner_offset, const coord_t outer_offset) const;
 
 private:
+    /*!
+     * Count a boolean operation of \p subject and \p clip in the performance
+     * counters, if they are enabled.
+     */
+    static void countBooleanOperation([[maybe_unused]] std::span<const ClipperLib::Path> subject, [[maybe_unused]] std::span<const ClipperLib::Path> clip)
+    {
+        if constexpr (Counters::enabled)
+        {
+            const size_t vertex_count = countVertices(subject) + countVertices(clip);
+            Counters::add(Counter::CLIPPER_BOOLEAN_CALLS);
+            Counters::add(Counter::CLIPPER_BOOLEAN_VERTICES, vertex_count);
+            Counters::record(Histogram::CLIPPER_BOOLEAN_VERTICES, vertex_count);
+        }
+    }
+
+    /*!
+     * Count an offset of \p input in the performance counters, if they are
+     * enabled.
+     */
+    static void countOffset([[maybe_unused]] std::span<const ClipperLib::Path> input)
+    {
+        if constexpr (Counters::enabled)
+        {
+            const size_t vertex_count = countVertices(input);
+            Counters::add(Counter::CLIPPER_OFFSET_CALLS);
+            Counters::add(Counter::CLIPPER_OFFSET_VERTICES, vertex_count);
+            Counters::record(Histogram::CLIPPER_OFFSET_VERTICES, vertex_count);
+        }
+    }
+
+    static size_t countVertices(std::span<const ClipperLib::Path> input)
+    {
+        size_t vertex_count = 0;
+        for (const ClipperLib::Path& path : input)
+        {
+            vertex_count += path.size();
+        }
+        return vertex_count;
+    }
+
     /*!
      * recursive part of \ref Polygons::removeEmptyHoles and \ref Polygons::getEmptyHoles
      * \param node The node of the polygons part to process
@@ -1429,9 +1518,9 @@ public:
     Polygons processEvenOdd(ClipperLib::PolyFillType poly_fill_type = ClipperLib::PolyFillType::pftEvenOdd) const
     {
         Polygons ret;
-        ClipperLib::Clipper clipper(clipper_init);
-        clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-        clipper.Execute(ClipperLib::ctUnion, ret.paths, poly_fill_type);
+        PooledClipperBoolean clipper;
+        clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+        clipper->Execute(ClipperLib::ctUnion, ret.paths, poly_fill_type);
         return ret;
     }
 
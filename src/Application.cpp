@@ -6,6 +6,7 @@
 #include <chrono>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include <boost/uuid/random_generator.hpp> //For generating a UUID.
 #include <boost/uuid/uuid_io.hpp> //For generating a UUID.
@@ -19,11 +20,14 @@
 #include <spdlog/spdlog.h>
 
 #include "FffProcessor.h"
+#include "LayerSpill.h"
 #include "communication/ArcusCommunication.h" //To connect via Arcus to the front-end.
 #include "communication/CommandLine.h" //To use the command line to slice stuff.
 #include "plugins/slots.h"
 #include "progress/Progress.h"
+#include "utils/Counters.h"
 #include "utils/ThreadPool.h"
+#include "utils/Trace.h"
 #include "utils/string.h" //For stringcasecompare.
 
 namespace cura
@@ -144,6 +148,10 @@ void Application::printHelp() const
     fmt::print("CuraEngine slice [general settings] \n\t-g [current group settings] \n\t-e0 [extruder train 0 settings] \n\t-l obj_inheriting_from_last_extruder_train.stl [object "
                "settings] \n\t--next [next group settings]\n\t... etc.\n");
     fmt::print("\n");
+    fmt::print("All commands also accept:\n");
+    fmt::print("  --trace <trace.json>\n\tRecord how long each stage of the slice takes on which thread, and write it\n\tas a Chrome trace to the given file when the engine exits.\n");
+    fmt::print("  --spill <directory>\n\tMove the sliced layers to a scratch file in the given directory while the G-code\n\tis written, and read them back as they are needed. Only the memory used while\n\twriting G-code is reduced; slicing and generating the layers still keep all\n\tlayers in memory. How much geometry was moved out of memory is logged.\n");
+    fmt::print("\n");
     fmt::print("In order to load machine definitions from custom locations, you need to create the environment variable CURA_ENGINE_SEARCH_PATH, which should contain all search "
                "paths delimited by a (semi-)colon.\n");
     fmt::print("\n");
@@ -184,6 +192,7 @@ void Application::run(const size_t argc, char** argv)
 {
     argc_ = argc;
     argv_ = argv;
+    extractGlobalArguments();
 
     printLicense();
     Progress::init();
@@ -230,6 +239,30 @@ void Application::run(const size_t argc, char** argv)
     {
         communication_->sliceNext();
     }
+    Trace::write();
+    Counters::write();
+}
+
+void Application::extractGlobalArguments()
+{
+    size_t kept_argc = 0;
+    for (size_t argument_index = 0; argument_index < argc_; argument_index++)
+    {
+        if (std::string_view(argv_[argument_index]) == "--trace" && argument_index + 1 < argc_)
+        {
+            argument_index++;
+            Trace::enable(argv_[argument_index]);
+            continue;
+        }
+        if (std::string_view(argv_[argument_index]) == "--spill" && argument_index + 1 < argc_)
+        {
+            argument_index++;
+            LayerSpill::enable(argv_[argument_index]);
+            continue;
+        }
+        argv_[kept_argc++] = argv_[argument_index];
+    }
+    argc_ = kept_argc;
 }
 
 void Application::startThreadPool(int nworkers)
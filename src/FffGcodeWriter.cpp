@@ -22,6 +22,7 @@
 #include "FffProcessor.h"
 #include "InsetOrderOptimizer.h"
 #include "LayerPlan.h"
+#include "LayerSpill.h"
 #include "PathOrderMonotonic.h" //Monotonic ordering of skin lines.
 #include "Slice.h"
 #include "WallToolPaths.h"
@@ -32,6 +33,7 @@
 #include "raft.h"
 #include "utils/Simplify.h" //Removing micro-segments created by offsetting.
 #include "utils/ThreadPool.h"
+#include "utils/Trace.h"
 #include "utils/linearAlg2D.h"
 #include "utils/math.h"
 #include "utils/orderOptimizer.h"
@@ -78,6 +80,8 @@ bool FffGcodeWriter::setTargetFile(const char* filename)
 
 void FffGcodeWriter::writeGCode(SliceDataStorage& storage, TimeKeeper& time_keeper)
 {
+    TraceSpan trace_span("writeGCode");
+
     const size_t start_extruder_nr = getStartExtruder(storage);
     gcode.preSetup(start_extruder_nr);
     gcode.setSliceUUID(slice_uuid);
@@ -176,18 +180,42 @@ void FffGcodeWriter::writeGCode(SliceDataStorage& storage, TimeKeeper& time_keep
         }
     }
 
+    // Layers are handed to the consumer in order, so once a layer is consumed, all layers below it are processed as well.
+    // A layer can be freed as soon as all layers that read it are processed.
+    const LayerIndex::value_type look_behind = getProcessLayerLookBehind(storage);
+
+    // With spiralize, the wall outlines of all layers are referred to from the storage, so those layers have to stay where they are.
+    std::unique_ptr<LayerSpill> layer_spill;
+    if (LayerSpill::isEnabled() && ! scene.current_mesh_group->settings.get<bool>("magic_spiralize"))
+    {
+        layer_spill = std::make_unique<LayerSpill>();
+        if (! layer_spill->spill(storage))
+        {
+            layer_spill.reset();
+        }
+    }
+    const LayerIndex::value_type look_ahead = getProcessLayerLookAhead(storage);
+
     run_multiple_producers_ordered_consumer(
         process_layer_starting_layer_nr,
         total_layers,
-        [&storage, total_layers, this](int layer_nr)
+        [&storage, total_layers, this, &layer_spill, look_behind, look_ahead](int layer_nr)
         {
+            if (layer_spill)
+            {
+                // Raft filler layers print the support of layer 0, so their window is that of layer 0.
+                const LayerIndex window_layer_nr = std::max(LayerIndex(layer_nr), LayerIndex(0));
+                layer_spill->restore(storage, window_layer_nr - look_behind, window_layer_nr + look_ahead);
+            }
             return std::make_optional(processLayer(storage, layer_nr, total_layers));
         },
-        [this, total_layers](std::optional<ProcessLayerResult> result_opt)
+        [this, &storage, total_layers, look_behind](std::optional<ProcessLayerResult> result_opt)
         {
             const ProcessLayerResult& result = result_opt.value();
-            Progress::messageProgressLayer(result.layer_plan->getLayerNr(), total_layers, result.total_elapsed_time, result.stages_times);
+            const LayerIndex layer_nr = result.layer_plan->getLayerNr();
+            Progress::messageProgressLayer(layer_nr, total_layers, result.total_elapsed_time, result.stages_times);
             layer_plan_buffer.handle(*result.layer_plan, gcode);
+            releaseLayer(storage, layer_nr - look_behind);
         });
 
     layer_plan_buffer.flush();
@@ -1108,6 +1136,7 @@ void FffGcodeWriter::processRaft(const SliceDataStorage& storage)
 
 FffGcodeWriter::ProcessLayerResult FffGcodeWriter::processLayer(const SliceDataStorage& storage, LayerIndex layer_nr, const size_t total_layers) const
 {
+    TraceSpan trace_span("processLayer", layer_nr);
     spdlog::debug("GcodeWriter processing layer {} of {}", layer_nr, total_layers);
     TimeKeeper time_keeper;
     spdlog::stopwatch timer_total;
@@ -1283,6 +1312,66 @@ FffGcodeWriter::ProcessLayerResult FffGcodeWriter::processLayer(const SliceDataS
     return { &gcode_layer, timer_total.elapsed().count(), time_keeper.getRegisteredTimes() };
 }
 
+LayerIndex::value_type FffGcodeWriter::getProcessLayerLookBehind(const SliceDataStorage& storage) const
+{
+    // Bridges look for support in the model up to 3 layers below the skin, overhangs and spiralized walls look at the layer below.
+    constexpr LayerIndex::value_type model_look_behind = 3;
+
+    // Bridges also look for support areas up to 2 layers below the top distance of the support.
+    coord_t min_layer_thickness = std::numeric_limits<coord_t>::max();
+    coord_t max_support_top_distance = 0;
+    for (const std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+    {
+        max_support_top_distance = std::max(max_support_top_distance, mesh->settings.get<coord_t>("support_top_distance"));
+        for (const SliceLayer& layer : mesh->layers)
+        {
+            if (layer.thickness > 0)
+            {
+                min_layer_thickness = std::min(min_layer_thickness, layer.thickness);
+            }
+        }
+    }
+    if (min_layer_thickness == std::numeric_limits<coord_t>::max())
+    {
+        return model_look_behind;
+    }
+    const LayerIndex::value_type support_look_behind = max_support_top_distance / min_layer_thickness + 1 + 2;
+    return std::max(model_look_behind, support_look_behind);
+}
+
+LayerIndex::value_type FffGcodeWriter::getProcessLayerLookAhead(const SliceDataStorage& storage) const
+{
+    // Roofing masks look at the layer at the roofing depth above, skin edge support at the skin of the layers above.
+    LayerIndex::value_type look_ahead = 0;
+    for (const std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+    {
+        const size_t roofing_layer_count = std::min(mesh->settings.get<size_t>("roofing_layer_count"), mesh->settings.get<size_t>("top_layers"));
+        const size_t skin_edge_support_layers = mesh->settings.get<size_t>("skin_edge_support_layers");
+        look_ahead = std::max(look_ahead, static_cast<LayerIndex::value_type>(std::max(roofing_layer_count, skin_edge_support_layers)));
+    }
+    return look_ahead;
+}
+
+void FffGcodeWriter::releaseLayer(SliceDataStorage& storage, const LayerIndex layer_nr) const
+{
+    if (layer_nr < 0)
+    {
+        return;
+    }
+    for (const std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+    {
+        if (layer_nr < static_cast<LayerIndex>(mesh->layers.size()))
+        {
+            mesh->layers[layer_nr].release();
+        }
+    }
+    if (layer_nr < static_cast<LayerIndex>(storage.support.supportLayers.size()))
+    {
+        storage.support.supportLayers[layer_nr].release();
+    }
+    storage.forgetLayerOutlines(layer_nr);
+}
+
 bool FffGcodeWriter::getExtruderNeedPrimeBlobDuringFirstLayer(const SliceDataStorage& storage, const size_t extruder_nr) const
 {
     auto need_prime_blob = gcode.needPrimeBlob();
@@ -1397,6 +1486,8 @@ void FffGcodeWriter::processSkirtBrim(const SliceDataStorage& storage, LayerPlan
         }
     }
 
+    grid.compact();
+
     const auto smart_brim_ordering = train.settings_.get<bool>("brim_smart_ordering") && train.settings_.get<EPlatformAdhesion>("adhesion_type") == EPlatformAdhesion::BRIM;
     std::unordered_multimap<ConstPolygonPointer, ConstPolygonPointer> order_requirements;
     for (const std::pair<SquareGrid::GridPoint, SparsePointGridInclusiveImpl::SparsePointGridInclusiveElem<BrimLineReference>>& p : grid)
@@ -2443,7 +2534,7 @@ bool FffGcodeWriter::partitionInfillBySkinAbove(
 
         // the shrink/expand here is to remove regions of infill below skin that are narrower than the width of the infill walls otherwise the infill walls could merge and form
         // a bump
-        infill_below_skin = skin_above_combined.intersection(part.infill_area_per_combine_per_density.back().front()).offset(-infill_line_width).offset(infill_line_width);
+        infill_below_skin = skin_above_combined.intersection(part.infill_area_per_combine_per_density.back().front()).morphologicalOpen(infill_line_width);
 
         constexpr bool remove_small_holes_from_infill_below_skin = true;
         constexpr double min_area_multiplier = 25;
@@ -2658,7 +2749,7 @@ bool FffGcodeWriter::processInsets(
 
         // remove those parts of the layer below that are narrower than a wall line width as they will not be printed
 
-        outlines_below = outlines_below.offset(-half_outer_wall_width).offset(half_outer_wall_width);
+        outlines_below = outlines_below.morphologicalOpen(half_outer_wall_width);
 
         if (mesh.settings.get<bool>("bridge_settings_enabled"))
         {
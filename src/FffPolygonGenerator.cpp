@@ -6,6 +6,7 @@
 #include <fstream> // ifstream.good()
 #include <map> // multimap (ordered map allowing duplicate keys)
 #include <numeric>
+#include <optional>
 
 #include <spdlog/spdlog.h>
 
@@ -47,6 +48,7 @@
 #include "settings/types/LayerIndex.h"
 #include "utils/algorithm.h"
 #include "utils/ThreadPool.h"
+#include "utils/Trace.h"
 #include "utils/gettime.h"
 #include "utils/math.h"
 #include "utils/Simplify.h"
@@ -58,6 +60,8 @@ namespace cura
 
 bool FffPolygonGenerator::generateAreas(SliceDataStorage& storage, MeshGroup* meshgroup, TimeKeeper& timeKeeper)
 {
+    TraceSpan trace_span("generateAreas");
+
     if (! sliceModel(meshgroup, timeKeeper, storage))
     {
         return false;
@@ -91,6 +95,7 @@ size_t FffPolygonGenerator::getDraftShieldLayerCount(const size_t total_layers)
 
 bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, TimeKeeper& timeKeeper, SliceDataStorage& storage) /// slices the model
 {
+    TraceSpan trace_span("sliceModel");
     Progress::messageProgressStage(Progress::Stage::SLICING, &timeKeeper);
 
     storage.model_min = meshgroup->min();
@@ -196,32 +201,26 @@ bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, TimeKeeper& timeKeepe
         return true; // This is NOT an error state!
     }
 
-    std::vector<Slicer*> slicerList;
-    for (unsigned int mesh_idx = 0; mesh_idx < meshgroup->meshes.size(); mesh_idx++)
+    // Check if adaptive layers is populated to prevent accessing a method on NULL
+    std::vector<AdaptiveLayer>* adaptive_layer_height_values = {};
+    if (adaptive_layer_heights != nullptr)
     {
-        // Check if adaptive layers is populated to prevent accessing a method on NULL
-        std::vector<AdaptiveLayer>* adaptive_layer_height_values = {};
-        if (adaptive_layer_heights != nullptr)
-        {
-            adaptive_layer_height_values = adaptive_layer_heights->getLayers();
-        }
-
-        Mesh& mesh = meshgroup->meshes[mesh_idx];
-        Slicer* slicer = new Slicer(&mesh, layer_thickness, slice_layer_count, use_variable_layer_heights, adaptive_layer_height_values);
+        adaptive_layer_height_values = adaptive_layer_heights->getLayers();
+    }
 
-        slicerList.push_back(slicer);
+    // All meshes are sliced at once, so that plates with many small meshes keep all threads busy.
+    std::vector<Slicer*> slicerList = Slicer::sliceMeshes(meshgroup->meshes, layer_thickness, slice_layer_count, use_variable_layer_heights, adaptive_layer_height_values);
 
-        /*
-        for(SlicerLayer& layer : slicer->layers)
-        {
-            //Reporting the outline here slows down the engine quite a bit, so only do so when debugging.
-            sendPolygons("outline", layer_nr, layer.z, layer.polygonList);
-            sendPolygons("openoutline", layer_nr, layer.openPolygonList);
-        }
-        */
-
-        Progress::messageProgress(Progress::Stage::SLICING, mesh_idx + 1, meshgroup->meshes.size());
+    /*
+    for(SlicerLayer& layer : slicer->layers)
+    {
+        //Reporting the outline here slows down the engine quite a bit, so only do so when debugging.
+        sendPolygons("outline", layer_nr, layer.z, layer.polygonList);
+        sendPolygons("openoutline", layer_nr, layer.openPolygonList);
     }
+    */
+
+    Progress::messageProgress(Progress::Stage::SLICING, meshgroup->meshes.size(), meshgroup->meshes.size());
 
     // Clear the mesh face and vertex data, it is no longer needed after this point, and it saves a lot of memory.
     meshgroup->clear();
@@ -269,6 +268,7 @@ bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, TimeKeeper& timeKeepe
 
     storage.meshes.reserve(
         slicerList.size()); // causes there to be no resize in meshes so that the pointers in sliceMeshStorage._config to retraction_config don't get invalidated.
+    std::vector<std::pair<SliceMeshStorage*, Slicer*>> layer_part_meshes; // The layer parts of all meshes are created at once after this loop.
     for (unsigned int meshIdx = 0; meshIdx < slicerList.size(); meshIdx++)
     {
         Slicer* slicer = slicerList[meshIdx];
@@ -282,7 +282,13 @@ bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, TimeKeeper& timeKeepe
         const bool is_support_modifier = AreaSupport::handleSupportModifierMesh(storage, mesh.settings_, slicer);
         if (! is_support_modifier)
         {
-            createLayerParts(meshStorage, slicer);
+            layer_part_meshes.emplace_back(&meshStorage, slicer);
+        }
+        else
+        {
+            // Support modifiers are done with their slicer, so don't keep it until the layer parts of all other meshes are created.
+            delete slicer;
+            slicerList[meshIdx] = nullptr;
         }
 
         // Do not add and process support _modifier_ meshes further, and ONLY skip support _modifiers_. They have been
@@ -334,16 +340,20 @@ bool FffPolygonGenerator::sliceModel(MeshGroup* meshgroup, TimeKeeper& timeKeepe
                 }
             }
         }
+    }
 
-        delete slicerList[meshIdx];
-
-        Progress::messageProgress(Progress::Stage::PARTS, meshIdx + 1, slicerList.size());
+    createLayerParts(layer_part_meshes);
+    for (Slicer* slicer : slicerList)
+    {
+        delete slicer;
     }
     return true;
 }
 
 void FffPolygonGenerator::slices2polygons(SliceDataStorage& storage, TimeKeeper& time_keeper)
 {
+    TraceSpan trace_span("slices2polygons");
+
     // compute layer count and remove first empty layers
     // there is no separate progress stage for removeEmptyFisrtLayer (TODO)
     unsigned int slice_layer_count = 0;
@@ -414,6 +424,7 @@ void FffPolygonGenerator::slices2polygons(SliceDataStorage& storage, TimeKeeper&
     // handle helpers
     storage.primeTower.generatePaths(storage);
     storage.primeTower.subtractFromSupport(storage);
+    storage.invalidateLayerOutlines();
 
     spdlog::debug("Processing ooze shield");
     processOozeShield(storage);
@@ -439,6 +450,7 @@ void FffPolygonGenerator::slices2polygons(SliceDataStorage& storage, TimeKeeper&
     spdlog::debug("Processing gradual support");
     // generate gradual support
     AreaSupport::generateSupportInfillFeatures(storage);
+    storage.invalidateLayerOutlines();
 }
 
 void FffPolygonGenerator::processBasicWallsSkinInfill(
@@ -449,6 +461,7 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(
 {
     size_t mesh_idx = mesh_order[mesh_order_idx];
     SliceMeshStorage& mesh = *storage.meshes[mesh_idx];
+    TraceSpan trace_span("processBasicWallsSkinInfill", mesh.mesh_name);
     size_t mesh_layer_count = mesh.layers.size();
     if (mesh.settings.get<bool>("infill_mesh"))
     {
@@ -534,6 +547,13 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(
         mesh_max_initial_bottom_layer_count = std::max(mesh_max_initial_bottom_layer_count, mesh.settings.get<size_t>("initial_bottom_layers"));
     }
 
+    // The outlines are final after the walls are computed; the skins of all layers look at the same intersections of the outlines above and below them.
+    std::optional<LayerRangeIntersection> outline_intersections;
+    if (! magic_spiralize && mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::SURFACE)
+    {
+        outline_intersections = SkinInfillAreaComputation::buildOutlineIntersections(mesh);
+    }
+
     guarded_progress.reset();
     cura::parallel_for<size_t>(
         0,
@@ -543,7 +563,7 @@ void FffPolygonGenerator::processBasicWallsSkinInfill(
             spdlog::debug("Processing skins and infill layer {} of {}", layer_number, mesh.layers.size());
             if (! magic_spiralize || layer_number < mesh_max_initial_bottom_layer_count) // Only generate up/downskin and infill for the first X layers when spiralize is choosen.
             {
-                processSkinsAndInfill(mesh, layer_number, process_infill);
+                processSkinsAndInfill(mesh, layer_number, process_infill, outline_intersections ? &*outline_intersections : nullptr);
             }
             guarded_progress++;
         });
@@ -663,6 +683,8 @@ void FffPolygonGenerator::processInfillMesh(SliceDataStorage& storage, const siz
 
 void FffPolygonGenerator::processDerivedWallsSkinInfill(SliceMeshStorage& mesh)
 {
+    TraceSpan trace_span("processDerivedWallsSkinInfill", mesh.mesh_name);
+
     if (mesh.settings.get<bool>("infill_support_enabled"))
     { // create gradual infill areas
         SkinInfillAreaComputation::generateInfillSupport(mesh);
@@ -828,14 +850,16 @@ void FffPolygonGenerator::removeEmptyFirstLayers(SliceDataStorage& storage, size
  * processSkinsAndInfill read (depend on) mesh.layers[*].parts[*].{insets,boundingBox}.
  *                       write mesh.layers[n].parts[*].{skin_parts,infill_area}.
  */
-void FffPolygonGenerator::processSkinsAndInfill(SliceMeshStorage& mesh, const LayerIndex layer_nr, bool process_infill)
+void FffPolygonGenerator::processSkinsAndInfill(SliceMeshStorage& mesh, const LayerIndex layer_nr, bool process_infill, const LayerRangeIntersection* outline_intersections)
 {
+    TraceSpan trace_span("processSkinsAndInfill", layer_nr, mesh.mesh_name);
+
     if (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::SURFACE)
     {
         return;
     }
 
-    SkinInfillAreaComputation skin_infill_area_computation(layer_nr, mesh, process_infill);
+    SkinInfillAreaComputation skin_infill_area_computation(layer_nr, mesh, process_infill, outline_intersections);
     skin_infill_area_computation.generateSkinsAndInfill();
 
     if (((mesh.settings.get<bool>("ironing_enabled") && (! mesh.settings.get<bool>("ironing_only_highest_layer"))) || mesh.layer_nr_max_filled_layer == layer_nr)
@@ -946,6 +970,8 @@ void FffPolygonGenerator::computePrintHeightStatistics(SliceDataStorage& storage
 
 void FffPolygonGenerator::processOozeShield(SliceDataStorage& storage)
 {
+    TraceSpan trace_span("processOozeShield");
+
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     if (! mesh_group_settings.get<bool>("ooze_shield_enabled"))
     {
@@ -1003,6 +1029,8 @@ void FffPolygonGenerator::processOozeShield(SliceDataStorage& storage)
 
 void FffPolygonGenerator::processDraftShield(SliceDataStorage& storage)
 {
+    TraceSpan trace_span("processDraftShield");
+
     const size_t draft_shield_layers = getDraftShieldLayerCount(storage.print_layer_count);
     if (draft_shield_layers <= 0)
     {
@@ -1052,12 +1080,15 @@ void FffPolygonGenerator::processDraftShield(SliceDataStorage& storage)
 
 void FffPolygonGenerator::processPlatformAdhesion(SliceDataStorage& storage)
 {
+    TraceSpan trace_span("processPlatformAdhesion");
+
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
     EPlatformAdhesion adhesion_type = mesh_group_settings.get<EPlatformAdhesion>("adhesion_type");
 
     if (adhesion_type == EPlatformAdhesion::RAFT)
     {
         Raft::generate(storage);
+        storage.invalidateLayerOutlines(); // The raft layers now have outlines.
         return;
     }
 
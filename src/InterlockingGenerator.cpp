@@ -116,7 +116,7 @@ void InterlockingGenerator::handleThinAreas(const std::unordered_set<GridPoint3>
     }
     for (auto& near_interlock : near_interlock_per_layer)
     {
-        near_interlock = near_interlock.offset(rounding_errors).offset(-rounding_errors).unionPolygons().offset(detect);
+        near_interlock = near_interlock.morphologicalClose(rounding_errors).unionPolygons().offset(detect);
         near_interlock.applyMatrix(rotation_.inverse());
     }
 
@@ -129,8 +129,8 @@ void InterlockingGenerator::handleThinAreas(const std::unordered_set<GridPoint3>
         const auto [from_border_a, from_border_b] = growBorderAreasPerpendicular(polys_a, polys_b, detect);
 
         // Get the areas of each mesh that are _not_ thin (large), by performing a morphological open.
-        const Polygons large_a{ polys_a.offset(-detect).offset(detect) };
-        const Polygons large_b{ polys_b.offset(-detect).offset(detect) };
+        const Polygons large_a{ polys_a.morphologicalOpen(detect) };
+        const Polygons large_b{ polys_b.morphologicalOpen(detect) };
 
         // Derive the area that the thin areas need to expand into (so the added areas to the thin strips) from the information we already have.
         const Polygons thin_expansion_a{
@@ -142,8 +142,8 @@ void InterlockingGenerator::handleThinAreas(const std::unordered_set<GridPoint3>
 
         // Expanded thin areas of the opposing polygon should 'eat into' the larger areas of the polygon,
         // and conversely, add the expansions to their own thin areas.
-        polys_a = polys_a.unionPolygons(thin_expansion_a).difference(thin_expansion_b).offset(close_gaps).offset(-close_gaps);
-        polys_b = polys_b.unionPolygons(thin_expansion_b).difference(thin_expansion_a).offset(close_gaps).offset(-close_gaps);
+        polys_a = polys_a.unionPolygons(thin_expansion_a).difference(thin_expansion_b).morphologicalClose(close_gaps);
+        polys_b = polys_b.unionPolygons(thin_expansion_b).difference(thin_expansion_a).morphologicalClose(close_gaps);
     }
 }
 
@@ -214,7 +214,7 @@ void InterlockingGenerator::addBoundaryCells(const std::vector<Polygons>& layers
         {
             skin = skin.xorPolygons(layers[layer_nr - 1]);
         }
-        skin = skin.offset(-cell_size_.x_ / 2).offset(cell_size_.x_ / 2); // remove superfluous small areas, which would anyway be included because of walkPolygons
+        skin = skin.morphologicalOpen(cell_size_.x_ / 2); // remove superfluous small areas, which would anyway be included because of walkPolygons
         vu_.walkDilatedAreas(skin, z, kernel, voxel_emplacer);
     }
 }
@@ -236,7 +236,7 @@ std::vector<Polygons> InterlockingGenerator::computeUnionedVolumeRegions() const
             const SlicerLayer& layer = mesh->layers[static_cast<size_t>(layer_nr)];
             layer_region.add(layer.polygons);
         }
-        layer_region = layer_region.offset(ignored_gap_).offset(-ignored_gap_); // Morphological close to merge meshes into single volume
+        layer_region = layer_region.morphologicalClose(ignored_gap_); // Morphological close to merge meshes into single volume
         layer_region.applyMatrix(rotation_);
     }
     return layer_regions;
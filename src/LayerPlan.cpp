@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <future>
 #include <numeric>
 #include <optional>
 
@@ -24,7 +25,9 @@
 #include "raft.h" // getTotalExtraLayers
 #include "settings/types/Ratio.h"
 #include "sliceDataStorage.h"
+#include "utils/Counters.h"
 #include "utils/Simplify.h"
+#include "utils/Trace.h"
 #include "utils/linearAlg2D.h"
 #include "utils/polygonUtils.h"
 #include "utils/section_type.h"
@@ -433,7 +436,12 @@ GCodePath& LayerPlan::addTravel(const Point2LL& p, const bool force_retract, con
             is_inside_,
             max_distance_ignored,
             unretract_before_last_travel_move);
-        if (combed)
+        Counters::add(Counter::COMB_ATTEMPTS);
+        if (! combed)
+        {
+            Counters::add(Counter::COMB_FALLBACKS);
+        }
+        else
         {
             bool retract = path->retract || (combPaths.size() > 1 && retraction_enable);
             if (! retract)
@@ -1935,6 +1943,8 @@ void LayerPlan::processFanSpeedAndMinimalLayerTime(Point2LL starting_position)
 
 void LayerPlan::writeGCode(GCodeExport& gcode)
 {
+    TraceSpan trace_span("GCodeExport", layer_nr_);
+
     Communication* communication = Application::getInstance().communication_;
     communication->setLayerForSend(layer_nr_);
     communication->sendCurrentPosition(gcode.getPositionXY());
@@ -2508,6 +2518,8 @@ bool LayerPlan::writePathWithCoasting(
 
 void LayerPlan::applyModifyPlugin()
 {
+    std::vector<std::future<std::vector<GCodePath>>> modified_paths;
+    modified_paths.reserve(extruder_plans_.size());
     for (auto& extruder_plan : extruder_plans_)
     {
         scripta::log(
@@ -2528,7 +2540,14 @@ void LayerPlan::applyModifyPlugin()
             scripta::CellVDI{ "is_travel_path", &GCodePath::isTravelPath },
             scripta::CellVDI{ "extrusion_mm3_per_mm", &GCodePath::getExtrusionMM3perMM });
 
-        extruder_plan.paths_ = slots::instance().modify<plugins::v0::SlotID::GCODE_PATHS_MODIFY>(extruder_plan.paths_, extruder_plan.extruder_nr_, layer_nr_);
+        modified_paths.push_back(slots::instance().modifyAsync<plugins::v0::SlotID::GCODE_PATHS_MODIFY>(extruder_plan.paths_, extruder_plan.extruder_nr_, layer_nr_));
+    }
+
+    // Only wait for the plugin after all requests of this layer are sent, so that it can work on them while the other requests are being prepared.
+    for (size_t plan_idx = 0; plan_idx < extruder_plans_.size(); ++plan_idx)
+    {
+        ExtruderPlan& extruder_plan = extruder_plans_[plan_idx];
+        extruder_plan.paths_ = modified_paths[plan_idx].get();
 
         scripta::log(
             "extruder_plan_1",
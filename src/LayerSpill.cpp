@@ -0,0 +1,454 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "LayerSpill.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include "sliceDataStorage.h"
+#include "utils/PolygonCodec.h"
+
+namespace cura
+{
+
+namespace
+{
+
+std::atomic<bool> spill_enabled{ false };
+std::filesystem::path spill_directory;
+
+void writeToolpaths(PolygonEncoder& encoder, const std::vector<VariableWidthLines>& toolpaths)
+{
+    encoder.writeUnsigned(toolpaths.size());
+    for (const VariableWidthLines& lines : toolpaths)
+    {
+        encoder.writeUnsigned(lines.size());
+        for (const ExtrusionLine& line : lines)
+        {
+            encoder.writeUnsigned(line.inset_idx_);
+            encoder.writeUnsigned((line.is_odd_ ? 1 : 0) | (line.is_closed_ ? 2 : 0));
+            encoder.writeUnsigned(line.junctions_.size());
+            for (const ExtrusionJunction& junction : line.junctions_)
+            {
+                encoder.writePoint(junction.p_);
+                encoder.writeSigned(junction.w_);
+                encoder.writeUnsigned(junction.perimeter_index_);
+            }
+        }
+    }
+}
+
+std::vector<VariableWidthLines> readToolpaths(PolygonDecoder& decoder)
+{
+    std::vector<VariableWidthLines> toolpaths(decoder.readUnsigned());
+    for (VariableWidthLines& lines : toolpaths)
+    {
+        lines.resize(decoder.readUnsigned());
+        for (ExtrusionLine& line : lines)
+        {
+            line.inset_idx_ = decoder.readUnsigned();
+            const uint64_t flags = decoder.readUnsigned();
+            line.is_odd_ = (flags & 1) != 0;
+            line.is_closed_ = (flags & 2) != 0;
+            const size_t junction_count = decoder.readUnsigned();
+            line.junctions_.reserve(junction_count);
+            for (size_t junction_idx = 0; junction_idx < junction_count; ++junction_idx)
+            {
+                const Point2LL p = decoder.readPoint();
+                const coord_t w = decoder.readSigned();
+                const size_t perimeter_index = decoder.readUnsigned();
+                line.junctions_.emplace_back(p, w, perimeter_index);
+            }
+        }
+    }
+    return toolpaths;
+}
+
+void writeAreasPerCombinePerDensity(PolygonEncoder& encoder, const std::vector<std::vector<Polygons>>& areas)
+{
+    encoder.writeUnsigned(areas.size());
+    for (const std::vector<Polygons>& areas_per_combine : areas)
+    {
+        encoder.writeUnsigned(areas_per_combine.size());
+        for (const Polygons& polygons : areas_per_combine)
+        {
+            encoder.writePolygons(polygons);
+        }
+    }
+}
+
+std::vector<std::vector<Polygons>> readAreasPerCombinePerDensity(PolygonDecoder& decoder)
+{
+    std::vector<std::vector<Polygons>> areas(decoder.readUnsigned());
+    for (std::vector<Polygons>& areas_per_combine : areas)
+    {
+        areas_per_combine.resize(decoder.readUnsigned());
+        for (Polygons& polygons : areas_per_combine)
+        {
+            polygons = decoder.readPolygons();
+        }
+    }
+    return areas;
+}
+
+/*!
+ * Read polygons into a subclass of \ref Polygons, such as a \ref PolygonsPart.
+ */
+void readPolygonsInto(PolygonDecoder& decoder, Polygons& polygons)
+{
+    polygons.paths = std::move(decoder.readPolygons().paths);
+}
+
+void writeSliceLayer(PolygonEncoder& encoder, const SliceLayer& layer)
+{
+    encoder.writeUnsigned(layer.parts.size());
+    for (const SliceLayerPart& part : layer.parts)
+    {
+        encoder.writePoint(part.boundaryBox.min_);
+        encoder.writePoint(part.boundaryBox.max_);
+        encoder.writePolygons(part.outline);
+        encoder.writePolygons(part.print_outline);
+        encoder.writePolygons(part.spiral_wall);
+        encoder.writePolygons(part.inner_area);
+        encoder.writeUnsigned(part.skin_parts.size());
+        for (const SkinPart& skin_part : part.skin_parts)
+        {
+            encoder.writePolygons(skin_part.outline);
+            encoder.writePolygons(skin_part.skin_fill);
+            encoder.writePolygons(skin_part.roofing_fill);
+            encoder.writePolygons(skin_part.top_most_surface_fill);
+            encoder.writePolygons(skin_part.bottom_most_surface_fill);
+        }
+        writeToolpaths(encoder, part.wall_toolpaths);
+        writeToolpaths(encoder, part.infill_wall_toolpaths);
+        encoder.writePolygons(part.infill_area);
+        encoder.writeUnsigned(part.infill_area_own.has_value() ? 1 : 0);
+        if (part.infill_area_own.has_value())
+        {
+            encoder.writePolygons(part.infill_area_own.value());
+        }
+        writeAreasPerCombinePerDensity(encoder, part.infill_area_per_combine_per_density);
+    }
+    encoder.writePolygons(layer.openPolyLines);
+    encoder.writePolygons(layer.top_surface.areas);
+    encoder.writePolygons(layer.bottom_surface);
+}
+
+void readSliceLayer(PolygonDecoder& decoder, SliceLayer& layer)
+{
+    layer.parts.resize(decoder.readUnsigned());
+    for (SliceLayerPart& part : layer.parts)
+    {
+        part.boundaryBox.min_ = decoder.readPoint();
+        part.boundaryBox.max_ = decoder.readPoint();
+        readPolygonsInto(decoder, part.outline);
+        part.print_outline = decoder.readPolygons();
+        part.spiral_wall = decoder.readPolygons();
+        part.inner_area = decoder.readPolygons();
+        part.skin_parts.resize(decoder.readUnsigned());
+        for (SkinPart& skin_part : part.skin_parts)
+        {
+            readPolygonsInto(decoder, skin_part.outline);
+            skin_part.skin_fill = decoder.readPolygons();
+            skin_part.roofing_fill = decoder.readPolygons();
+            skin_part.top_most_surface_fill = decoder.readPolygons();
+            skin_part.bottom_most_surface_fill = decoder.readPolygons();
+        }
+        part.wall_toolpaths = readToolpaths(decoder);
+        part.infill_wall_toolpaths = readToolpaths(decoder);
+        part.infill_area = decoder.readPolygons();
+        if (decoder.readUnsigned() != 0)
+        {
+            part.infill_area_own = decoder.readPolygons();
+        }
+        part.infill_area_per_combine_per_density = readAreasPerCombinePerDensity(decoder);
+    }
+    layer.openPolyLines = decoder.readPolygons();
+    layer.top_surface.areas = decoder.readPolygons();
+    layer.bottom_surface = decoder.readPolygons();
+}
+
+void writeSupportLayer(PolygonEncoder& encoder, const SupportLayer& layer)
+{
+    encoder.writeUnsigned(layer.support_infill_parts.size());
+    for (const SupportInfillPart& part : layer.support_infill_parts)
+    {
+        encoder.writePolygons(part.outline_);
+        encoder.writeSigned(part.support_line_width_);
+        encoder.writeUnsigned(part.use_fractional_config_ ? 1 : 0);
+        encoder.writeSigned(part.inset_count_to_generate_);
+        encoder.writeSigned(part.custom_line_distance_);
+        writeAreasPerCombinePerDensity(encoder, part.infill_area_per_combine_per_density_);
+        writeToolpaths(encoder, part.wall_toolpaths_);
+    }
+    encoder.writePolygons(layer.support_bottom);
+    encoder.writePolygons(layer.support_roof);
+    encoder.writePolygons(layer.support_fractional_roof);
+    encoder.writePolygons(layer.support_mesh_drop_down);
+    encoder.writePolygons(layer.support_mesh);
+    encoder.writePolygons(layer.anti_overhang);
+}
+
+void readSupportLayer(PolygonDecoder& decoder, SupportLayer& layer)
+{
+    const size_t part_count = decoder.readUnsigned();
+    layer.support_infill_parts.reserve(part_count);
+    for (size_t part_idx = 0; part_idx < part_count; ++part_idx)
+    {
+        PolygonsPart outline;
+        readPolygonsInto(decoder, outline);
+        const coord_t support_line_width = decoder.readSigned();
+        const bool use_fractional_config = decoder.readUnsigned() != 0;
+        const int inset_count_to_generate = static_cast<int>(decoder.readSigned());
+        const coord_t custom_line_distance = decoder.readSigned();
+        // The boundary box of the part is computed from its outline again.
+        SupportInfillPart& part = layer.support_infill_parts.emplace_back(outline, support_line_width, use_fractional_config, inset_count_to_generate, custom_line_distance);
+        part.infill_area_per_combine_per_density_ = readAreasPerCombinePerDensity(decoder);
+        part.wall_toolpaths_ = readToolpaths(decoder);
+    }
+    layer.support_bottom = decoder.readPolygons();
+    layer.support_roof = decoder.readPolygons();
+    layer.support_fractional_roof = decoder.readPolygons();
+    layer.support_mesh_drop_down = decoder.readPolygons();
+    layer.support_mesh = decoder.readPolygons();
+    layer.anti_overhang = decoder.readPolygons();
+}
+
+} // namespace
+
+void LayerSpill::enable(const std::filesystem::path& directory)
+{
+#ifdef _WIN32
+    spdlog::warn("Spilling layers to {} is not supported on this platform, all layers are kept in memory.", directory.string());
+#else
+    spill_directory = directory;
+    spill_enabled.store(true, std::memory_order_relaxed);
+#endif
+}
+
+bool LayerSpill::isEnabled()
+{
+    return spill_enabled.load(std::memory_order_relaxed);
+}
+
+LayerSpill::~LayerSpill()
+{
+    close();
+}
+
+bool LayerSpill::spill(SliceDataStorage& storage)
+{
+    if (! openScratchFile())
+    {
+        return false;
+    }
+
+    LayerIndex::value_type layer_count = static_cast<LayerIndex::value_type>(storage.support.supportLayers.size());
+    for (const std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+    {
+        layer_count = std::max(layer_count, static_cast<LayerIndex::value_type>(mesh->layers.size()));
+    }
+    layers_ = std::make_unique<SpilledLayer[]>(layer_count);
+
+    std::vector<uint8_t> buffer;
+    size_t spilled_size = 0;
+    size_t released_size = 0; // The size of the points of the released layers. The layers took more than this, but it is a lower bound on what spilling saves.
+    for (LayerIndex::value_type layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        buffer.clear();
+        PolygonEncoder encoder(buffer);
+        for (const std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+        {
+            if (layer_nr < static_cast<LayerIndex::value_type>(mesh->layers.size()))
+            {
+                writeSliceLayer(encoder, mesh->layers[layer_nr]);
+            }
+        }
+        if (layer_nr < static_cast<LayerIndex::value_type>(storage.support.supportLayers.size()))
+        {
+            writeSupportLayer(encoder, storage.support.supportLayers[layer_nr]);
+        }
+
+        SpilledLayer& spilled = layers_[layer_nr];
+        if (! writeToScratchFile(buffer))
+        {
+            spdlog::warn("Couldn't spill layer {} to the scratch file, keeping the layers from there on in memory: {}", layer_nr, std::strerror(errno));
+            break;
+        }
+        spilled.offset = spilled_size;
+        spilled.size = buffer.size();
+        spilled_size += buffer.size();
+        layer_count_ = layer_nr + 1;
+        released_size += encoder.pointCount() * sizeof(Point2LL);
+
+        for (const std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+        {
+            if (layer_nr < static_cast<LayerIndex::value_type>(mesh->layers.size()))
+            {
+                mesh->layers[layer_nr].release();
+            }
+        }
+        if (layer_nr < static_cast<LayerIndex::value_type>(storage.support.supportLayers.size()))
+        {
+            storage.support.supportLayers[layer_nr].release();
+        }
+    }
+
+    mapScratchFile(spilled_size);
+    spdlog::info("Spilled {} layers with {} MiB of points to a scratch file of {} MiB.", layer_count_, released_size >> 20, spilled_size >> 20);
+    return layer_count_ > 0;
+}
+
+void LayerSpill::restore(SliceDataStorage& storage, const LayerIndex min_layer_nr, const LayerIndex max_layer_nr)
+{
+    for (LayerIndex layer_nr = std::max(min_layer_nr, LayerIndex(0)); layer_nr <= max_layer_nr && layer_nr < static_cast<LayerIndex>(layer_count_); ++layer_nr)
+    {
+        SpilledLayer& spilled = layers_[layer_nr.value];
+        std::call_once(
+            spilled.restored,
+            [this, &storage, &spilled, layer_nr]()
+            {
+                if (mapping_ != nullptr)
+                {
+                    restoreLayer(storage, layer_nr, std::span<const uint8_t>(mapping_ + spilled.offset, spilled.size));
+                }
+                else
+                {
+                    restoreLayer(storage, layer_nr, readFromScratchFile(layer_nr, spilled));
+                }
+            });
+    }
+}
+
+void LayerSpill::restoreLayer(SliceDataStorage& storage, const LayerIndex layer_nr, std::span<const uint8_t> data) const
+{
+    PolygonDecoder decoder(data);
+    for (const std::shared_ptr<SliceMeshStorage>& mesh : storage.meshes)
+    {
+        if (layer_nr < static_cast<LayerIndex>(mesh->layers.size()))
+        {
+            readSliceLayer(decoder, mesh->layers[layer_nr]);
+        }
+    }
+    if (layer_nr < static_cast<LayerIndex>(storage.support.supportLayers.size()))
+    {
+        readSupportLayer(decoder, storage.support.supportLayers[layer_nr]);
+    }
+    assert(decoder.atEnd() && "All spilled data of a layer should be read back.");
+}
+
+bool LayerSpill::openScratchFile()
+{
+#ifdef _WIN32
+    return false;
+#else
+    std::string file_template = (spill_directory / "curaengine-layers-XXXXXX").string();
+    file_descriptor_ = mkstemp(file_template.data());
+    if (file_descriptor_ < 0)
+    {
+        spdlog::warn("Couldn't create a scratch file in {} to spill layers to: {}", spill_directory.string(), std::strerror(errno));
+        return false;
+    }
+    // Nothing else needs to open the file, and unlinking it right away makes sure that it's cleaned up however the engine exits.
+    unlink(file_template.c_str());
+    return true;
+#endif
+}
+
+bool LayerSpill::writeToScratchFile(const std::vector<uint8_t>& data)
+{
+#ifdef _WIN32
+    return false;
+#else
+    size_t written = 0;
+    while (written < data.size())
+    {
+        const ssize_t result = write(file_descriptor_, data.data() + written, data.size() - written);
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+    return true;
+#endif
+}
+
+void LayerSpill::mapScratchFile(const size_t file_size)
+{
+#ifndef _WIN32
+    if (file_size == 0)
+    {
+        return;
+    }
+    void* mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file_descriptor_, 0);
+    if (mapping == MAP_FAILED)
+    {
+        spdlog::warn("Couldn't map the scratch file with the spilled layers, reading them back from the file instead: {}", std::strerror(errno));
+        return;
+    }
+    mapping_ = static_cast<const uint8_t*>(mapping);
+    mapping_size_ = file_size;
+#endif
+}
+
+std::vector<uint8_t> LayerSpill::readFromScratchFile(const LayerIndex layer_nr, const SpilledLayer& spilled) const
+{
+    std::vector<uint8_t> data(spilled.size);
+#ifndef _WIN32
+    size_t read_size = 0;
+    while (read_size < spilled.size)
+    {
+        const ssize_t result = pread(file_descriptor_, data.data() + read_size, spilled.size - read_size, static_cast<off_t>(spilled.offset + read_size));
+        if (result < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (result <= 0)
+        {
+            // The layer is released already, so there is no way to continue without it.
+            spdlog::error("Couldn't read layer {} back from the scratch file: {}", layer_nr.value, std::strerror(errno));
+            std::abort();
+        }
+        read_size += static_cast<size_t>(result);
+    }
+#endif
+    return data;
+}
+
+void LayerSpill::close()
+{
+#ifndef _WIN32
+    if (mapping_ != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(mapping_), mapping_size_);
+        mapping_ = nullptr;
+    }
+    if (file_descriptor_ >= 0)
+    {
+        ::close(file_descriptor_);
+        file_descriptor_ = -1;
+    }
+#endif
+}
+
+} // namespace cura
@@ -18,6 +18,7 @@
 #include "infill.h"
 #include "raft.h"
 #include "sliceDataStorage.h"
+#include "utils/ThreadPool.h"
 
 #define CIRCLE_RESOLUTION 32 // The number of vertices in each circle.
 #define ARC_RESOLUTION 4 // The number of segments in each arc of a wheel
@@ -165,7 +166,7 @@ void PrimeTower::generatePaths_denseInfill(std::vector<coord_t>& cumulative_inse
             }
         }
 
-        // Generate the base outside extra rings
+        // Determine the base outside extra rings of each layer
         if ((method == PrimeTowerMethod::INTERLEAVED || (extruder_nr == extruder_order_.front() && method == PrimeTowerMethod::NORMAL)) && (base_enabled || has_raft)
             && base_extra_radius > 0 && base_height > 0)
         {
@@ -178,10 +179,13 @@ void PrimeTower::generatePaths_denseInfill(std::vector<coord_t>& cumulative_inse
                 {
                     break;
                 }
-                extra_radius = line_width * extra_rings;
-                outer_poly_base_.push_back(outer_poly_.offset(extra_radius));
-
-                base_extra_moves_[extruder_nr].push_back(PolygonUtils::generateOutset(outer_poly_, extra_rings, line_width));
+                // Consecutive layers with the same number of rings share their variant.
+                if (base_variants_.empty() || base_variants_.back().extruder_nr != extruder_nr || base_variants_.back().extra_rings != extra_rings)
+                {
+                    base_variants_.push_back(BaseVariant{ extruder_nr, extra_rings, {}, {} });
+                }
+                base_extra_moves_[extruder_nr].push_back(base_variants_.size() - 1);
+                outer_poly_base_.push_back(base_variants_.size() - 1);
             }
         }
 
@@ -189,6 +193,18 @@ void PrimeTower::generatePaths_denseInfill(std::vector<coord_t>& cumulative_inse
         cumulative_insets.push_back(cumulative_inset);
     }
 
+    // Generate the rings of each distinct base layer once.
+    cura::parallel_for<size_t>(
+        0,
+        base_variants_.size(),
+        [&](const size_t variant_idx)
+        {
+            BaseVariant& variant = base_variants_[variant_idx];
+            const coord_t line_width = scene.extruders[variant.extruder_nr].settings_.get<coord_t>("prime_tower_line_width");
+            variant.moves = PolygonUtils::generateOutset(outer_poly_, variant.extra_rings, line_width);
+            variant.outline = outer_poly_.offset(line_width * variant.extra_rings);
+        });
+
     // Now we have the total cumulative inset, generate the base inside extra rings
     for (size_t extruder_nr : extruder_order_)
     {
@@ -239,6 +255,15 @@ void PrimeTower::generatePaths_sparseInfill(const std::vector<coord_t>& cumulati
             rings_radii.push_back(tower_radius - cumulative_inset);
         }
 
+        struct SparsePattern
+        {
+            size_t extruders_combination;
+            size_t first_extruder_idx;
+            size_t last_extruder_idx;
+            ActualExtruder extruder;
+        };
+        std::vector<SparsePattern> patterns;
+
         // Generate all possible extruders combinations, e.g. if there are 4 extruders, we have combinations
         // 0 / 0-1 / 0-1-2 / 0-1-2-3 / 1 / 1-2 / 1-2-3 / 2 / 2-3 / 3
         // A combination is represented by a bitmask
@@ -255,19 +280,31 @@ void PrimeTower::generatePaths_sparseInfill(const std::vector<coord_t>& cumulati
                     extruders_combination |= (1 << extruder_nr);
                 }
 
-                std::map<size_t, Polygons> infills_for_combination;
                 for (const ActualExtruder& actual_extruder : actual_extruders)
                 {
                     if (method == PrimeTowerMethod::INTERLEAVED || actual_extruder.number == extruder_order_.at(first_extruder_idx))
                     {
-                        Polygons infill = generatePath_sparseInfill(first_extruder_idx, last_extruder_idx, rings_radii, actual_extruder.line_width, actual_extruder.number);
-                        infills_for_combination[actual_extruder.number] = infill;
+                        patterns.push_back({ extruders_combination, first_extruder_idx, last_extruder_idx, actual_extruder });
                     }
                 }
-
-                sparse_pattern_per_extruders_[extruders_combination] = infills_for_combination;
             }
         }
+
+        // Every pattern is independent of the others, so generate them all at once.
+        std::vector<Polygons> infills(patterns.size());
+        cura::parallel_for<size_t>(
+            0,
+            patterns.size(),
+            [&](const size_t pattern_idx)
+            {
+                const SparsePattern& pattern = patterns[pattern_idx];
+                infills[pattern_idx]
+                    = generatePath_sparseInfill(pattern.first_extruder_idx, pattern.last_extruder_idx, rings_radii, pattern.extruder.line_width, pattern.extruder.number);
+            });
+        for (size_t pattern_idx = 0; pattern_idx < patterns.size(); ++pattern_idx)
+        {
+            sparse_pattern_per_extruders_[patterns[pattern_idx].extruders_combination][patterns[pattern_idx].extruder.number] = std::move(infills[pattern_idx]);
+        }
     }
 }
 
@@ -454,11 +491,11 @@ bool PrimeTower::addToGcode_base(LayerPlan& gcode_layer, const size_t extruder_n
     const size_t raft_total_extra_layers = Raft::getTotalExtraLayers();
     LayerIndex absolute_layer_number = gcode_layer.getLayerNr() + raft_total_extra_layers;
 
-    const std::vector<Polygons>& pattern_extra_brim = base_extra_moves_[extruder_nr];
+    const std::vector<size_t>& pattern_extra_brim = base_extra_moves_[extruder_nr];
     if (absolute_layer_number < pattern_extra_brim.size())
     {
         // Extra rings for stronger base
-        const Polygons& pattern = pattern_extra_brim[absolute_layer_number];
+        const Polygons& pattern = base_variants_[pattern_extra_brim[absolute_layer_number]].moves;
         if (! pattern.empty())
         {
             const GCodePathConfig& config = gcode_layer.configs_storage_.prime_tower_config_per_extruder[extruder_nr];
@@ -609,7 +646,7 @@ const Polygons& PrimeTower::getOuterPoly(const LayerIndex& layer_nr) const
     const LayerIndex absolute_layer_nr = layer_nr + Raft::getTotalExtraLayers();
     if (absolute_layer_nr < outer_poly_base_.size())
     {
-        return outer_poly_base_[absolute_layer_nr];
+        return base_variants_[outer_poly_base_[absolute_layer_nr]].outline;
     }
     else
     {
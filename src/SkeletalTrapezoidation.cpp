@@ -14,6 +14,7 @@
 
 #include "BoostInterface.hpp"
 #include "settings/types/Ratio.h"
+#include "utils/Counters.h"
 #include "utils/VoronoiUtils.h"
 #include "utils/linearAlg2D.h"
 #include "utils/macros.h"
@@ -476,6 +477,10 @@ void SkeletalTrapezoidation::constructFromPolygons(const Polygons& polys)
 
     graph_.collapseSmallEdges();
 
+    Counters::add(Counter::SKELETAL_TRAPEZOIDATION_GRAPHS);
+    Counters::add(Counter::SKELETAL_TRAPEZOIDATION_NODES, graph_.nodes.size());
+    Counters::record(Histogram::SKELETAL_TRAPEZOIDATION_NODES, graph_.nodes.size());
+
     // Set [incident_edge] the the first possible edge that way we can iterate over all reachable edges from node.incident_edge,
     // without needing to iterate backward
     for (edge_t& edge : graph_.edges)
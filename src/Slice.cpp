@@ -9,6 +9,7 @@
 #endif
 
 #include "ExtruderTrain.h"
+#include "utils/SeamCornerCache.h"
 
 namespace cura
 {
@@ -43,6 +44,7 @@ void Slice::reset()
     scene.extruders.clear();
     scene.mesh_groups.clear();
     scene.settings = Settings();
+    SeamCornerCache::clear(); // The shapes of the next slice are unlikely to be the same.
 }
 
 } // namespace cura
@@ -13,6 +13,7 @@
 #include "progress/Progress.h"
 #include "sliceDataStorage.h"
 #include "utils/ThreadPool.h"
+#include "utils/Trace.h"
 #include "utils/algorithm.h"
 
 namespace cura
@@ -171,6 +172,7 @@ TreeModelVolumes::TreeModelVolumes(
 
 void TreeModelVolumes::precalculate(coord_t max_layer)
 {
+    TraceSpan trace_span("TreeModelVolumes::precalculate");
     const auto t_start = std::chrono::high_resolution_clock::now();
     precalculated_ = true;
 
@@ -25,6 +25,7 @@
 #include "progress/Progress.h"
 #include "settings/EnumSettings.h"
 #include "support.h" //For precomputeCrossInfillTree
+#include "utils/AABBGrid.h"
 #include "utils/Simplify.h"
 #include "utils/ThreadPool.h"
 #include "utils/algorithm.h"
@@ -113,7 +114,7 @@ void TreeSupport::generateSupportAreas(SliceDataStorage& storage)
     for (auto [counter, processing] : grouped_meshes | ranges::views::enumerate)
     {
         // process each combination of meshes
-        std::vector<std::set<TreeSupportElement*>> move_bounds(
+        std::vector<TreeSupportElementSet> move_bounds(
             storage.support.supportLayers
                 .size()); // Value is the area where support may be placed. As this is calculated in CreateLayerPathing it is saved and reused in drawAreas.
 
@@ -205,12 +206,13 @@ void TreeSupport::generateSupportAreas(SliceDataStorage& storage)
             for (auto elem : layer)
             {
                 delete elem->area_;
-                delete elem;
             }
         }
+        element_pool_.clear();
     }
 
     storage.support.generated = true;
+    storage.invalidateLayerOutlines();
 }
 
 LayerIndex TreeSupport::precalculate(const SliceDataStorage& storage, std::vector<size_t> currently_processing_meshes)
@@ -253,9 +255,9 @@ LayerIndex TreeSupport::precalculate(const SliceDataStorage& storage, std::vecto
 }
 
 
-void TreeSupport::generateInitialAreas(const SliceMeshStorage& mesh, std::vector<std::set<TreeSupportElement*>>& move_bounds, SliceDataStorage& storage)
+void TreeSupport::generateInitialAreas(const SliceMeshStorage& mesh, std::vector<TreeSupportElementSet>& move_bounds, SliceDataStorage& storage)
 {
-    TreeSupportTipGenerator tip_gen(mesh, volumes_);
+    TreeSupportTipGenerator tip_gen(mesh, volumes_, element_pool_);
     tip_gen.generateTips(storage, mesh, move_bounds, additional_required_support_area, fake_roof_areas);
 }
 
@@ -276,12 +278,44 @@ void TreeSupport::mergeHelper(
     {
         return config.getRadius(distance_to_top, buildplate_radius_increases);
     };
+
+    // Index the already processed elements, so that only the ones near an influence area have to be checked, rather than all of them.
+    // The candidates are still checked in the order of the map, so the result is the same as checking all elements.
+    using AABBEntry = std::pair<const TreeSupportElement, AABB>;
+    coord_t total_aabb_size = 0;
+    coord_t valid_aabb_count = 0;
+    for (const auto& aabb_map : { &reduced_aabb, &input_aabb })
+    {
+        for (const AABBEntry& entry : *aabb_map)
+        {
+            if (entry.second.area() >= 0)
+            {
+                total_aabb_size += std::max(entry.second.max_.X - entry.second.min_.X, entry.second.max_.Y - entry.second.min_.Y);
+                valid_aabb_count++;
+            }
+        }
+    }
+    AABBGrid<const AABBEntry*> reduced_grid(total_aabb_size / std::max(coord_t(1), valid_aabb_count));
+    for (const AABBEntry& entry : reduced_aabb)
+    {
+        reduced_grid.insert(&entry, entry.second);
+    }
+    const auto in_map_order = [&reduced_aabb](const AABBEntry* a, const AABBEntry* b)
+    {
+        return reduced_aabb.key_comp()(a->first, b->first);
+    };
+    std::vector<const AABBEntry*> candidates;
+
     for (auto& influence : input_aabb)
     {
         bool merged = false;
         AABB influence_aabb = influence.second;
-        for (const auto& reduced_check : reduced_aabb)
+        candidates.clear();
+        reduced_grid.query(influence_aabb, candidates);
+        std::sort(candidates.begin(), candidates.end(), in_map_order);
+        for (const AABBEntry* candidate : candidates)
         {
+            const AABBEntry& reduced_check = *candidate;
             // As every area has to be checked for overlaps with other areas, some fast heuristic is needed to abort early if clearly possible
             // This is so performance critical that using a map lookup instead of the direct access of the cached AABBs can have a surprisingly large performance impact
             AABB aabb = reduced_check.second;
@@ -479,8 +513,13 @@ void TreeSupport::mergeHelper(
                     // negative area.).
                     //     And if this area disappears because of rounding errors, the only downside is that it can not merge again on this layer.
 
+                    reduced_grid.remove(&reduced_check, reduced_check.second);
                     reduced_aabb.erase(reduced_check.first); // This invalidates reduced_check.
-                    reduced_aabb.emplace(key, AABB(merge));
+                    const auto [merged_entry, inserted] = reduced_aabb.emplace(key, AABB(merge));
+                    if (inserted)
+                    {
+                        reduced_grid.insert(&*merged_entry, merged_entry->second);
+                    }
 
                     merged = true;
                     break;
@@ -490,7 +529,18 @@ void TreeSupport::mergeHelper(
 
         if (! merged)
         {
-            reduced_aabb[influence.first] = influence_aabb;
+            const auto existing = reduced_aabb.find(influence.first);
+            if (existing != reduced_aabb.end())
+            {
+                reduced_grid.remove(&*existing, existing->second);
+                existing->second = influence_aabb;
+                reduced_grid.insert(&*existing, existing->second);
+            }
+            else
+            {
+                const auto new_entry = reduced_aabb.emplace(influence.first, influence_aabb).first;
+                reduced_grid.insert(&*new_entry, new_entry->second);
+            }
         }
     }
 }
@@ -1252,7 +1302,7 @@ void TreeSupport::increaseAreas(
                     if (bypass_merge)
                     {
                         Polygons* new_area = new Polygons(max_influence_area);
-                        TreeSupportElement* next = new TreeSupportElement(elem, new_area);
+                        TreeSupportElement* next = element_pool_.create(elem, new_area);
                         bypass_merge_areas.emplace_back(next);
                     }
                     else
@@ -1279,7 +1329,7 @@ void TreeSupport::increaseAreas(
         });
 }
 
-void TreeSupport::createLayerPathing(std::vector<std::set<TreeSupportElement*>>& move_bounds)
+void TreeSupport::createLayerPathing(std::vector<TreeSupportElementSet>& move_bounds)
 {
     const double data_size_inverse = 1 / double(move_bounds.size());
     double progress_total = TREE_PROGRESS_PRECALC_AVO + TREE_PROGRESS_PRECALC_COLL + TREE_PROGRESS_GENERATE_NODES;
@@ -1348,12 +1398,13 @@ void TreeSupport::createLayerPathing(std::vector<std::set<TreeSupportElement*>>&
         new_element = ! move_bounds[layer_idx - 1].empty();
 
         // Save calculated elements to output, and allocate Polygons on heap, as they will not be changed again.
-        for (std::pair<TreeSupportElement, Polygons> tup : influence_areas)
+        std::vector<TreeSupportElement*> new_elements;
+        new_elements.reserve(influence_areas.size() + bypass_merge_areas.size());
+        for (const auto& [elem, area] : influence_areas)
         {
-            const TreeSupportElement elem = tup.first;
-            Polygons* new_area = new Polygons(TreeSupportUtils::safeUnion(tup.second));
-            TreeSupportElement* next = new TreeSupportElement(elem, new_area);
-            move_bounds[layer_idx - 1].emplace(next);
+            Polygons* new_area = new Polygons(TreeSupportUtils::safeUnion(area));
+            TreeSupportElement* next = element_pool_.create(elem, new_area);
+            new_elements.emplace_back(next);
 
             if (new_area->area() < 1)
             {
@@ -1368,8 +1419,11 @@ void TreeSupport::createLayerPathing(std::vector<std::set<TreeSupportElement*>>&
             {
                 spdlog::error("Insert Error of Influence area bypass on layer {}.", layer_idx - 1);
             }
-            move_bounds[layer_idx - 1].emplace(elem);
+            new_elements.emplace_back(elem);
         }
+        // The bypassed elements were created in parallel, so they are only numbered now, in an order that doesn't depend on the order in which they were created.
+        element_pool_.assignIds(new_elements);
+        move_bounds[layer_idx - 1].append(new_elements);
 
         progress_total += data_size_inverse * TREE_PROGRESS_AREA_CALC;
         Progress::messageProgress(Progress::Stage::SUPPORT, progress_total * progress_multiplier + progress_offset, TREE_PROGRESS_TOTAL);
@@ -1411,7 +1465,7 @@ void TreeSupport::setPointsOnAreas(const TreeSupportElement* elem)
     }
 }
 
-bool TreeSupport::setToModelContact(std::vector<std::set<TreeSupportElement*>>& move_bounds, TreeSupportElement* first_elem, const LayerIndex layer_idx)
+bool TreeSupport::setToModelContact(std::vector<TreeSupportElementSet>& move_bounds, TreeSupportElement* first_elem, const LayerIndex layer_idx)
 {
     if (first_elem->to_model_gracious_)
     {
@@ -1461,7 +1515,7 @@ bool TreeSupport::setToModelContact(std::vector<std::set<TreeSupportElement*>>&
                 {
                     move_bounds[layer].erase(checked[layer - layer_idx]);
                     delete checked[layer - layer_idx]->area_;
-                    delete checked[layer - layer_idx];
+                    element_pool_.release(checked[layer - layer_idx]);
                 }
                 return true;
             }
@@ -1478,7 +1532,7 @@ bool TreeSupport::setToModelContact(std::vector<std::set<TreeSupportElement*>>&
         {
             move_bounds[layer].erase(checked[layer - layer_idx]);
             delete checked[layer - layer_idx]->area_;
-            delete checked[layer - layer_idx];
+            element_pool_.release(checked[layer - layer_idx]);
         }
 
         // If resting on the buildplate keep bp location
@@ -1546,7 +1600,7 @@ bool TreeSupport::setToModelContact(std::vector<std::set<TreeSupportElement*>>&
     }
 }
 
-void TreeSupport::createNodesFromArea(std::vector<std::set<TreeSupportElement*>>& move_bounds)
+void TreeSupport::createNodesFromArea(std::vector<TreeSupportElementSet>& move_bounds)
 {
     // Initialize points on layer 0, with a "random" point in the influence area. Point is chosen based on an inaccurate estimate where the branches will split into two, but every
     // point inside the influence area would produce a valid result.
@@ -1577,11 +1631,11 @@ void TreeSupport::createNodesFromArea(std::vector<std::set<TreeSupportElement*>>
         }
     }
 
+    move_bounds[0].eraseAll(remove);
     for (TreeSupportElement* del : remove)
     {
-        move_bounds[0].erase(del);
         delete del->area_;
-        delete del;
+        element_pool_.release(del);
     }
     remove.clear();
 
@@ -1631,11 +1685,11 @@ void TreeSupport::createNodesFromArea(std::vector<std::set<TreeSupportElement*>>
         }
 
         // Delete all not needed support elements.
+        move_bounds[layer_idx].eraseAll(remove);
         for (TreeSupportElement* del : remove)
         {
-            move_bounds[layer_idx].erase(del);
             delete del->area_;
-            delete del;
+            element_pool_.release(del);
         }
         remove.clear();
     }
@@ -2296,7 +2350,7 @@ void TreeSupport::finalizeInterfaceAndSupportAreas(
         });
 }
 
-void TreeSupport::drawAreas(std::vector<std::set<TreeSupportElement*>>& move_bounds, SliceDataStorage& storage)
+void TreeSupport::drawAreas(std::vector<TreeSupportElementSet>& move_bounds, SliceDataStorage& storage)
 {
     std::vector<Polygons> support_layer_storage(move_bounds.size());
     std::vector<Polygons> support_layer_storage_fractional(move_bounds.size());
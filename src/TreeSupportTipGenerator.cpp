@@ -28,10 +28,11 @@
 namespace cura
 {
 
-TreeSupportTipGenerator::TreeSupportTipGenerator(const SliceMeshStorage& mesh, TreeModelVolumes& volumes_s)
+TreeSupportTipGenerator::TreeSupportTipGenerator(const SliceMeshStorage& mesh, TreeModelVolumes& volumes_s, TreeSupportElementPool& element_pool)
     : config_(mesh.settings)
     , use_fake_roof_(! mesh.settings.get<bool>("support_roof_enable"))
     , volumes_(volumes_s)
+    , element_pool_(element_pool)
     , minimum_support_area_(mesh.settings.get<double>("minimum_support_area"))
     , minimum_roof_area_(! use_fake_roof_ ? mesh.settings.get<double>("minimum_roof_area") : std::max(SUPPORT_TREE_MINIMUM_FAKE_ROOF_AREA, minimum_support_area_))
     , support_roof_layers_(
@@ -623,7 +624,7 @@ void TreeSupportTipGenerator::calculateRoofAreas(const cura::SliceMeshStorage& m
 
 
 void TreeSupportTipGenerator::addPointAsInfluenceArea(
-    std::vector<std::set<TreeSupportElement*>>& move_bounds,
+    std::vector<std::vector<TreeSupportElement*>>& move_bounds,
     std::pair<Point2LL, TreeSupportTipGenerator::LineStatus> p,
     size_t dtt,
     LayerIndex insert_layer,
@@ -653,7 +654,7 @@ void TreeSupportTipGenerator::addPointAsInfluenceArea(
         {
             // Normalize the point a bit to also catch points which are so close that inserting it would achieve nothing.
             already_inserted_[insert_layer].emplace(p.first / ((config_.min_radius + 1) / 10));
-            TreeSupportElement* elem = new TreeSupportElement(
+            TreeSupportElement* elem = element_pool_.create(
                 dtt,
                 insert_layer,
                 p.first,
@@ -674,14 +675,14 @@ void TreeSupportTipGenerator::addPointAsInfluenceArea(
                 elem->additional_ovalization_targets_.emplace_back(target);
             }
 
-            move_bounds[insert_layer].emplace(elem);
+            move_bounds[insert_layer].push_back(elem);
         }
     }
 }
 
 
 void TreeSupportTipGenerator::addLinesAsInfluenceAreas(
-    std::vector<std::set<TreeSupportElement*>>& move_bounds,
+    std::vector<std::vector<TreeSupportElement*>>& move_bounds,
     std::vector<TreeSupportTipGenerator::LineInformation> lines,
     size_t roof_tip_layers,
     LayerIndex insert_layer_idx,
@@ -793,7 +794,7 @@ void TreeSupportTipGenerator::addLinesAsInfluenceAreas(
 
 
 void TreeSupportTipGenerator::removeUselessAddedPoints(
-    std::vector<std::set<TreeSupportElement*>>& move_bounds,
+    std::vector<std::vector<TreeSupportElement*>>& move_bounds,
     SliceDataStorage& storage,
     std::vector<Polygons>& additional_support_areas)
 {
@@ -833,9 +834,9 @@ void TreeSupportTipGenerator::removeUselessAddedPoints(
 
                 for (auto elem : to_be_removed)
                 {
-                    move_bounds[layer_idx].erase(elem);
+                    std::erase(move_bounds[layer_idx], elem);
                     delete elem->area_;
-                    delete elem;
+                    element_pool_.release(elem);
                 }
             }
         });
@@ -845,11 +846,11 @@ void TreeSupportTipGenerator::removeUselessAddedPoints(
 void TreeSupportTipGenerator::generateTips(
     SliceDataStorage& storage,
     const SliceMeshStorage& mesh,
-    std::vector<std::set<TreeSupportElement*>>& move_bounds,
+    std::vector<TreeSupportElementSet>& move_bounds,
     std::vector<Polygons>& additional_support_areas,
     std::vector<std::vector<FakeRoofArea>>& placed_fake_roof_areas)
 {
-    std::vector<std::set<TreeSupportElement*>> new_tips(move_bounds.size());
+    std::vector<std::vector<TreeSupportElement*>> new_tips(move_bounds.size()); // Numbered once all tips are generated, see TreeSupportElementPool::assignIds.
 
     const coord_t circle_length_to_half_linewidth_change
         = config_.min_radius < config_.support_line_width ? config_.min_radius / 2 : sqrt(square(config_.min_radius) - square(config_.min_radius - config_.support_line_width / 2));
@@ -1206,7 +1207,8 @@ void TreeSupportTipGenerator::generateTips(
 
     for (auto [layer_idx, tips_on_layer] : new_tips | ranges::views::enumerate)
     {
-        move_bounds[layer_idx].insert(tips_on_layer.begin(), tips_on_layer.end());
+        element_pool_.assignIds(tips_on_layer);
+        move_bounds[layer_idx].append(tips_on_layer);
     }
 }
 
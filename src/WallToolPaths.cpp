@@ -16,6 +16,7 @@
 #include "utils/PolylineStitcher.h"
 #include "utils/Simplify.h"
 #include "utils/SparsePointGrid.h" //To stitch the inner contour.
+#include "utils/Trace.h"
 #include "utils/actions/smooth.h"
 #include "utils/polygonUtils.h"
 
@@ -73,6 +74,8 @@ WallToolPaths::WallToolPaths(
 
 const std::vector<VariableWidthLines>& WallToolPaths::generate()
 {
+    TraceSpan trace_span("WallToolPaths::generate", layer_idx_);
+
     const coord_t allowed_distance = settings_.get<coord_t>("meshfix_maximum_deviation");
 
     // Sometimes small slivers of polygons mess up the prepared_outline. By performing an open-close operation
@@ -87,7 +90,7 @@ const std::vector<VariableWidthLines>& WallToolPaths::generate()
 
     // Simplify outline for boost::voronoi consumption. Absolutely no self intersections or near-self intersections allowed:
     // TODO: Open question: Does this indeed fix all (or all-but-one-in-a-million) cases for manifold but otherwise possibly complex polygons?
-    Polygons prepared_outline = outline_.offset(-open_close_distance).offset(open_close_distance * 2).offset(-open_close_distance);
+    Polygons prepared_outline = outline_.offsetSequence({ -open_close_distance, open_close_distance * 2, -open_close_distance });
     scripta::log("prepared_outline_0", prepared_outline, section_type_, layer_idx_);
     prepared_outline.removeSmallAreas(small_area_length_ * small_area_length_, false);
     prepared_outline = Simplify(settings_).polygon(prepared_outline);
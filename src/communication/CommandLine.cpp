@@ -23,6 +23,7 @@
 #include "ExtruderTrain.h"
 #include "FffProcessor.h" //To start a slice and get time estimates.
 #include "Slice.h"
+#include "utils/Counters.h"
 #include "utils/Matrix4x3D.h" //For the mesh_rotation_matrix setting.
 #include "utils/format/filesystem_path.h"
 #include "utils/views/split_paths.h"
@@ -325,6 +326,7 @@ void CommandLine::sliceNext()
                         spdlog::error("Failed to open {} for output.", argument.c_str());
                         exit(1);
                     }
+                    Counters::setOutputFile(argument + ".counters.json");
                     break;
                 }
                 case 'g':
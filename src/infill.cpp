@@ -122,7 +122,7 @@ void Infill::generate(
         small_infill.clear();
         for (const auto& small_infill_part : small_infill_parts)
         {
-            if (small_infill_part.offset(-infill_line_width_ / 2).offset(infill_line_width_ / 2).area() < infill_line_width_ * infill_line_width_ * 10
+            if (small_infill_part.morphologicalOpen(infill_line_width_ / 2).area() < infill_line_width_ * infill_line_width_ * 10
                 && ! inner_contour_.intersection(small_infill_part.offset(infill_line_width_ / 4)).empty())
             {
                 inner_contour_.add(small_infill_part);
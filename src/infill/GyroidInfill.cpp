@@ -4,6 +4,7 @@
 #include "infill/GyroidInfill.h"
 
 #include "utils/AABB.h"
+#include "utils/PolygonsSoA.h"
 #include "utils/linearAlg2D.h"
 #include "utils/polygon.h"
 
@@ -24,6 +25,7 @@ void GyroidInfill::generateTotalGyroidInfill(Polygons& result_lines, bool zig_za
     // kudos to the author of the Slic3r implementation equation code, the equation code here is based on that
 
     const AABB aabb(in_outline);
+    const PolygonsSoA outline_view(in_outline); // Every generated vertex gets an inside check against the outline.
 
     int pitch = line_distance * 2.41; // this produces similar density to the "line" infill pattern
     int num_steps = 4;
@@ -74,7 +76,7 @@ void GyroidInfill::generateTotalGyroidInfill(Polygons& result_lines, bool zig_za
                 for (unsigned i = 0; i < num_coords; ++i)
                 {
                     Point2LL current(x + ((num_columns & 1) ? odd_line_coords[i] : even_line_coords[i]) / 2 + pitch, y + (coord_t)(i * step));
-                    bool current_inside = in_outline.inside(current, true);
+                    bool current_inside = outline_view.inside(current, true);
                     if (! is_first_point)
                     {
                         if (last_inside && current_inside)
@@ -166,7 +168,7 @@ void GyroidInfill::generateTotalGyroidInfill(Polygons& result_lines, bool zig_za
                 for (unsigned i = 0; i < num_coords; ++i)
                 {
                     Point2LL current(x + (coord_t)(i * step), y + ((num_rows & 1) ? odd_line_coords[i] : even_line_coords[i]) / 2);
-                    bool current_inside = in_outline.inside(current, true);
+                    bool current_inside = outline_view.inside(current, true);
                     if (! is_first_point)
                     {
                         if (last_inside && current_inside)
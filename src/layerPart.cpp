@@ -3,6 +3,9 @@
 
 #include "layerPart.h"
 
+#include <atomic>
+#include <mutex>
+
 #include "progress/Progress.h"
 #include "settings/EnumSettings.h" //For ESurfaceMode.
 #include "settings/Settings.h"
@@ -82,26 +85,61 @@ void createLayerWithParts(const Settings& settings, SliceLayer& storageLayer, Sl
 
 void createLayerParts(SliceMeshStorage& mesh, Slicer* slicer)
 {
-    const auto total_layers = slicer->layers.size();
-    assert(mesh.layers.size() == total_layers);
+    createLayerParts({ { &mesh, slicer } });
+}
+
+void createLayerParts(const std::vector<std::pair<SliceMeshStorage*, Slicer*>>& meshes)
+{
+    // Every layer of every mesh is a task of its own in the same parallel loop, so that meshes with few layers don't each wait for their own loop to finish.
+    std::vector<std::pair<size_t, size_t>> mesh_layers; // The index of the mesh and layer of every layer to split into parts.
+    std::vector<std::atomic<size_t>> layers_left(meshes.size()); // For each mesh, how many of its layers are still to be split, to report progress once it is done.
+    size_t finished_meshes = 0;
+    for (size_t mesh_idx = 0; mesh_idx < meshes.size(); ++mesh_idx)
+    {
+        const auto& [mesh, slicer] = meshes[mesh_idx];
+        assert(mesh->layers.size() == slicer->layers.size());
+        for (size_t layer_nr = 0; layer_nr < slicer->layers.size(); ++layer_nr)
+        {
+            mesh_layers.emplace_back(mesh_idx, layer_nr);
+        }
+        layers_left[mesh_idx] = slicer->layers.size();
+        if (slicer->layers.empty())
+        {
+            ++finished_meshes;
+        }
+    }
+    std::mutex progress_mutex;
 
     cura::parallel_for<size_t>(
         0,
-        total_layers,
-        [slicer, &mesh](size_t layer_nr)
+        mesh_layers.size(),
+        [&meshes, &mesh_layers, &layers_left, &finished_meshes, &progress_mutex](size_t task_idx)
         {
-            SliceLayer& layer_storage = mesh.layers[layer_nr];
+            const auto [mesh_idx, layer_nr] = mesh_layers[task_idx];
+            const auto& [mesh, slicer] = meshes[mesh_idx];
+            SliceLayer& layer_storage = mesh->layers[layer_nr];
             SlicerLayer& slice_layer = slicer->layers[layer_nr];
-            createLayerWithParts(mesh.settings, layer_storage, &slice_layer);
+            createLayerWithParts(mesh->settings, layer_storage, &slice_layer);
+            slice_layer = SlicerLayer(); // The sliced polygons aren't needed anymore. Freeing them right away keeps the slicers of all meshes from piling up.
+
+            if (layers_left[mesh_idx].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            { // This was the last layer of the mesh.
+                std::lock_guard<std::mutex> lock(progress_mutex); // So that no two threads message progress at the same time.
+                ++finished_meshes;
+                Progress::messageProgress(Progress::Stage::PARTS, finished_meshes, meshes.size());
+            }
         });
 
-    for (LayerIndex layer_nr = total_layers - 1; layer_nr >= 0; layer_nr--)
+    for (const auto& [mesh, slicer] : meshes)
     {
-        SliceLayer& layer_storage = mesh.layers[layer_nr];
-        if (layer_storage.parts.size() > 0 || (mesh.settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL && layer_storage.openPolyLines.size() > 0))
+        for (LayerIndex layer_nr = mesh->layers.size() - 1; layer_nr >= 0; layer_nr--)
         {
-            mesh.layer_nr_max_filled_layer = layer_nr; // last set by the highest non-empty layer
-            break;
+            SliceLayer& layer_storage = mesh->layers[layer_nr];
+            if (layer_storage.parts.size() > 0 || (mesh->settings.get<ESurfaceMode>("magic_mesh_surface_mode") != ESurfaceMode::NORMAL && layer_storage.openPolyLines.size() > 0))
+            {
+                mesh->layer_nr_max_filled_layer = layer_nr; // last set by the highest non-empty layer
+                break;
+            }
         }
     }
 }
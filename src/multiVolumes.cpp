@@ -10,11 +10,85 @@
 #include "settings/EnumSettings.h"
 #include "settings/types/LayerIndex.h"
 #include "slicer.h"
+#include "utils/AABB.h"
+#include "utils/AABB3D.h"
 #include "utils/PolylineStitcher.h"
+#include "utils/ThreadPool.h"
 
 namespace cura
 {
 
+namespace
+{
+
+/*!
+ * Find which of a set of bounding boxes overlap, by sweeping along the X axis.
+ *
+ * Invalid bounding boxes (for instance of empty layers) don't overlap with anything.
+ *
+ * \param boxes The bounding boxes to test against each other.
+ * \return For each box, the indices of the boxes that come before it in \p boxes and overlap with it, in ascending order.
+ */
+std::vector<std::vector<size_t>> findOverlappingBoxes(const std::vector<AABB>& boxes)
+{
+    std::vector<size_t> order;
+    order.reserve(boxes.size());
+    for (size_t idx = 0; idx < boxes.size(); ++idx)
+    {
+        if (boxes[idx].min_.X <= boxes[idx].max_.X && boxes[idx].min_.Y <= boxes[idx].max_.Y)
+        {
+            order.push_back(idx);
+        }
+    }
+    std::sort(
+        order.begin(),
+        order.end(),
+        [&boxes](const size_t a, const size_t b)
+        {
+            return boxes[a].min_.X < boxes[b].min_.X;
+        });
+
+    std::vector<std::vector<size_t>> overlapping(boxes.size());
+    std::vector<size_t> active; // Boxes that may still overlap with the rest of the sweep in the X direction.
+    for (const size_t idx : order)
+    {
+        const AABB& box = boxes[idx];
+        std::erase_if(
+            active,
+            [&boxes, &box](const size_t other)
+            {
+                return boxes[other].max_.X < box.min_.X;
+            });
+        for (const size_t other : active)
+        {
+            if (box.hit(boxes[other]))
+            {
+                overlapping[std::max(idx, other)].push_back(std::min(idx, other));
+            }
+        }
+        active.push_back(idx);
+    }
+    for (std::vector<size_t>& earlier : overlapping)
+    {
+        std::sort(earlier.begin(), earlier.end());
+    }
+    return overlapping;
+}
+
+/*!
+ * Bounding box of one layer of a volume, or an invalid bounding box if the volume doesn't have that layer.
+ */
+AABB layerBoundingBox(const Slicer& volume, const size_t layer_nr)
+{
+    if (layer_nr >= volume.layers.size())
+    {
+        return AABB();
+    }
+    return AABB(volume.layers[layer_nr].polygons);
+}
+
+} // namespace
+
 void carveMultipleVolumes(std::vector<Slicer*>& volumes)
 {
     // Go trough all the volumes, and remove the previous volume outlines from our own outline, so we never have overlapped areas.
@@ -27,41 +101,58 @@ void carveMultipleVolumes(std::vector<Slicer*>& volumes)
         {
             return volume_1->mesh->settings_.get<int>("infill_mesh_order") < volume_2->mesh->settings_.get<int>("infill_mesh_order");
         });
-    for (unsigned int volume_1_idx = 1; volume_1_idx < volumes.size(); volume_1_idx++)
+
+    std::vector<Slicer*> carved_volumes;
+    std::vector<int> mesh_orders;
+    size_t layer_count = 0;
+    for (Slicer* volume : ranked_volumes)
     {
-        Slicer& volume_1 = *ranked_volumes[volume_1_idx];
-        if (volume_1.mesh->settings_.get<bool>("infill_mesh") || volume_1.mesh->settings_.get<bool>("anti_overhang_mesh") || volume_1.mesh->settings_.get<bool>("support_mesh")
-            || volume_1.mesh->settings_.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::SURFACE)
+        if (volume->mesh->settings_.get<bool>("infill_mesh") || volume->mesh->settings_.get<bool>("anti_overhang_mesh") || volume->mesh->settings_.get<bool>("support_mesh")
+            || volume->mesh->settings_.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::SURFACE)
         {
             continue;
         }
-        for (unsigned int volume_2_idx = 0; volume_2_idx < volume_1_idx; volume_2_idx++)
+        carved_volumes.push_back(volume);
+        mesh_orders.push_back(volume->mesh->settings_.get<int>("infill_mesh_order"));
+        layer_count = std::max(layer_count, volume->layers.size());
+    }
+    if (carved_volumes.size() < 2)
+    {
+        return;
+    }
+
+    // Every layer is carved independently. Within a layer, the volumes are carved in the same order as they would be pair by pair, but only pairs whose outlines on that
+    // layer can overlap at all are carved.
+    cura::parallel_for<size_t>(
+        0,
+        layer_count,
+        [&](const size_t layer_nr)
         {
-            Slicer& volume_2 = *ranked_volumes[volume_2_idx];
-            if (volume_2.mesh->settings_.get<bool>("infill_mesh") || volume_2.mesh->settings_.get<bool>("anti_overhang_mesh") || volume_2.mesh->settings_.get<bool>("support_mesh")
-                || volume_2.mesh->settings_.get<ESurfaceMode>("magic_mesh_surface_mode") == ESurfaceMode::SURFACE)
+            std::vector<AABB> boxes;
+            boxes.reserve(carved_volumes.size());
+            for (const Slicer* volume : carved_volumes)
             {
-                continue;
+                boxes.push_back(layerBoundingBox(*volume, layer_nr)); // Carving only shrinks the outlines, so these boxes stay valid while carving this layer.
             }
-            if (! volume_1.mesh->getAABB().hit(volume_2.mesh->getAABB()))
-            {
-                continue;
-            }
-            for (LayerIndex layerNr = 0; layerNr < volume_1.layers.size(); layerNr++)
+            const std::vector<std::vector<size_t>> overlapping = findOverlappingBoxes(boxes);
+
+            for (size_t volume_1_idx = 1; volume_1_idx < carved_volumes.size(); volume_1_idx++)
             {
-                SlicerLayer& layer1 = volume_1.layers[layerNr];
-                SlicerLayer& layer2 = volume_2.layers[layerNr];
-                if (alternate_carve_order && layerNr % 2 == 0 && volume_1.mesh->settings_.get<int>("infill_mesh_order") == volume_2.mesh->settings_.get<int>("infill_mesh_order"))
-                {
-                    layer2.polygons = layer2.polygons.difference(layer1.polygons);
-                }
-                else
+                for (const size_t volume_2_idx : overlapping[volume_1_idx])
                 {
-                    layer1.polygons = layer1.polygons.difference(layer2.polygons);
+                    SlicerLayer& layer1 = carved_volumes[volume_1_idx]->layers[layer_nr];
+                    SlicerLayer& layer2 = carved_volumes[volume_2_idx]->layers[layer_nr];
+                    if (alternate_carve_order && layer_nr % 2 == 0 && mesh_orders[volume_1_idx] == mesh_orders[volume_2_idx])
+                    {
+                        layer2.polygons = layer2.polygons.difference(layer1.polygons);
+                    }
+                    else
+                    {
+                        layer1.polygons = layer1.polygons.difference(layer2.polygons);
+                    }
                 }
             }
-        }
-    }
+        });
 }
 
 // Expand each layer a bit and then keep the extra overlapping parts that overlap with other volumes.
@@ -73,37 +164,99 @@ void generateMultipleVolumesOverlap(std::vector<Slicer*>& volumes)
         return;
     }
 
-    int offset_to_merge_other_merged_volumes = 20;
-    for (Slicer* volume : volumes)
+    constexpr coord_t offset_to_merge_other_merged_volumes = 20;
+
+    // Offsetting with miter joins can move vertices further than the offset distance (up to the miter limit of 1.2 times as far), so the bounding boxes used to skip
+    // volumes that can't overlap on a layer are expanded by a generous margin.
+    constexpr coord_t bounding_box_margin_factor = 2;
+
+    struct OverlappingVolume
+    {
+        size_t volume_idx;
+        ClipperLib::PolyFillType fill_type;
+        coord_t overlap;
+        std::vector<size_t> others; //!< The volumes whose bounding box is close enough to overlap with this one.
+    };
+    std::vector<OverlappingVolume> overlapping_volumes;
+    std::vector<bool> is_other_volume(volumes.size()); // Whether a volume is a normal mesh, that other volumes can overlap into.
+    size_t layer_count = 0;
+    for (size_t volume_idx = 0; volume_idx < volumes.size(); ++volume_idx)
     {
+        const Slicer* volume = volumes[volume_idx];
+        is_other_volume[volume_idx]
+            = ! (volume->mesh->settings_.get<bool>("infill_mesh") || volume->mesh->settings_.get<bool>("anti_overhang_mesh") || volume->mesh->settings_.get<bool>("support_mesh"));
+        layer_count = std::max(layer_count, volume->layers.size());
+    }
+    for (size_t volume_idx = 0; volume_idx < volumes.size(); ++volume_idx)
+    {
+        const Slicer* volume = volumes[volume_idx];
         ClipperLib::PolyFillType fill_type = volume->mesh->settings_.get<bool>("meshfix_union_all") ? ClipperLib::pftNonZero : ClipperLib::pftEvenOdd;
 
         coord_t overlap = volume->mesh->settings_.get<coord_t>("multiple_mesh_overlap");
-        if (volume->mesh->settings_.get<bool>("infill_mesh") || volume->mesh->settings_.get<bool>("anti_overhang_mesh") || volume->mesh->settings_.get<bool>("support_mesh")
-            || overlap == 0)
+        if (! is_other_volume[volume_idx] || overlap == 0)
         {
             continue;
         }
         AABB3D aabb(volume->mesh->getAABB());
         aabb.expandXY(overlap); // expand to account for the case where two models and their bounding boxes are adjacent along the X or Y-direction
-        for (LayerIndex layer_nr = 0; layer_nr < volume->layers.size(); layer_nr++)
+        std::vector<size_t> others;
+        for (size_t other_idx = 0; other_idx < volumes.size(); ++other_idx)
         {
-            Polygons all_other_volumes;
-            for (Slicer* other_volume : volumes)
+            if (is_other_volume[other_idx] && other_idx != volume_idx && volumes[other_idx]->mesh->getAABB().hit(aabb))
             {
-                if (other_volume->mesh->settings_.get<bool>("infill_mesh") || other_volume->mesh->settings_.get<bool>("anti_overhang_mesh")
-                    || other_volume->mesh->settings_.get<bool>("support_mesh") || ! other_volume->mesh->getAABB().hit(aabb) || other_volume == volume)
+                others.push_back(other_idx);
+            }
+        }
+        overlapping_volumes.push_back(OverlappingVolume{ volume_idx, fill_type, overlap, std::move(others) });
+    }
+    if (overlapping_volumes.empty())
+    {
+        return;
+    }
+
+    // Every layer is processed independently. Within a layer the volumes are processed in order, since each volume sees the overlap that was added to the volumes before it.
+    cura::parallel_for<size_t>(
+        0,
+        layer_count,
+        [&](const size_t layer_nr)
+        {
+            std::vector<AABB> boxes;
+            boxes.reserve(volumes.size());
+            for (const Slicer* volume : volumes)
+            {
+                boxes.push_back(layerBoundingBox(*volume, layer_nr));
+            }
+
+            for (const OverlappingVolume& overlapping : overlapping_volumes)
+            {
+                Slicer& volume = *volumes[overlapping.volume_idx];
+                if (layer_nr >= volume.layers.size())
                 {
                     continue;
                 }
-                SlicerLayer& other_volume_layer = other_volume->layers[layer_nr];
-                all_other_volumes = all_other_volumes.unionPolygons(other_volume_layer.polygons.offset(offset_to_merge_other_merged_volumes), fill_type);
-            }
+                SlicerLayer& volume_layer = volume.layers[layer_nr];
+                const coord_t expanded_distance = std::abs(overlapping.overlap / 2);
+                AABB expanded_box(volume_layer.polygons);
+                if (expanded_box.min_.X <= expanded_box.max_.X)
+                {
+                    expanded_box.expand(bounding_box_margin_factor * (expanded_distance + offset_to_merge_other_merged_volumes));
+                }
 
-            SlicerLayer& volume_layer = volume->layers[layer_nr];
-            volume_layer.polygons = volume_layer.polygons.unionPolygons(all_other_volumes.intersection(volume_layer.polygons.offset(overlap / 2)), fill_type);
-        }
-    }
+                Polygons all_other_volumes;
+                for (const size_t other_idx : overlapping.others)
+                {
+                    if (layer_nr >= volumes[other_idx]->layers.size() || ! boxes[other_idx].hit(expanded_box))
+                    {
+                        continue; // Can't intersect with the expanded outline of this volume, so it doesn't change the result.
+                    }
+                    SlicerLayer& other_volume_layer = volumes[other_idx]->layers[layer_nr];
+                    all_other_volumes = all_other_volumes.unionPolygons(other_volume_layer.polygons.offset(offset_to_merge_other_merged_volumes), overlapping.fill_type);
+                }
+
+                volume_layer.polygons = volume_layer.polygons.unionPolygons(all_other_volumes.intersection(volume_layer.polygons.offset(overlapping.overlap / 2)), overlapping.fill_type);
+                boxes[overlapping.volume_idx] = AABB(volume_layer.polygons); // This volume grew, so the volumes after it may overlap with more of it.
+            }
+        });
 }
 
 void MultiVolumes::carveCuttingMeshes(std::vector<Slicer*>& volumes, const std::vector<Mesh>& meshes)
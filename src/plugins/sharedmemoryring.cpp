@@ -0,0 +1,299 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher
+
+#include "plugins/sharedmemoryring.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "utils/polygon.h"
+
+namespace cura::plugins
+{
+
+static_assert(std::is_trivially_copyable_v<Point2LL>, "Points are copied into the ring as raw bytes.");
+
+namespace
+{
+
+constexpr size_t size_field = sizeof(uint64_t);
+
+/**
+ * @brief The size of polygons in the flat layout.
+ */
+size_t flatSize(const Polygons& polygons)
+{
+    return size_field * (1 + polygons.size()) + polygons.pointCount() * sizeof(Point2LL);
+}
+
+} // namespace
+
+SharedMemoryRing SharedMemoryRing::create(const std::string& name, size_t capacity)
+{
+    capacity = (capacity + size_field - 1) / size_field * size_field;
+    boost::interprocess::shared_memory_object::remove(name.c_str());
+    boost::interprocess::shared_memory_object shared_memory(boost::interprocess::create_only, name.c_str(), boost::interprocess::read_write);
+    shared_memory.truncate(static_cast<boost::interprocess::offset_t>(sizeof(Header) + capacity));
+
+    SharedMemoryRing ring(name, std::move(shared_memory), true);
+    ring.header_ = new (ring.region_.get_address()) Header{};
+    ring.header_->push_position.store(0, std::memory_order_relaxed);
+    ring.header_->pop_position.store(0, std::memory_order_relaxed);
+    ring.header_->capacity = capacity;
+    return ring;
+}
+
+SharedMemoryRing SharedMemoryRing::open(const std::string& name)
+{
+    boost::interprocess::shared_memory_object shared_memory(boost::interprocess::open_only, name.c_str(), boost::interprocess::read_write);
+    SharedMemoryRing ring(name, std::move(shared_memory), false);
+    if (ring.region_.get_size() < sizeof(Header) || ring.header_->capacity > ring.region_.get_size() - sizeof(Header))
+    {
+        throw std::runtime_error(fmt::format("Shared memory '{}' is not a ring buffer.", name));
+    }
+    return ring;
+}
+
+SharedMemoryRing::SharedMemoryRing(std::string name, boost::interprocess::shared_memory_object shared_memory, bool is_owner)
+    : name_(std::move(name))
+    , shared_memory_(std::move(shared_memory))
+    , region_(shared_memory_, boost::interprocess::read_write)
+    , header_(static_cast<Header*>(region_.get_address()))
+    , data_(static_cast<std::byte*>(region_.get_address()) + sizeof(Header))
+    , is_owner_(is_owner)
+{
+}
+
+SharedMemoryRing::SharedMemoryRing(SharedMemoryRing&& other) noexcept
+    : name_(std::move(other.name_))
+    , shared_memory_(std::move(other.shared_memory_))
+    , region_(std::move(other.region_))
+    , header_(std::exchange(other.header_, nullptr))
+    , data_(std::exchange(other.data_, nullptr))
+    , is_owner_(std::exchange(other.is_owner_, false))
+{
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    if (is_owner_)
+    {
+        boost::interprocess::shared_memory_object::remove(name_.c_str()); // Processes that still have it mapped keep their mapping.
+    }
+}
+
+size_t SharedMemoryRing::capacity() const noexcept
+{
+    return header_->capacity;
+}
+
+size_t SharedMemoryRing::recordSize(size_t payload_size) noexcept
+{
+    return size_field + (payload_size + size_field - 1) / size_field * size_field;
+}
+
+void SharedMemoryRing::write(uint64_t position, const void* source, size_t size) noexcept
+{
+    const size_t offset = position % header_->capacity;
+    const size_t first_part = std::min(size, header_->capacity - offset);
+    std::memcpy(data_ + offset, source, first_part);
+    std::memcpy(data_, static_cast<const std::byte*>(source) + first_part, size - first_part);
+}
+
+void SharedMemoryRing::read(uint64_t position, void* destination, size_t size) const noexcept
+{
+    const size_t offset = position % header_->capacity;
+    const size_t first_part = std::min(size, header_->capacity - offset);
+    std::memcpy(destination, data_ + offset, first_part);
+    std::memcpy(static_cast<std::byte*>(destination) + first_part, data_, size - first_part);
+}
+
+bool SharedMemoryRing::reserve(size_t payload_size, uint64_t& position) const noexcept
+{
+    position = header_->push_position.load(std::memory_order_relaxed); // Only this side writes it.
+    const uint64_t used = position - header_->pop_position.load(std::memory_order_acquire);
+    return recordSize(payload_size) <= header_->capacity - used;
+}
+
+bool SharedMemoryRing::peek(uint64_t& position, uint64_t& payload_size) const noexcept
+{
+    position = header_->pop_position.load(std::memory_order_relaxed); // Only this side writes it.
+    if (position == header_->push_position.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+    read(position, &payload_size, size_field);
+    return true;
+}
+
+bool SharedMemoryRing::tryPush(std::span<const std::byte> message)
+{
+    uint64_t position;
+    if (! reserve(message.size(), position))
+    {
+        return false;
+    }
+    const uint64_t payload_size = message.size();
+    write(position, &payload_size, size_field);
+    write(position + size_field, message.data(), message.size());
+    header_->push_position.store(position + recordSize(message.size()), std::memory_order_release);
+    return true;
+}
+
+bool SharedMemoryRing::tryPush(const Polygons& polygons)
+{
+    const size_t payload_size = flatSize(polygons);
+    uint64_t position;
+    if (! reserve(payload_size, position))
+    {
+        return false;
+    }
+    uint64_t cursor = position;
+    const auto write_field = [this, &cursor](const uint64_t value)
+    {
+        write(cursor, &value, size_field);
+        cursor += size_field;
+    };
+    write_field(payload_size);
+    write_field(polygons.size());
+    for (ConstPolygonRef polygon : polygons)
+    {
+        write_field(polygon.size());
+    }
+    for (ConstPolygonRef polygon : polygons)
+    {
+        write(cursor, (*polygon).data(), polygon.size() * sizeof(Point2LL));
+        cursor += polygon.size() * sizeof(Point2LL);
+    }
+    header_->push_position.store(position + recordSize(payload_size), std::memory_order_release);
+    return true;
+}
+
+bool SharedMemoryRing::tryPop(std::vector<std::byte>& message)
+{
+    uint64_t position;
+    uint64_t payload_size;
+    if (! peek(position, payload_size))
+    {
+        return false;
+    }
+    message.resize(payload_size);
+    read(position + size_field, message.data(), payload_size);
+    header_->pop_position.store(position + recordSize(payload_size), std::memory_order_release);
+    return true;
+}
+
+bool SharedMemoryRing::tryPop(Polygons& polygons)
+{
+    uint64_t position;
+    uint64_t payload_size;
+    if (! peek(position, payload_size))
+    {
+        return false;
+    }
+    uint64_t cursor = position + size_field;
+    const auto read_field = [this, &cursor]()
+    {
+        uint64_t value;
+        read(cursor, &value, size_field);
+        cursor += size_field;
+        return value;
+    };
+    // The counts come from the other process, so check that they describe exactly the payload before allocating anything for them.
+    const auto reject = [this, position, payload_size](const std::string_view reason)
+    {
+        header_->pop_position.store(position + recordSize(payload_size), std::memory_order_release);
+        throw std::runtime_error(fmt::format("Dropped malformed polygons message of {} bytes from shared memory ring '{}': {}.", payload_size, name_, reason));
+    };
+    if (payload_size < size_field || payload_size > header_->capacity)
+    {
+        reject("the payload size is out of range");
+    }
+    const uint64_t polygon_count = read_field();
+    if (polygon_count > payload_size / size_field - 1)
+    {
+        reject("there are more polygons than fit in the payload");
+    }
+    std::vector<uint64_t> vertex_counts;
+    vertex_counts.reserve(polygon_count);
+    uint64_t expected_size = size_field * (1 + polygon_count);
+    for (uint64_t polygon_idx = 0; polygon_idx < polygon_count; ++polygon_idx)
+    {
+        const uint64_t vertex_count = read_field();
+        if (vertex_count > (payload_size - expected_size) / sizeof(Point2LL))
+        {
+            reject("there are more vertices than fit in the payload");
+        }
+        expected_size += vertex_count * sizeof(Point2LL);
+        vertex_counts.push_back(vertex_count);
+    }
+    if (expected_size != payload_size)
+    {
+        reject(fmt::format("the polygons take {} bytes", expected_size));
+    }
+
+    polygons.clear();
+    polygons.reserve(polygon_count);
+    for (const uint64_t vertex_count : vertex_counts)
+    {
+        (*polygons.newPoly()).resize(vertex_count);
+    }
+    for (PolygonRef polygon : polygons)
+    {
+        read(cursor, (*polygon).data(), polygon.size() * sizeof(Point2LL));
+        cursor += polygon.size() * sizeof(Point2LL);
+    }
+    header_->pop_position.store(position + recordSize(payload_size), std::memory_order_release);
+    return true;
+}
+
+void SharedMemoryRing::push(std::span<const std::byte> message)
+{
+    if (recordSize(message.size()) > capacity())
+    {
+        throw std::length_error(fmt::format("Message of {} bytes doesn't fit in shared memory ring '{}' of {} bytes.", message.size(), name_, capacity()));
+    }
+    while (! tryPush(message))
+    {
+        std::this_thread::yield();
+    }
+}
+
+void SharedMemoryRing::push(const Polygons& polygons)
+{
+    if (recordSize(flatSize(polygons)) > capacity())
+    {
+        throw std::length_error(fmt::format("Polygons of {} bytes don't fit in shared memory ring '{}' of {} bytes.", flatSize(polygons), name_, capacity()));
+    }
+    while (! tryPush(polygons))
+    {
+        std::this_thread::yield();
+    }
+}
+
+void SharedMemoryRing::pop(std::vector<std::byte>& message)
+{
+    while (! tryPop(message))
+    {
+        std::this_thread::yield();
+    }
+}
+
+void SharedMemoryRing::pop(Polygons& polygons)
+{
+    while (! tryPop(polygons))
+    {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace cura::plugins
@@ -18,6 +18,7 @@ namespace cura
 std::array<double, N_PROGRESS_STAGES> Progress::accumulated_times = { -1 };
 double Progress::total_timing = -1;
 std::optional<LayerIndex> Progress::first_skipped_layer{};
+std::array<double, N_PROGRESS_STAGES> Progress::stage_durations{};
 
 double Progress::calcOverallProgress(Stage stage, double stage_progress)
 {
@@ -49,7 +50,9 @@ void Progress::messageProgressStage(Progress::Stage stage, TimeKeeper* time_keep
     {
         if (static_cast<int>(stage) > 0)
         {
-            spdlog::info("Progress: {} accomplished in {:03.3f}s", names.at(static_cast<size_t>(stage) - 1), time_keeper->restart());
+            const double duration = time_keeper->restart();
+            stage_durations.at(static_cast<size_t>(stage) - 1) += duration;
+            spdlog::info("Progress: {} accomplished in {:03.3f}s", names.at(static_cast<size_t>(stage) - 1), duration);
         }
         else
         {
@@ -104,4 +107,14 @@ void Progress::messageProgressLayer(LayerIndex layer_nr, size_t total_layers, do
     }
 }
 
+const std::array<double, N_PROGRESS_STAGES>& Progress::getStageDurations()
+{
+    return stage_durations;
+}
+
+std::string_view Progress::getStageName(Stage stage)
+{
+    return names.at(static_cast<size_t>(stage));
+}
+
 } // namespace cura
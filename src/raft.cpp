@@ -107,10 +107,10 @@ void Raft::generate(SliceDataStorage& storage)
         else
         {
             // Closing operation for smoothing:
-            outline = outline.offset(smoothing, ClipperLib::jtRound).offset(-smoothing, ClipperLib::jtRound);
+            outline = outline.morphologicalClose(smoothing, ClipperLib::jtRound);
 
             // Opening operation to get rid of articfacts created by the closing operation:
-            outline = outline.offset(-line_width, ClipperLib::jtRound).offset(line_width, ClipperLib::jtRound);
+            outline = outline.morphologicalOpen(line_width, ClipperLib::jtRound);
         }
     };
     const auto nominal_raft_line_width = settings.get<coord_t>("skirt_brim_line_width");
@@ -26,6 +26,7 @@
 #include "settings/types/Ratio.h" //For ratio settings and percentages.
 #include "settings/types/Temperature.h" //For temperature settings.
 #include "settings/types/Velocity.h" //For velocity settings.
+#include "utils/Counters.h"
 #include "utils/Matrix4x3D.h"
 #include "utils/polygon.h"
 #include "utils/string.h" //For Escaped.
@@ -54,6 +55,8 @@ void Settings::add(const std::string& key, const std::string value)
 template<>
 std::string Settings::get<std::string>(const std::string& key) const
 {
+    Counters::add(Counter::SETTINGS_GET_CALLS);
+
     // If this settings base has a setting value for it, look that up.
     if (settings.find(key) != settings.end())
     {
@@ -33,7 +33,7 @@ coord_t SkinInfillAreaComputation::getSkinLineWidth(const SliceMeshStorage& mesh
     return skin_line_width;
 }
 
-SkinInfillAreaComputation::SkinInfillAreaComputation(const LayerIndex& layer_nr, SliceMeshStorage& mesh, bool process_infill)
+SkinInfillAreaComputation::SkinInfillAreaComputation(const LayerIndex& layer_nr, SliceMeshStorage& mesh, bool process_infill, const LayerRangeIntersection* outline_intersections)
     : layer_nr_(layer_nr)
     , mesh_(mesh)
     , bottom_layer_count_(mesh.settings.get<size_t>("bottom_layers"))
@@ -46,9 +46,28 @@ SkinInfillAreaComputation::SkinInfillAreaComputation(const LayerIndex& layer_nr,
     , bottom_skin_preshrink_(mesh.settings.get<coord_t>("bottom_skin_preshrink"))
     , top_skin_expand_distance_(mesh.settings.get<coord_t>("top_skin_expand_distance"))
     , bottom_skin_expand_distance_(mesh.settings.get<coord_t>("bottom_skin_expand_distance"))
+    , outline_intersections_(outline_intersections)
 {
 }
 
+std::optional<LayerRangeIntersection> SkinInfillAreaComputation::buildOutlineIntersections(const SliceMeshStorage& mesh)
+{
+    const size_t max_range_length = std::max(mesh.settings.get<size_t>("bottom_layers"), mesh.settings.get<size_t>("top_layers"));
+    if (mesh.settings.get<bool>("skin_no_small_gaps_heuristic") || max_range_length < 2)
+    {
+        return std::nullopt; // Only single layers are looked at, which doesn't need any intersections.
+    }
+    std::vector<Polygons> outlines(mesh.layers.size());
+    for (size_t layer_nr = 0; layer_nr < mesh.layers.size(); ++layer_nr)
+    {
+        for (const SliceLayerPart& part : mesh.layers[layer_nr].parts)
+        {
+            outlines[layer_nr].add(part.outline);
+        }
+    }
+    return LayerRangeIntersection(std::move(outlines), max_range_length);
+}
+
 /*
  * This function is executed in a parallel region based on layer_nr.
  * When modifying make sure any changes does not introduce data races.
@@ -73,6 +92,19 @@ Polygons SkinInfillAreaComputation::getOutlineOnLayer(const SliceLayerPart& part
     return result;
 }
 
+Polygons SkinInfillAreaComputation::getAreaNearPart(const SliceLayerPart& part_here, const Polygons& area)
+{
+    Polygons result;
+    for (ConstPolygonRef poly : area)
+    {
+        if (part_here.boundaryBox.hit(AABB(poly)))
+        {
+            result.add(poly);
+        }
+    }
+    return result;
+}
+
 /*
  * This function is executed in a parallel region based on layer_nr.
  * When modifying make sure any changes does not introduce data races.
@@ -182,12 +214,25 @@ void SkinInfillAreaComputation::calculateBottomSkin(const SliceLayerPart& part,
         return; // don't subtract anything form the downskin
     }
     LayerIndex bottom_check_start_layer_idx{ std::max(LayerIndex{ 0 }, LayerIndex{ layer_nr_ - bottom_layer_count_ }) };
-    Polygons not_air = getOutlineOnLayer(part, bottom_check_start_layer_idx);
-    if (! no_small_gaps_heuristic_)
+    Polygons not_air;
+    if (outline_intersections_ != nullptr && ! no_small_gaps_heuristic_)
+    {
+        if (! not_air_below_)
+        {
+            const LayerIndex bottom_check_end_layer_idx = std::max(bottom_check_start_layer_idx, LayerIndex{ layer_nr_ - 1 });
+            not_air_below_ = outline_intersections_->query(bottom_check_start_layer_idx, bottom_check_end_layer_idx);
+        }
+        not_air = getAreaNearPart(part, *not_air_below_);
+    }
+    else
     {
-        for (int downskin_layer_nr = bottom_check_start_layer_idx + 1; downskin_layer_nr < layer_nr_; downskin_layer_nr++)
+        not_air = getOutlineOnLayer(part, bottom_check_start_layer_idx);
+        if (! no_small_gaps_heuristic_)
         {
-            not_air = not_air.intersection(getOutlineOnLayer(part, downskin_layer_nr));
+            for (int downskin_layer_nr = bottom_check_start_layer_idx + 1; downskin_layer_nr < layer_nr_; downskin_layer_nr++)
+            {
+                not_air = not_air.intersection(getOutlineOnLayer(part, downskin_layer_nr));
+            }
         }
     }
     const double min_infill_area = mesh_.settings.get<double>("min_infill_area");
@@ -207,12 +252,24 @@ void SkinInfillAreaComputation::calculateTopSkin(const SliceLayerPart& part, Pol
         return;
     }
 
-    Polygons not_air = getOutlineOnLayer(part, layer_nr_ + top_layer_count_);
-    if (! no_small_gaps_heuristic_)
+    Polygons not_air;
+    if (outline_intersections_ != nullptr && ! no_small_gaps_heuristic_)
+    {
+        if (! not_air_above_)
+        {
+            not_air_above_ = outline_intersections_->query(layer_nr_ + 1, layer_nr_ + top_layer_count_);
+        }
+        not_air = getAreaNearPart(part, *not_air_above_);
+    }
+    else
     {
-        for (int upskin_layer_nr = layer_nr_ + 1; upskin_layer_nr < layer_nr_ + top_layer_count_; upskin_layer_nr++)
+        not_air = getOutlineOnLayer(part, layer_nr_ + top_layer_count_);
+        if (! no_small_gaps_heuristic_)
         {
-            not_air = not_air.intersection(getOutlineOnLayer(part, upskin_layer_nr));
+            for (int upskin_layer_nr = layer_nr_ + 1; upskin_layer_nr < layer_nr_ + top_layer_count_; upskin_layer_nr++)
+            {
+                not_air = not_air.intersection(getOutlineOnLayer(part, upskin_layer_nr));
+            }
         }
     }
 
@@ -242,13 +299,13 @@ void SkinInfillAreaComputation::applySkinExpansion(const Polygons& original_outl
         // The expansion is only applied to that opened shape.
         if (bottom_skin_expand_distance_ != 0)
         {
-            const Polygons expanded = downskin.offset(-min_width).offset(min_width + bottom_skin_expand_distance_);
+            const Polygons expanded = downskin.offsetSequence({ -min_width, min_width + bottom_skin_expand_distance_ });
             // And then re-joined with the original part that was not offset, to retain parts smaller than min_width.
             downskin = downskin.unionPolygons(expanded);
         }
         if (top_skin_expand_distance_ != 0)
         {
-            const Polygons expanded = upskin.offset(-min_width).offset(min_width + top_skin_expand_distance_);
+            const Polygons expanded = upskin.offsetSequence({ -min_width, min_width + top_skin_expand_distance_ });
             upskin = upskin.unionPolygons(expanded);
         }
     }
@@ -291,7 +348,7 @@ void SkinInfillAreaComputation::applySkinExpansion(const Polygons& original_outl
     }
     if (top_skin_preshrink_ > 0 || (min_width == 0 && top_skin_expand_distance_ != 0))
     {
-        upskin = upskin.offset(-top_skin_preshrink_ / 2, ClipperLib::jtMiter, MITER_LIMIT).offset(top_skin_preshrink_ / 2, ClipperLib::jtMiter, MITER_LIMIT);
+        upskin = upskin.morphologicalOpen(top_skin_preshrink_ / 2, ClipperLib::jtMiter, MITER_LIMIT);
         should_top_be_clipped = true; // Rounding errors can lead to propagation of errors. This could mean that skin goes beyond the original outline
     }
 
@@ -591,7 +648,7 @@ void SkinInfillAreaComputation::combineInfillLayers(SliceMeshStorage& mesh)
                     {
                         if (part.boundaryBox.hit(lower_layer_part.boundaryBox))
                         {
-                            Polygons intersection = infill_area_per_combine[combine_count_here - 1].intersection(lower_layer_part.infill_area).offset(-200).offset(200);
+                            Polygons intersection = infill_area_per_combine[combine_count_here - 1].intersection(lower_layer_part.infill_area).morphologicalOpen(200);
                             result.add(intersection); // add area to be thickened
                             infill_area_per_combine[combine_count_here - 1]
                                 = infill_area_per_combine[combine_count_here - 1].difference(intersection); // remove thickened area from less thick layer here
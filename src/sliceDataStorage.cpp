@@ -75,6 +75,15 @@ Polygons SliceLayer::getOutlines(bool external_polys_only) const
     return ret;
 }
 
+void SliceLayer::release()
+{
+    // Swapping with empty containers frees their memory, where clearing them would keep their capacity.
+    std::vector<SliceLayerPart>().swap(parts);
+    openPolyLines = Polygons();
+    top_surface = TopSurface();
+    bottom_surface = Polygons();
+}
+
 void SliceLayer::getOutlines(Polygons& result, bool external_polys_only) const
 {
     for (const SliceLayerPart& part : parts)
@@ -273,6 +282,89 @@ Polygons SliceDataStorage::getLayerOutlines(
     const bool external_polys_only,
     const int extruder_nr,
     const bool include_models) const
+{
+    const LayerOutlinesKey key{ extruder_nr, include_support, include_prime_tower, external_polys_only, include_models };
+    {
+        std::lock_guard<std::mutex> lock(layer_outlines_cache_mutex_);
+        const auto cached_layer = layer_outlines_cache_.find(layer_nr);
+        if (cached_layer != layer_outlines_cache_.end())
+        {
+            for (const CachedLayerOutlines& cached : cached_layer->second)
+            {
+                if (cached.key == key)
+                {
+                    return cached.outlines;
+                }
+            }
+        }
+    }
+    // Compute outside of the lock, so that other layers can be computed at the same time. If two threads compute the same outlines, both are equal anyway.
+    Polygons outlines = computeLayerOutlines(layer_nr, include_support, include_prime_tower, external_polys_only, extruder_nr, include_models);
+    std::lock_guard<std::mutex> lock(layer_outlines_cache_mutex_);
+    const auto [cached_layer, is_new_layer] = layer_outlines_cache_.try_emplace(layer_nr);
+    if (is_new_layer)
+    {
+        layer_outlines_cache_order_.push_back(layer_nr);
+    }
+    cached_layer->second.push_back(CachedLayerOutlines{ key, outlines });
+    layer_outlines_cache_vertices_ += outlines.pointCount();
+    while (layer_outlines_cache_vertices_ > max_cached_layer_outline_vertices && ! layer_outlines_cache_order_.empty())
+    {
+        // A layer may be in the order more than once if it was dropped and cached again, in which case it's dropped a bit earlier than needed.
+        eraseCachedLayerOutlines(layer_outlines_cache_order_.front());
+        layer_outlines_cache_order_.pop_front();
+    }
+    return outlines;
+}
+
+void SliceDataStorage::invalidateLayerOutlines()
+{
+    std::lock_guard<std::mutex> lock(layer_outlines_cache_mutex_);
+    for (auto cached_layer = layer_outlines_cache_.begin(); cached_layer != layer_outlines_cache_.end();)
+    {
+        std::erase_if(
+            cached_layer->second,
+            [this, layer_nr = cached_layer->first](const CachedLayerOutlines& cached)
+            {
+                const bool models_only = ! cached.key.include_support && ! cached.key.include_prime_tower && layer_nr >= 0;
+                if (models_only)
+                {
+                    return false; // The models themselves don't change any more, but support, prime tower and raft do.
+                }
+                layer_outlines_cache_vertices_ -= cached.outlines.pointCount();
+                return true;
+            });
+        cached_layer = cached_layer->second.empty() ? layer_outlines_cache_.erase(cached_layer) : std::next(cached_layer);
+    }
+}
+
+void SliceDataStorage::forgetLayerOutlines(const LayerIndex layer_nr)
+{
+    std::lock_guard<std::mutex> lock(layer_outlines_cache_mutex_);
+    eraseCachedLayerOutlines(layer_nr);
+}
+
+void SliceDataStorage::eraseCachedLayerOutlines(const LayerIndex layer_nr) const
+{
+    const auto cached_layer = layer_outlines_cache_.find(layer_nr);
+    if (cached_layer == layer_outlines_cache_.end())
+    {
+        return;
+    }
+    for (const CachedLayerOutlines& cached : cached_layer->second)
+    {
+        layer_outlines_cache_vertices_ -= cached.outlines.pointCount();
+    }
+    layer_outlines_cache_.erase(cached_layer);
+}
+
+Polygons SliceDataStorage::computeLayerOutlines(
+    const LayerIndex layer_nr,
+    const bool include_support,
+    const bool include_prime_tower,
+    const bool external_polys_only,
+    const int extruder_nr,
+    const bool include_models) const
 {
     const Settings& mesh_group_settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
 
@@ -694,6 +786,17 @@ Polygons SliceDataStorage::getMachineBorder(int checking_extruder_nr) const
 }
 
 
+void SupportLayer::release()
+{
+    std::vector<SupportInfillPart>().swap(support_infill_parts);
+    support_bottom = Polygons();
+    support_roof = Polygons();
+    support_fractional_roof = Polygons();
+    support_mesh_drop_down = Polygons();
+    support_mesh = Polygons();
+    anti_overhang = Polygons();
+}
+
 void SupportLayer::excludeAreasFromSupportInfillAreas(const Polygons& exclude_polygons, const AABB& exclude_polygons_boundary_box)
 {
     // record the indexes that need to be removed and do that after
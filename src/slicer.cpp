@@ -3,7 +3,7 @@
 
 #include "slicer.h"
 
-#include <algorithm> // remove_if
+#include <algorithm> // remove_if, lower_bound
 #include <numbers>
 #include <stdio.h>
 
@@ -66,12 +66,9 @@ void SlicerLayer::makeBasicPolygonLoop(Polygons& open_polylines, const size_t st
 
 int SlicerLayer::tryFaceNextSegmentIdx(const SlicerSegment& segment, const int face_idx, const size_t start_segment_idx) const
 {
-    decltype(face_idx_to_segment_idx.begin()) it;
-    auto it_end = face_idx_to_segment_idx.end();
-    it = face_idx_to_segment_idx.find(face_idx);
-    if (it != it_end)
+    const int segment_idx = findSegmentIdx(face_idx);
+    if (segment_idx != -1)
     {
-        const int segment_idx = (*it).second;
         Point2LL p1 = segments[segment_idx].start;
         Point2LL diff = segment.end - p1;
         if (shorterThen(diff, largest_neglected_gap_first_phase))
@@ -91,6 +88,16 @@ int SlicerLayer::tryFaceNextSegmentIdx(const SlicerSegment& segment, const int f
     return -1;
 }
 
+int SlicerLayer::findSegmentIdx(const int face_idx) const
+{
+    const auto segment = std::ranges::lower_bound(segments, face_idx, {}, &SlicerSegment::faceIndex);
+    if (segment == segments.end() || segment->faceIndex != face_idx)
+    {
+        return -1;
+    }
+    return static_cast<int>(segment - segments.begin());
+}
+
 int SlicerLayer::getNextSegmentIdx(const SlicerSegment& segment, const size_t start_segment_idx) const
 {
     int next_segment_idx = -1;
@@ -802,14 +809,41 @@ void SlicerLayer::makePolygons(const Mesh* mesh)
 
 Slicer::Slicer(Mesh* i_mesh, const coord_t thickness, const size_t slice_layer_count, bool use_variable_layer_heights, std::vector<AdaptiveLayer>* adaptive_layers)
     : mesh(i_mesh)
+{
+    buildLayers(thickness, slice_layer_count, use_variable_layer_heights, adaptive_layers);
+    slice({ this }, { i_mesh });
+}
+
+Slicer::Slicer(Mesh* i_mesh)
+    : mesh(i_mesh)
+{
+}
+
+std::vector<Slicer*>
+    Slicer::sliceMeshes(std::vector<Mesh>& meshes, const coord_t thickness, const size_t slice_layer_count, bool use_variable_layer_heights, std::vector<AdaptiveLayer>* adaptive_layers)
+{
+    std::vector<Slicer*> slicers;
+    std::vector<Mesh*> sliced_meshes;
+    slicers.reserve(meshes.size());
+    sliced_meshes.reserve(meshes.size());
+    for (Mesh& mesh : meshes)
+    {
+        Slicer* slicer = new Slicer(&mesh);
+        slicer->buildLayers(thickness, slice_layer_count, use_variable_layer_heights, adaptive_layers);
+        slicers.push_back(slicer);
+        sliced_meshes.push_back(&mesh);
+    }
+    slice(slicers, sliced_meshes);
+    return slicers;
+}
+
+void Slicer::buildLayers(const coord_t thickness, const size_t slice_layer_count, bool use_variable_layer_heights, std::vector<AdaptiveLayer>* adaptive_layers)
 {
     const SlicingTolerance slicing_tolerance = mesh->settings_.get<SlicingTolerance>("slicing_tolerance");
     const coord_t initial_layer_thickness = Application::getInstance().current_slice_->scene.current_mesh_group->settings.get<coord_t>("layer_height_0");
 
     assert(slice_layer_count > 0);
 
-    TimeKeeper slice_timer;
-
     layers = buildLayersWithHeight(slice_layer_count, slicing_tolerance, initial_layer_thickness, thickness, use_variable_layer_heights, adaptive_layers);
     scripta::setAll(
         layers,
@@ -822,148 +856,192 @@ Slicer::Slicer(Mesh* i_mesh, const coord_t thickness, const size_t slice_layer_c
         mesh->settings_.get<coord_t>("raft_airgap"),
         mesh->settings_.get<coord_t>("layer_0_z_overlap"),
         Raft::getFillerLayerCount());
+}
 
-    std::vector<std::pair<int32_t, int32_t>> zbbox = buildZHeightsForFaces(*mesh);
+void Slicer::slice(const std::vector<Slicer*>& slicers, const std::vector<Mesh*>& meshes)
+{
+    TimeKeeper slice_timer;
 
-    buildSegments(*mesh, zbbox, slicing_tolerance, layers);
+    // Every layer of every mesh is a task of its own in the same parallel loops, so that meshes with few layers don't each wait for their own loop to finish.
+    std::vector<std::pair<size_t, size_t>> mesh_layers; // The index of the mesh and layer of every layer to slice.
+    std::vector<SlicingTolerance> slicing_tolerances;
+    slicing_tolerances.reserve(slicers.size());
+    for (size_t mesh_idx = 0; mesh_idx < slicers.size(); ++mesh_idx)
+    {
+        slicing_tolerances.push_back(meshes[mesh_idx]->settings_.get<SlicingTolerance>("slicing_tolerance"));
+        for (size_t layer_nr = 0; layer_nr < slicers[mesh_idx]->layers.size(); ++layer_nr)
+        {
+            mesh_layers.emplace_back(mesh_idx, layer_nr);
+        }
+    }
 
-    spdlog::info("Slice of mesh took {:03.3f} seconds", slice_timer.restart());
+    std::vector<std::vector<std::pair<int32_t, int32_t>>> zbboxes(slicers.size());
+    cura::parallel_for<size_t>(
+        0,
+        slicers.size(),
+        [&zbboxes, &meshes](const size_t mesh_idx)
+        {
+            zbboxes[mesh_idx] = buildZHeightsForFaces(*meshes[mesh_idx]);
+        });
+
+    cura::parallel_for<size_t>(
+        0,
+        mesh_layers.size(),
+        [&mesh_layers, &slicers, &meshes, &zbboxes, &slicing_tolerances](const size_t task_idx)
+        {
+            const auto [mesh_idx, layer_nr] = mesh_layers[task_idx];
+            SlicerLayer& layer = slicers[mesh_idx]->layers[layer_nr];
+            buildSegments(*meshes[mesh_idx], zbboxes[mesh_idx], slicing_tolerances[mesh_idx], layer);
+            layer.makePolygons(meshes[mesh_idx]);
+        });
+    spdlog::info("Slice of {} meshes took {:03.3f} seconds", slicers.size(), slice_timer.restart());
 
-    makePolygons(*i_mesh, slicing_tolerance, layers);
-    scripta::log("sliced_polygons", layers, SectionType::NA);
+    // The slicing tolerance combines layers with the layer above them, so it can only be applied once all layers are sliced.
+    std::vector<PolygonAdjustment> adjustments;
+    adjustments.reserve(slicers.size());
+    for (size_t mesh_idx = 0; mesh_idx < slicers.size(); ++mesh_idx)
+    {
+        adjustments.push_back(prepareAdjustment(*meshes[mesh_idx], slicing_tolerances[mesh_idx], slicers[mesh_idx]->layers));
+    }
+    cura::parallel_for<size_t>(
+        0,
+        mesh_layers.size(),
+        [&mesh_layers, &slicers, &adjustments](const size_t task_idx)
+        {
+            const auto [mesh_idx, layer_nr] = mesh_layers[task_idx];
+            adjustLayer(adjustments[mesh_idx], slicers[mesh_idx]->layers, layer_nr);
+        });
+    for (size_t mesh_idx = 0; mesh_idx < slicers.size(); ++mesh_idx)
+    {
+        finishAdjustment(adjustments[mesh_idx], slicers[mesh_idx]->layers, *meshes[mesh_idx]);
+        scripta::log("sliced_polygons", slicers[mesh_idx]->layers, SectionType::NA);
+    }
     spdlog::info("Make polygons took {:03.3f} seconds", slice_timer.restart());
 }
 
-void Slicer::buildSegments(const Mesh& mesh, const std::vector<std::pair<int32_t, int32_t>>& zbbox, const SlicingTolerance& slicing_tolerance, std::vector<SlicerLayer>& layers)
+void Slicer::buildSegments(const Mesh& mesh, const std::vector<std::pair<int32_t, int32_t>>& zbbox, const SlicingTolerance& slicing_tolerance, SlicerLayer& layer)
 {
-    cura::parallel_for(
-        layers,
-        [&](auto layer_it)
-        {
-            SlicerLayer& layer = *layer_it;
-            const int32_t& z = layer.z;
-            layer.segments.reserve(100);
-
-            // loop over all mesh faces
-            for (unsigned int mesh_idx = 0; mesh_idx < mesh.faces_.size(); mesh_idx++)
-            {
-                if ((z < zbbox[mesh_idx].first) || (z > zbbox[mesh_idx].second))
-                {
-                    continue;
-                }
+    const int32_t& z = layer.z;
+    layer.segments.reserve(100);
 
-                // get all vertices per face
-                const MeshFace& face = mesh.faces_[mesh_idx];
-                const MeshVertex& v0 = mesh.vertices_[face.vertex_index_[0]];
-                const MeshVertex& v1 = mesh.vertices_[face.vertex_index_[1]];
-                const MeshVertex& v2 = mesh.vertices_[face.vertex_index_[2]];
+    // loop over all mesh faces
+    for (unsigned int mesh_idx = 0; mesh_idx < mesh.faces_.size(); mesh_idx++)
+    {
+        if ((z < zbbox[mesh_idx].first) || (z > zbbox[mesh_idx].second))
+        {
+            continue;
+        }
 
-                // get all vertices represented as 3D point
-                Point3LL p0 = v0.p_;
-                Point3LL p1 = v1.p_;
-                Point3LL p2 = v2.p_;
+        // get all vertices per face
+        const MeshFace& face = mesh.faces_[mesh_idx];
+        const MeshVertex& v0 = mesh.vertices_[face.vertex_index_[0]];
+        const MeshVertex& v1 = mesh.vertices_[face.vertex_index_[1]];
+        const MeshVertex& v2 = mesh.vertices_[face.vertex_index_[2]];
 
-                // Compensate for points exactly on the slice-boundary, except for 'inclusive', which already handles this correctly.
-                if (slicing_tolerance != SlicingTolerance::INCLUSIVE)
-                {
-                    p0.z_ += static_cast<int>(p0.z_ == z) * -static_cast<int>(p0.z_ < 1);
-                    p1.z_ += static_cast<int>(p1.z_ == z) * -static_cast<int>(p1.z_ < 1);
-                    p2.z_ += static_cast<int>(p2.z_ == z) * -static_cast<int>(p2.z_ < 1);
-                }
+        // get all vertices represented as 3D point
+        Point3LL p0 = v0.p_;
+        Point3LL p1 = v1.p_;
+        Point3LL p2 = v2.p_;
 
-                SlicerSegment s;
-                s.endVertex = nullptr;
-                int end_edge_idx = -1;
-
-                /*
-                Now see if the triangle intersects the layer, and if so, where.
-
-                Edge cases are important here:
-                - If all three vertices of the triangle are exactly on the layer,
-                  don't count the triangle at all, because if the model is
-                  watertight, there will be adjacent triangles on all 3 sides that
-                  are not flat on the layer.
-                - If two of the vertices are exactly on the layer, only count the
-                  triangle if the last vertex is going up. We can't count both
-                  upwards and downwards triangles here, because if the model is
-                  manifold there will always be an adjacent triangle that is going
-                  the other way and you'd get double edges. You would also get one
-                  layer too many if the total model height is an exact multiple of
-                  the layer thickness. Between going up and going down, we need to
-                  choose the triangles going up, because otherwise the first layer
-                  of where the model starts will be empty and the model will float
-                  in mid-air. We'd much rather let the last layer be empty in that
-                  case.
-                - If only one of the vertices is exactly on the layer, the
-                  intersection between the triangle and the plane would be a point.
-                  We can't print points and with a manifold model there would be
-                  line segments adjacent to the point on both sides anyway, so we
-                  need to discard this 0-length line segment then.
-                - Vertices in ccw order if look from outside.
-                */
-
-                if (p0.z_ < z && p1.z_ > z && p2.z_ > z) //  1_______2
-                { //   \     /
-                    s = project2D(p0, p2, p1, z); //------------- z
-                    end_edge_idx = 0; //     \ /
-                } //      0
-
-                else if (p0.z_ > z && p1.z_ <= z && p2.z_ <= z) //      0
-                { //     / \      .
-                    s = project2D(p0, p1, p2, z); //------------- z
-                    end_edge_idx = 2; //   /     \    .
-                    if (p2.z_ == z) //  1_______2
-                    {
-                        s.endVertex = &v2;
-                    }
-                }
+        // Compensate for points exactly on the slice-boundary, except for 'inclusive', which already handles this correctly.
+        if (slicing_tolerance != SlicingTolerance::INCLUSIVE)
+        {
+            p0.z_ += static_cast<int>(p0.z_ == z) * -static_cast<int>(p0.z_ < 1);
+            p1.z_ += static_cast<int>(p1.z_ == z) * -static_cast<int>(p1.z_ < 1);
+            p2.z_ += static_cast<int>(p2.z_ == z) * -static_cast<int>(p2.z_ < 1);
+        }
 
-                else if (p1.z_ < z && p0.z_ > z && p2.z_ > z) //  0_______2
-                { //   \     /
-                    s = project2D(p1, p0, p2, z); //------------- z
-                    end_edge_idx = 1; //     \ /
-                } //      1
-
-                else if (p1.z_ > z && p0.z_ <= z && p2.z_ <= z) //      1
-                { //     / \      .
-                    s = project2D(p1, p2, p0, z); //------------- z
-                    end_edge_idx = 0; //   /     \    .
-                    if (p0.z_ == z) //  0_______2
-                    {
-                        s.endVertex = &v0;
-                    }
-                }
+        SlicerSegment s;
+        s.endVertex = nullptr;
+        int end_edge_idx = -1;
+
+        /*
+        Now see if the triangle intersects the layer, and if so, where.
+
+        Edge cases are important here:
+        - If all three vertices of the triangle are exactly on the layer,
+          don't count the triangle at all, because if the model is
+          watertight, there will be adjacent triangles on all 3 sides that
+          are not flat on the layer.
+        - If two of the vertices are exactly on the layer, only count the
+          triangle if the last vertex is going up. We can't count both
+          upwards and downwards triangles here, because if the model is
+          manifold there will always be an adjacent triangle that is going
+          the other way and you'd get double edges. You would also get one
+          layer too many if the total model height is an exact multiple of
+          the layer thickness. Between going up and going down, we need to
+          choose the triangles going up, because otherwise the first layer
+          of where the model starts will be empty and the model will float
+          in mid-air. We'd much rather let the last layer be empty in that
+          case.
+        - If only one of the vertices is exactly on the layer, the
+          intersection between the triangle and the plane would be a point.
+          We can't print points and with a manifold model there would be
+          line segments adjacent to the point on both sides anyway, so we
+          need to discard this 0-length line segment then.
+        - Vertices in ccw order if look from outside.
+        */
+
+        if (p0.z_ < z && p1.z_ > z && p2.z_ > z) //  1_______2
+        { //   \     /
+            s = project2D(p0, p2, p1, z); //------------- z
+            end_edge_idx = 0; //     \ /
+        } //      0
+
+        else if (p0.z_ > z && p1.z_ <= z && p2.z_ <= z) //      0
+        { //     / \      .
+            s = project2D(p0, p1, p2, z); //------------- z
+            end_edge_idx = 2; //   /     \    .
+            if (p2.z_ == z) //  1_______2
+            {
+                s.endVertex = &v2;
+            }
+        }
 
-                else if (p2.z_ < z && p1.z_ > z && p0.z_ > z) //  0_______1
-                { //   \     /
-                    s = project2D(p2, p1, p0, z); //------------- z
-                    end_edge_idx = 2; //     \ /
-                } //      2
-
-                else if (p2.z_ > z && p1.z_ <= z && p0.z_ <= z) //      2
-                { //     / \      .
-                    s = project2D(p2, p0, p1, z); //------------- z
-                    end_edge_idx = 1; //   /     \    .
-                    if (p1.z_ == z) //  0_______1
-                    {
-                        s.endVertex = &v1;
-                    }
-                }
-                else
-                {
-                    // Not all cases create a segment, because a point of a face could create just a dot, and two touching faces
-                    //   on the slice would create two segments
-                    continue;
-                }
+        else if (p1.z_ < z && p0.z_ > z && p2.z_ > z) //  0_______2
+        { //   \     /
+            s = project2D(p1, p0, p2, z); //------------- z
+            end_edge_idx = 1; //     \ /
+        } //      1
+
+        else if (p1.z_ > z && p0.z_ <= z && p2.z_ <= z) //      1
+        { //     / \      .
+            s = project2D(p1, p2, p0, z); //------------- z
+            end_edge_idx = 0; //   /     \    .
+            if (p0.z_ == z) //  0_______2
+            {
+                s.endVertex = &v0;
+            }
+        }
 
-                // store the segments per layer
-                layer.face_idx_to_segment_idx.insert(std::make_pair(mesh_idx, layer.segments.size()));
-                s.faceIndex = mesh_idx;
-                s.endOtherFaceIdx = face.connected_face_index_[end_edge_idx];
-                s.addedToPolygon = false;
-                layer.segments.push_back(s);
+        else if (p2.z_ < z && p1.z_ > z && p0.z_ > z) //  0_______1
+        { //   \     /
+            s = project2D(p2, p1, p0, z); //------------- z
+            end_edge_idx = 2; //     \ /
+        } //      2
+
+        else if (p2.z_ > z && p1.z_ <= z && p0.z_ <= z) //      2
+        { //     / \      .
+            s = project2D(p2, p0, p1, z); //------------- z
+            end_edge_idx = 1; //   /     \    .
+            if (p1.z_ == z) //  0_______1
+            {
+                s.endVertex = &v1;
             }
-        });
+        }
+        else
+        {
+            // Not all cases create a segment, because a point of a face could create just a dot, and two touching faces
+            //   on the slice would create two segments
+            continue;
+        }
+
+        // store the segments per layer, which are in order of their face since the faces are visited in order
+        s.faceIndex = mesh_idx;
+        s.endOtherFaceIdx = face.connected_face_index_[end_edge_idx];
+        s.addedToPolygon = false;
+        layer.segments.push_back(s);
+    }
 }
 
 std::vector<SlicerLayer> Slicer::buildLayersWithHeight(
@@ -1007,103 +1085,113 @@ std::vector<SlicerLayer> Slicer::buildLayersWithHeight(
     return layers_res;
 }
 
-void Slicer::makePolygons(Mesh& mesh, SlicingTolerance slicing_tolerance, std::vector<SlicerLayer>& layers)
+Slicer::PolygonAdjustment Slicer::prepareAdjustment(const Mesh& mesh, const SlicingTolerance slicing_tolerance, const std::vector<SlicerLayer>& layers)
 {
-    cura::parallel_for(
-        layers,
-        [&mesh](auto layer_it)
-        {
-            layer_it->makePolygons(&mesh);
-        });
-
-    switch (slicing_tolerance)
+    PolygonAdjustment adjustment;
+    adjustment.slicing_tolerance = slicing_tolerance;
+    adjustment.xy_offset = mesh.settings_.get<coord_t>("xy_offset");
+    adjustment.xy_offset_0 = mesh.settings_.get<coord_t>("xy_offset_layer_0");
+    adjustment.xy_offset_hole = mesh.settings_.get<coord_t>("hole_xy_offset");
+    adjustment.hole_offset_max_diameter = mesh.settings_.get<coord_t>("hole_xy_offset_max_diameter");
+    adjustment.max_hole_area = std::numbers::pi / 4 * static_cast<double>(adjustment.hole_offset_max_diameter * adjustment.hole_offset_max_diameter);
+
+    if (layers.empty())
     {
-    case SlicingTolerance::INCLUSIVE:
-        for (LayerIndex layer_nr = 0; layer_nr + 1 < layers.size(); layer_nr++)
-        {
-            layers[layer_nr].polygons = layers[layer_nr].polygons.unionPolygons(layers[layer_nr + 1].polygons);
-        }
-        break;
-    case SlicingTolerance::EXCLUSIVE:
-        for (LayerIndex layer_nr = 0; layer_nr + 1 < layers.size(); layer_nr++)
-        {
-            layers[layer_nr].polygons = layers[layer_nr].polygons.intersection(layers[layer_nr + 1].polygons);
-        }
-        layers.back().polygons.clear();
-        break;
-    case SlicingTolerance::MIDDLE:
-    default:
-        // do nothing
-        ;
+        return adjustment;
     }
 
-    size_t layer_apply_initial_xy_offset = 0;
-    if (layers.size() > 0 && layers[0].polygons.size() == 0 && ! mesh.settings_.get<bool>("support_mesh") && ! mesh.settings_.get<bool>("anti_overhang_mesh")
-        && ! mesh.settings_.get<bool>("cutting_mesh") && ! mesh.settings_.get<bool>("infill_mesh"))
+    // Whether the initial layer offset also applies to the second layer depends on the first layer after the slicing tolerance, so that one is combined up front.
+    const Polygons* first_layer_polygons = &layers[0].polygons;
+    if (slicing_tolerance == SlicingTolerance::INCLUSIVE || slicing_tolerance == SlicingTolerance::EXCLUSIVE)
+    {
+        adjustment.tolerance_polygons.resize(layers.size());
+        adjustment.tolerance_polygons[0] = applySlicingTolerance(slicing_tolerance, layers, 0);
+        first_layer_polygons = &adjustment.tolerance_polygons[0];
+    }
+    if (first_layer_polygons->empty() && ! mesh.settings_.get<bool>("support_mesh") && ! mesh.settings_.get<bool>("anti_overhang_mesh") && ! mesh.settings_.get<bool>("cutting_mesh")
+        && ! mesh.settings_.get<bool>("infill_mesh"))
     {
-        layer_apply_initial_xy_offset = 1;
+        adjustment.layer_apply_initial_xy_offset = 1;
     }
+    return adjustment;
+}
 
+Polygons Slicer::applySlicingTolerance(const SlicingTolerance slicing_tolerance, const std::vector<SlicerLayer>& layers, const size_t layer_nr)
+{
+    const Polygons& polygons = layers[layer_nr].polygons;
+    if (layer_nr + 1 >= layers.size())
+    {
+        return slicing_tolerance == SlicingTolerance::EXCLUSIVE ? Polygons() : polygons;
+    }
+    const Polygons& next_polygons = layers[layer_nr + 1].polygons;
+    return slicing_tolerance == SlicingTolerance::INCLUSIVE ? polygons.unionPolygons(next_polygons) : polygons.intersection(next_polygons);
+}
 
-    const coord_t xy_offset = mesh.settings_.get<coord_t>("xy_offset");
-    const coord_t xy_offset_0 = mesh.settings_.get<coord_t>("xy_offset_layer_0");
-    const coord_t xy_offset_hole = mesh.settings_.get<coord_t>("hole_xy_offset");
-    const coord_t hole_offset_max_diameter = mesh.settings_.get<coord_t>("hole_xy_offset_max_diameter");
+void Slicer::adjustLayer(PolygonAdjustment& adjustment, std::vector<SlicerLayer>& layers, const size_t layer_nr)
+{
+    // With a slicing tolerance, every layer is combined with the slice of the layer above it as it was before that layer got combined itself.
+    // The results go to a separate buffer, so that all layers can be combined and offset in one pass in parallel.
+    Polygons& polygons = adjustment.tolerance_polygons.empty() ? layers[layer_nr].polygons : adjustment.tolerance_polygons[layer_nr];
+    if (! adjustment.tolerance_polygons.empty() && layer_nr > 0)
+    {
+        polygons = applySlicingTolerance(adjustment.slicing_tolerance, layers, layer_nr);
+    }
 
-    const auto max_hole_area = std::numbers::pi / 4 * static_cast<double>(hole_offset_max_diameter * hole_offset_max_diameter);
+    const auto xy_offset_local = (layer_nr <= adjustment.layer_apply_initial_xy_offset) ? adjustment.xy_offset_0 : adjustment.xy_offset;
+    if (xy_offset_local != 0)
+    {
+        polygons = polygons.offset(xy_offset_local, ClipperLib::JoinType::jtRound);
+    }
+    if (adjustment.xy_offset_hole != 0)
+    {
+        const auto parts = polygons.splitIntoParts();
+        polygons.clear();
 
-    cura::parallel_for<size_t>(
-        0,
-        layers.size(),
-        [&layers, layer_apply_initial_xy_offset, xy_offset, xy_offset_0, xy_offset_hole, hole_offset_max_diameter, max_hole_area](size_t layer_nr)
+        for (const auto& part : parts)
         {
-            const auto xy_offset_local = (layer_nr <= layer_apply_initial_xy_offset) ? xy_offset_0 : xy_offset;
-            if (xy_offset_local != 0)
-            {
-                layers[layer_nr].polygons = layers[layer_nr].polygons.offset(xy_offset_local, ClipperLib::JoinType::jtRound);
-            }
-            if (xy_offset_hole != 0)
+            Polygons holes;
+            Polygons outline;
+            for (ConstPolygonRef poly : part)
             {
-                const auto parts = layers[layer_nr].polygons.splitIntoParts();
-                layers[layer_nr].polygons.clear();
-
-                for (const auto& part : parts)
+                const auto area = poly.area();
+                const auto abs_area = std::abs(area);
+                const auto is_hole = area < 0;
+                if (is_hole)
                 {
-                    Polygons holes;
-                    Polygons outline;
-                    for (ConstPolygonRef poly : part)
+                    if (adjustment.hole_offset_max_diameter == 0)
                     {
-                        const auto area = poly.area();
-                        const auto abs_area = std::abs(area);
-                        const auto is_hole = area < 0;
-                        if (is_hole)
-                        {
-                            if (hole_offset_max_diameter == 0)
-                            {
-                                holes.add(poly.offset(xy_offset_hole));
-                            }
-                            else if (abs_area < max_hole_area)
-                            {
-                                const auto distance = static_cast<int>(std::lerp(xy_offset_hole, 0, abs_area / max_hole_area));
-                                holes.add(poly.offset(distance));
-                            }
-                            else
-                            {
-                                holes.add(poly);
-                            }
-                        }
-                        else
-                        {
-                            outline.add(poly);
-                        }
+                        holes.add(poly.offset(adjustment.xy_offset_hole));
+                    }
+                    else if (abs_area < adjustment.max_hole_area)
+                    {
+                        const auto distance = static_cast<int>(std::lerp(adjustment.xy_offset_hole, 0, abs_area / adjustment.max_hole_area));
+                        holes.add(poly.offset(distance));
+                    }
+                    else
+                    {
+                        holes.add(poly);
                     }
-
-                    layers[layer_nr].polygons.add(outline.difference(holes.unionPolygons()));
+                }
+                else
+                {
+                    outline.add(poly);
                 }
             }
-        });
 
-    mesh.expandXY(xy_offset);
+            polygons.add(outline.difference(holes.unionPolygons()));
+        }
+    }
+}
+
+void Slicer::finishAdjustment(PolygonAdjustment& adjustment, std::vector<SlicerLayer>& layers, Mesh& mesh)
+{
+    for (size_t layer_nr = 0; layer_nr < adjustment.tolerance_polygons.size(); ++layer_nr)
+    {
+        layers[layer_nr].polygons = std::move(adjustment.tolerance_polygons[layer_nr]);
+    }
+    adjustment.tolerance_polygons.clear();
+
+    mesh.expandXY(adjustment.xy_offset);
 }
 
 
@@ -374,7 +374,7 @@ void AreaSupport::combineSupportInfillLayers(SliceDataStorage& storage)
                             continue;
                         }
 
-                        Polygons intersection = infill_area_per_combine[combine_count_here - 1].intersection(lower_layer_part.getInfillArea()).offset(-200).offset(200);
+                        Polygons intersection = infill_area_per_combine[combine_count_here - 1].intersection(lower_layer_part.getInfillArea()).morphologicalOpen(200);
                         if (intersection.size() <= 0)
                         {
                             continue;
@@ -822,7 +822,7 @@ Polygons AreaSupport::generateVaryingXYDisallowedArea(const SliceMeshStorage& st
 
     constexpr auto close_dist = 20;
 
-    auto layer_current = simplify.polygon(storage.layers[layer_idx].getOutlines().offset(-close_dist).offset(close_dist));
+    auto layer_current = simplify.polygon(storage.layers[layer_idx].getOutlines().morphologicalOpen(close_dist));
 
     using point_pair_t = std::pair<size_t, double>;
     using poly_point_key = std::tuple<unsigned int, unsigned int>;
@@ -847,7 +847,7 @@ Polygons AreaSupport::generateVaryingXYDisallowedArea(const SliceMeshStorage& st
     const LayerIndex layer_idx_below{ std::max(LayerIndex{ layer_idx - layer_index_offset }, LayerIndex{ 0 }) };
     if (layer_idx_below != layer_idx)
     {
-        const auto layer_below = simplify.polygon(storage.layers[layer_idx_below].getOutlines().offset(-close_dist).offset(close_dist));
+        const auto layer_below = simplify.polygon(storage.layers[layer_idx_below].getOutlines().morphologicalOpen(close_dist));
         z_distances_layer_deltas.emplace_back(z_delta_poly_t{
             .support_distance = support_distance_bot,
             .delta_z = -static_cast<double>(layer_index_offset * layer_thickness),
@@ -858,7 +858,7 @@ Polygons AreaSupport::generateVaryingXYDisallowedArea(const SliceMeshStorage& st
     const LayerIndex layer_idx_above{ std::min(LayerIndex{ layer_idx + layer_index_offset }, LayerIndex{ storage.layers.size() - 1 }) };
     if (layer_idx_above != layer_idx)
     {
-        const auto layer_above = simplify.polygon(storage.layers[layer_idx_above].getOutlines().offset(-close_dist).offset(close_dist));
+        const auto layer_above = simplify.polygon(storage.layers[layer_idx_above].getOutlines().morphologicalOpen(close_dist));
         z_distances_layer_deltas.emplace_back(z_delta_poly_t{
             .support_distance = support_distance_top,
             .delta_z = static_cast<double>(layer_index_offset * layer_thickness),
@@ -1175,7 +1175,7 @@ void AreaSupport::generateSupportAreasForMesh(
         {
             for (PolygonsPart poly : layer_this.splitIntoParts())
             {
-                const auto polygon_part = poly.difference(xy_disallowed_per_layer[layer_idx]).offset(-half_min_feature_width).offset(half_min_feature_width);
+                const auto polygon_part = poly.difference(xy_disallowed_per_layer[layer_idx]).morphologicalOpen(half_min_feature_width);
 
                 const int64_t part_area = polygon_part.area();
                 if (part_area == 0 || part_area > max_tower_supported_diameter * max_tower_supported_diameter)
@@ -1227,7 +1227,7 @@ void AreaSupport::generateSupportAreasForMesh(
         }
 
         // Perform close operation to remove areas from support area that are unprintable
-        support_layer = support_layer.offset(-half_min_feature_width).offset(half_min_feature_width);
+        support_layer = support_layer.morphologicalOpen(half_min_feature_width);
 
         // remove areas smaller than the minimum support area
         support_layer.removeSmallAreas(minimum_support_area);
@@ -1322,6 +1322,7 @@ void AreaSupport::generateSupportAreasForMesh(
     }
 
     storage.support.generated = true;
+    storage.invalidateLayerOutlines();
 }
 
 void AreaSupport::moveUpFromModel(
@@ -5,6 +5,7 @@
 
 #include <limits>
 
+#include "utils/PolygonsSoA.h"
 #include "utils/linearAlg2D.h"
 #include "utils/polygon.h" //To create the AABB of a polygon.
 
@@ -72,12 +73,9 @@ void AABB::calculate(const Polygons& polys)
 {
     min_ = Point2LL(POINT_MAX, POINT_MAX);
     max_ = Point2LL(POINT_MIN, POINT_MIN);
-    for (unsigned int i = 0; i < polys.size(); i++)
+    for (const ClipperLib::Path& path : polys)
     {
-        for (unsigned int j = 0; j < polys[i].size(); j++)
-        {
-            include(polys[i][j]);
-        }
+        PolygonsSoA::boundingBox(path.data(), path.size(), min_, max_);
     }
 }
 
@@ -85,10 +83,7 @@ void AABB::calculate(ConstPolygonRef poly)
 {
     min_ = Point2LL(POINT_MAX, POINT_MAX);
     max_ = Point2LL(POINT_MIN, POINT_MIN);
-    for (const Point2LL& p : poly)
-    {
-        include(p);
-    }
+    PolygonsSoA::boundingBox((*poly).data(), poly.size(), min_, max_);
 }
 
 bool AABB::contains(const Point2LL& point) const
@@ -0,0 +1,206 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/Counters.h"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace cura
+{
+
+namespace
+{
+
+constexpr std::array<std::string_view, Counters::counter_count> counter_names{
+    "clipper_boolean_calls",
+    "clipper_boolean_vertices",
+    "clipper_offset_calls",
+    "clipper_offset_vertices",
+    "settings_get_calls",
+    "comb_attempts",
+    "comb_fallbacks",
+    "skeletal_trapezoidation_graphs",
+    "skeletal_trapezoidation_nodes",
+    "path_order_optimizer_calls",
+    "path_order_optimizer_paths",
+    "seam_corner_cache_hits",
+    "seam_corner_cache_misses",
+};
+
+constexpr std::array<std::string_view, Counters::histogram_count> histogram_names{
+    "clipper_boolean_vertices",
+    "clipper_offset_vertices",
+    "skeletal_trapezoidation_nodes",
+    "path_order_optimizer_paths",
+};
+
+} // namespace
+
+struct Counters::State
+{
+    std::mutex mutex; //!< Guards the list of shards, not their contents.
+    std::vector<std::unique_ptr<Shard>> shards; //!< Owned here rather than by the threads, so that they survive threads that end before the counters are read.
+    std::filesystem::path output_file;
+};
+
+Counters::State& Counters::state()
+{
+    static State counters_state;
+    return counters_state;
+}
+
+Counters::Snapshot& Counters::Snapshot::operator+=(const Snapshot& other)
+{
+    for (size_t counter_idx = 0; counter_idx < counter_count; ++counter_idx)
+    {
+        counters[counter_idx] += other.counters[counter_idx];
+    }
+    for (size_t histogram_idx = 0; histogram_idx < histogram_count; ++histogram_idx)
+    {
+        HistogramData& histogram = histograms[histogram_idx];
+        const HistogramData& other_histogram = other.histograms[histogram_idx];
+        histogram.count += other_histogram.count;
+        histogram.sum += other_histogram.sum;
+        for (size_t bucket_idx = 0; bucket_idx < bucket_count; ++bucket_idx)
+        {
+            histogram.buckets[bucket_idx] += other_histogram.buckets[bucket_idx];
+        }
+    }
+    return *this;
+}
+
+void Counters::Snapshot::writeJson(std::ostream& out) const
+{
+    out << "{\n  \"counters\": {";
+    for (size_t counter_idx = 0; counter_idx < counter_count; ++counter_idx)
+    {
+        out << (counter_idx == 0 ? "\n" : ",\n") << fmt::format(R"(    "{}": {})", counter_names[counter_idx], counters[counter_idx]);
+    }
+    out << "\n  },\n  \"histograms\": {";
+    for (size_t histogram_idx = 0; histogram_idx < histogram_count; ++histogram_idx)
+    {
+        const HistogramData& histogram = histograms[histogram_idx];
+        out << (histogram_idx == 0 ? "\n" : ",\n")
+            << fmt::format(R"(    "{}": {{ "count": {}, "sum": {}, "buckets": [)", histogram_names[histogram_idx], histogram.count, histogram.sum);
+        bool first = true;
+        for (size_t bucket_idx = 0; bucket_idx < bucket_count; ++bucket_idx)
+        {
+            if (histogram.buckets[bucket_idx] == 0)
+            {
+                continue;
+            }
+            // Each bucket is written with the smallest value that falls in it. The last bucket has no upper bound.
+            const uint64_t lower_bound = bucket_idx == 0 ? 0 : uint64_t(1) << (bucket_idx - 1);
+            out << (first ? "" : ", ") << fmt::format(R"({{ "from": {}, "count": {} }})", lower_bound, histogram.buckets[bucket_idx]);
+            first = false;
+        }
+        out << "] }";
+    }
+    out << "\n  }\n}\n";
+}
+
+std::string_view Counters::name(const Counter counter)
+{
+    return counter_names[static_cast<size_t>(counter)];
+}
+
+std::string_view Counters::name(const Histogram histogram)
+{
+    return histogram_names[static_cast<size_t>(histogram)];
+}
+
+Counters::Shard* Counters::registerShard()
+{
+    State& counters_state = state();
+    std::lock_guard<std::mutex> lock(counters_state.mutex);
+    return counters_state.shards.emplace_back(std::make_unique<Shard>()).get();
+}
+
+Counters::Snapshot Counters::snapshot()
+{
+    Snapshot result;
+    State& counters_state = state();
+    std::lock_guard<std::mutex> lock(counters_state.mutex);
+    for (const std::unique_ptr<Shard>& shard : counters_state.shards)
+    {
+        for (size_t counter_idx = 0; counter_idx < counter_count; ++counter_idx)
+        {
+            result.counters[counter_idx] += shard->counters[counter_idx].load(std::memory_order_relaxed);
+        }
+        for (size_t histogram_idx = 0; histogram_idx < histogram_count; ++histogram_idx)
+        {
+            const HistogramShard& histogram_shard = shard->histograms[histogram_idx];
+            Snapshot::HistogramData& histogram = result.histograms[histogram_idx];
+            histogram.count += histogram_shard.count.load(std::memory_order_relaxed);
+            histogram.sum += histogram_shard.sum.load(std::memory_order_relaxed);
+            for (size_t bucket_idx = 0; bucket_idx < bucket_count; ++bucket_idx)
+            {
+                histogram.buckets[bucket_idx] += histogram_shard.buckets[bucket_idx].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    return result;
+}
+
+void Counters::reset()
+{
+    State& counters_state = state();
+    std::lock_guard<std::mutex> lock(counters_state.mutex);
+    for (const std::unique_ptr<Shard>& shard : counters_state.shards)
+    {
+        for (std::atomic<uint64_t>& counter : shard->counters)
+        {
+            counter.store(0, std::memory_order_relaxed);
+        }
+        for (HistogramShard& histogram_shard : shard->histograms)
+        {
+            histogram_shard.count.store(0, std::memory_order_relaxed);
+            histogram_shard.sum.store(0, std::memory_order_relaxed);
+            for (std::atomic<uint64_t>& bucket : histogram_shard.buckets)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+void Counters::setOutputFile(const std::filesystem::path& output_file)
+{
+    State& counters_state = state();
+    std::lock_guard<std::mutex> lock(counters_state.mutex);
+    counters_state.output_file = output_file;
+}
+
+void Counters::write()
+{
+    if constexpr (! enabled)
+    {
+        return;
+    }
+    std::filesystem::path output_file;
+    {
+        State& counters_state = state();
+        std::lock_guard<std::mutex> lock(counters_state.mutex);
+        output_file = counters_state.output_file;
+    }
+    if (output_file.empty())
+    {
+        return;
+    }
+    std::ofstream out(output_file);
+    if (! out)
+    {
+        spdlog::error("Couldn't open {} to write the performance counters.", output_file.string());
+        return;
+    }
+    snapshot().writeJson(out);
+    spdlog::info("Wrote performance counters to {}", output_file.string());
+}
+
+} // namespace cura
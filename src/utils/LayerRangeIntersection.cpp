@@ -0,0 +1,57 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/LayerRangeIntersection.h"
+
+#include <bit>
+#include <cassert>
+
+#include "utils/ThreadPool.h"
+
+namespace cura
+{
+
+LayerRangeIntersection::LayerRangeIntersection(std::vector<Polygons> layer_areas, size_t max_range_length)
+{
+    const size_t layer_count = layer_areas.size();
+    levels_.emplace_back(std::move(layer_areas));
+    for (size_t span = 2; span <= max_range_length && span <= layer_count; span *= 2)
+    {
+        const std::vector<Polygons>& previous = levels_.back();
+        std::vector<Polygons> level(layer_count - span + 1);
+        const size_t half_span = span / 2;
+        cura::parallel_for<size_t>(
+            0,
+            level.size(),
+            [&](const size_t layer_idx)
+            {
+                previous[layer_idx].intersection(previous[layer_idx + half_span], level[layer_idx]);
+            });
+        levels_.emplace_back(std::move(level));
+    }
+}
+
+Polygons LayerRangeIntersection::query(size_t first, size_t last) const
+{
+    assert(first <= last);
+    if (last >= size())
+    {
+        return Polygons();
+    }
+    const size_t range_length = last - first + 1;
+    const size_t level_idx = std::bit_width(range_length) - 1;
+    assert(level_idx < levels_.size() && "The range is longer than the table was built for.");
+    const size_t span = size_t(1) << level_idx;
+    if (span == range_length)
+    {
+        return levels_[level_idx][first];
+    }
+    return levels_[level_idx][first].intersection(levels_[level_idx][last + 1 - span]);
+}
+
+size_t LayerRangeIntersection::size() const
+{
+    return levels_.front().size();
+}
+
+} // namespace cura
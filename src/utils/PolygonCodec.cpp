@@ -0,0 +1,114 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/PolygonCodec.h"
+
+#include <cassert>
+
+namespace cura
+{
+
+PolygonEncoder::PolygonEncoder(std::vector<uint8_t>& buffer)
+    : buffer_(buffer)
+{
+}
+
+void PolygonEncoder::writeUnsigned(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer_.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    buffer_.push_back(static_cast<uint8_t>(value));
+}
+
+void PolygonEncoder::writeSigned(const int64_t value)
+{
+    // Interleave positive and negative numbers: 0, -1, 1, -2, 2, ...
+    writeUnsigned((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void PolygonEncoder::writePoint(const Point2LL& point)
+{
+    writeSigned(point.X - previous_point_.X);
+    writeSigned(point.Y - previous_point_.Y);
+    previous_point_ = point;
+    ++point_count_;
+}
+
+void PolygonEncoder::writePolygons(const Polygons& polygons)
+{
+    writeUnsigned(polygons.paths.size());
+    for (const ClipperLib::Path& path : polygons.paths)
+    {
+        writeUnsigned(path.size());
+        for (const Point2LL& point : path)
+        {
+            writePoint(point);
+        }
+    }
+}
+
+size_t PolygonEncoder::pointCount() const
+{
+    return point_count_;
+}
+
+PolygonDecoder::PolygonDecoder(std::span<const uint8_t> data)
+    : data_(data)
+{
+}
+
+uint64_t PolygonDecoder::readUnsigned()
+{
+    uint64_t value = 0;
+    for (unsigned shift = 0;; shift += 7)
+    {
+        assert(position_ < data_.size() && "Reading past the end of the encoded data.");
+        const uint8_t byte = data_[position_++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+}
+
+int64_t PolygonDecoder::readSigned()
+{
+    const uint64_t value = readUnsigned();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+Point2LL PolygonDecoder::readPoint()
+{
+    const coord_t x = previous_point_.X + readSigned();
+    const coord_t y = previous_point_.Y + readSigned();
+    previous_point_ = Point2LL(x, y);
+    return previous_point_;
+}
+
+Polygons PolygonDecoder::readPolygons()
+{
+    Polygons result;
+    const size_t path_count = readUnsigned();
+    result.paths.resize(path_count);
+    for (ClipperLib::Path& path : result.paths)
+    {
+        const size_t point_count = readUnsigned();
+        path.reserve(point_count);
+        for (size_t point_idx = 0; point_idx < point_count; ++point_idx)
+        {
+            path.push_back(readPoint());
+        }
+    }
+    return result;
+}
+
+bool PolygonDecoder::atEnd() const
+{
+    return position_ >= data_.size();
+}
+
+} // namespace cura
@@ -0,0 +1,387 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/PolygonsSoA.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+#define CURA_POLYGONS_SOA_AVX2
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define CURA_POLYGONS_SOA_NEON
+#include <arm_neon.h>
+#endif
+
+#include "utils/polygon.h"
+
+namespace cura
+{
+
+namespace
+{
+
+enum class SimdLevel
+{
+    NONE,
+    AVX2,
+    NEON
+};
+
+SimdLevel detectSimdLevel()
+{
+#if defined(CURA_POLYGONS_SOA_AVX2)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::NONE;
+#elif defined(CURA_POLYGONS_SOA_NEON)
+    return SimdLevel::NEON; // NEON is mandatory on AArch64.
+#else
+    return SimdLevel::NONE;
+#endif
+}
+
+SimdLevel simdLevel()
+{
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+/*!
+ * The vectorized kernels convert coordinate differences to doubles, which is
+ * only exact (and, for the AVX2 bit trick, only correct) for values below
+ * 2^51. Requiring all coordinates to stay below 2^49 leaves enough room.
+ */
+constexpr coord_t SIMD_COORD_LIMIT = coord_t(1) << 49;
+
+bool inSimdRange(const Point2LL& p)
+{
+    return p.X > -SIMD_COORD_LIMIT && p.X < SIMD_COORD_LIMIT && p.Y > -SIMD_COORD_LIMIT && p.Y < SIMD_COORD_LIMIT;
+}
+
+/*!
+ * Point-in-polygon test over a range of edges, following ClipperLib::PointInPolygon edge by edge.
+ *
+ * Since the parity of the total number of crossings is the sum of the parities per polygon, the edges of all polygons can be processed in one go.
+ * \return -1 if the point is on the border, otherwise the parity of the number of crossings.
+ */
+int pointInEdgesScalar(const coord_t* x0, const coord_t* y0, const coord_t* x1, const coord_t* y1, size_t begin, size_t end, const Point2LL p)
+{
+    int result = 0;
+    for (size_t i = begin; i < end; ++i)
+    {
+        if (y1[i] == p.Y)
+        {
+            if (x1[i] == p.X || (y0[i] == p.Y && ((x1[i] > p.X) == (x0[i] < p.X))))
+            {
+                return -1;
+            }
+        }
+        if ((y0[i] < p.Y) == (y1[i] < p.Y))
+        {
+            continue;
+        }
+        if (x0[i] >= p.X && x1[i] > p.X)
+        {
+            result ^= 1;
+        }
+        else if ((x0[i] >= p.X) != (x1[i] > p.X))
+        {
+            const double d = static_cast<double>(x0[i] - p.X) * static_cast<double>(y1[i] - p.Y) - static_cast<double>(x1[i] - p.X) * static_cast<double>(y0[i] - p.Y);
+            if (d == 0)
+            {
+                return -1;
+            }
+            if ((d > 0) == (y1[i] > y0[i]))
+            {
+                result ^= 1;
+            }
+        }
+    }
+    return result;
+}
+
+void boundingBoxScalar(const Point2LL* points, size_t begin, size_t end, Point2LL& min, Point2LL& max)
+{
+    for (size_t i = begin; i < end; ++i)
+    {
+        min.X = std::min(min.X, points[i].X);
+        min.Y = std::min(min.Y, points[i].Y);
+        max.X = std::max(max.X, points[i].X);
+        max.Y = std::max(max.Y, points[i].Y);
+    }
+}
+
+#if defined(CURA_POLYGONS_SOA_AVX2)
+
+/*!
+ * Exact int64 to double conversion for |v| < 2^51, which AVX2 lacks an instruction for.
+ * Adding the bits of 2^52 + 2^51 puts v in the mantissa; subtracting that number as a double leaves v.
+ */
+__attribute__((target("avx2"))) inline __m256d toDoubleAvx2(const __m256i v)
+{
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+    return _mm256_sub_pd(_mm256_castsi256_pd(_mm256_add_epi64(v, _mm256_castpd_si256(magic))), magic);
+}
+
+__attribute__((target("avx2"))) inline __m256i loadAvx2(const coord_t* ptr)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+}
+
+__attribute__((target("avx2"))) int pointInEdgesAvx2(const coord_t* x0, const coord_t* y0, const coord_t* x1, const coord_t* y1, size_t count, const Point2LL p)
+{
+    const __m256i px = _mm256_set1_epi64x(p.X);
+    const __m256i py = _mm256_set1_epi64x(p.Y);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i all = _mm256_set1_epi64x(-1);
+    __m256i border = zero;
+    __m256i flips = zero;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m256i ax = _mm256_sub_epi64(loadAvx2(x0 + i), px);
+        const __m256i ay = _mm256_sub_epi64(loadAvx2(y0 + i), py);
+        const __m256i bx = _mm256_sub_epi64(loadAvx2(x1 + i), px);
+        const __m256i by = _mm256_sub_epi64(loadAvx2(y1 + i), py);
+
+        const __m256i ax_neg = _mm256_cmpgt_epi64(zero, ax);
+        const __m256i ax_nonneg = _mm256_xor_si256(ax_neg, all);
+        const __m256i bx_pos = _mm256_cmpgt_epi64(bx, zero);
+
+        // The end vertex lies on the point, or the edge is horizontal through it.
+        const __m256i x_straddles = _mm256_xor_si256(_mm256_xor_si256(bx_pos, ax_neg), all);
+        const __m256i on_horizontal = _mm256_or_si256(_mm256_cmpeq_epi64(bx, zero), _mm256_and_si256(_mm256_cmpeq_epi64(ay, zero), x_straddles));
+        border = _mm256_or_si256(border, _mm256_and_si256(_mm256_cmpeq_epi64(by, zero), on_horizontal));
+
+        const __m256i crosses_y = _mm256_xor_si256(_mm256_cmpgt_epi64(zero, ay), _mm256_cmpgt_epi64(zero, by));
+        flips = _mm256_xor_si256(flips, _mm256_and_si256(crosses_y, _mm256_and_si256(ax_nonneg, bx_pos)));
+
+        // The edge passes the horizontal ray on one side in X, so the side of the cross product decides.
+        const __m256i needs_cross = _mm256_and_si256(crosses_y, _mm256_xor_si256(ax_nonneg, bx_pos));
+        const __m256d d = _mm256_sub_pd(_mm256_mul_pd(toDoubleAvx2(ax), toDoubleAvx2(by)), _mm256_mul_pd(toDoubleAvx2(bx), toDoubleAvx2(ay)));
+        const __m256i d_zero = _mm256_castpd_si256(_mm256_cmp_pd(d, _mm256_setzero_pd(), _CMP_EQ_OQ));
+        const __m256i d_pos = _mm256_castpd_si256(_mm256_cmp_pd(d, _mm256_setzero_pd(), _CMP_GT_OQ));
+        const __m256i upward = _mm256_cmpgt_epi64(by, ay);
+        border = _mm256_or_si256(border, _mm256_and_si256(needs_cross, d_zero));
+        const __m256i same_side = _mm256_xor_si256(_mm256_xor_si256(d_pos, upward), all);
+        flips = _mm256_xor_si256(flips, _mm256_andnot_si256(d_zero, _mm256_and_si256(needs_cross, same_side)));
+    }
+    if (! _mm256_testz_si256(border, border))
+    {
+        return -1;
+    }
+    const int tail = pointInEdgesScalar(x0, y0, x1, y1, i, count, p);
+    if (tail == -1)
+    {
+        return -1;
+    }
+    return (std::popcount(static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(flips)))) + tail) & 1;
+}
+
+__attribute__((target("avx2"))) void boundingBoxAvx2(const Point2LL* points, size_t count, Point2LL& min, Point2LL& max)
+{
+    // Two interleaved points per register: [x, y, x, y].
+    __m256i lo = _mm256_setr_epi64x(min.X, min.Y, min.X, min.Y);
+    __m256i hi = _mm256_setr_epi64x(max.X, max.Y, max.X, max.Y);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(points + i));
+        lo = _mm256_blendv_epi8(lo, v, _mm256_cmpgt_epi64(lo, v));
+        hi = _mm256_blendv_epi8(hi, v, _mm256_cmpgt_epi64(v, hi));
+    }
+    alignas(32) coord_t lo_lanes[4];
+    alignas(32) coord_t hi_lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lo_lanes), lo);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(hi_lanes), hi);
+    min = Point2LL(std::min(lo_lanes[0], lo_lanes[2]), std::min(lo_lanes[1], lo_lanes[3]));
+    max = Point2LL(std::max(hi_lanes[0], hi_lanes[2]), std::max(hi_lanes[1], hi_lanes[3]));
+    boundingBoxScalar(points, i, count, min, max);
+}
+
+#elif defined(CURA_POLYGONS_SOA_NEON)
+
+int pointInEdgesNeon(const coord_t* x0, const coord_t* y0, const coord_t* x1, const coord_t* y1, size_t count, const Point2LL p)
+{
+    const int64x2_t px = vdupq_n_s64(p.X);
+    const int64x2_t py = vdupq_n_s64(p.Y);
+    const int64x2_t zero = vdupq_n_s64(0);
+    const float64x2_t zero_d = vdupq_n_f64(0.0);
+    const uint64x2_t all = vdupq_n_u64(~uint64_t(0));
+    uint64x2_t border = vdupq_n_u64(0);
+    uint64x2_t flips = vdupq_n_u64(0);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const int64x2_t ax = vsubq_s64(vld1q_s64(x0 + i), px);
+        const int64x2_t ay = vsubq_s64(vld1q_s64(y0 + i), py);
+        const int64x2_t bx = vsubq_s64(vld1q_s64(x1 + i), px);
+        const int64x2_t by = vsubq_s64(vld1q_s64(y1 + i), py);
+
+        const uint64x2_t ax_neg = vcltq_s64(ax, zero);
+        const uint64x2_t ax_nonneg = veorq_u64(ax_neg, all);
+        const uint64x2_t bx_pos = vcgtq_s64(bx, zero);
+
+        // The end vertex lies on the point, or the edge is horizontal through it.
+        const uint64x2_t x_straddles = veorq_u64(veorq_u64(bx_pos, ax_neg), all);
+        const uint64x2_t on_horizontal = vorrq_u64(vceqq_s64(bx, zero), vandq_u64(vceqq_s64(ay, zero), x_straddles));
+        border = vorrq_u64(border, vandq_u64(vceqq_s64(by, zero), on_horizontal));
+
+        const uint64x2_t crosses_y = veorq_u64(vcltq_s64(ay, zero), vcltq_s64(by, zero));
+        flips = veorq_u64(flips, vandq_u64(crosses_y, vandq_u64(ax_nonneg, bx_pos)));
+
+        // The edge passes the horizontal ray on one side in X, so the side of the cross product decides.
+        const uint64x2_t needs_cross = vandq_u64(crosses_y, veorq_u64(ax_nonneg, bx_pos));
+        const float64x2_t d = vsubq_f64(vmulq_f64(vcvtq_f64_s64(ax), vcvtq_f64_s64(by)), vmulq_f64(vcvtq_f64_s64(bx), vcvtq_f64_s64(ay)));
+        const uint64x2_t d_zero = vceqq_f64(d, zero_d);
+        const uint64x2_t upward = vcgtq_s64(by, ay);
+        border = vorrq_u64(border, vandq_u64(needs_cross, d_zero));
+        const uint64x2_t same_side = veorq_u64(veorq_u64(vcgtq_f64(d, zero_d), upward), all);
+        flips = veorq_u64(flips, vbicq_u64(vandq_u64(needs_cross, same_side), d_zero));
+    }
+    if ((vgetq_lane_u64(border, 0) | vgetq_lane_u64(border, 1)) != 0)
+    {
+        return -1;
+    }
+    const int tail = pointInEdgesScalar(x0, y0, x1, y1, i, count, p);
+    if (tail == -1)
+    {
+        return -1;
+    }
+    return static_cast<int>((vgetq_lane_u64(flips, 0) & 1) + (vgetq_lane_u64(flips, 1) & 1) + tail) & 1;
+}
+
+void boundingBoxNeon(const Point2LL* points, size_t count, Point2LL& min, Point2LL& max)
+{
+    // One point per register: [x, y].
+    const int64_t min_init[2] = { min.X, min.Y };
+    const int64_t max_init[2] = { max.X, max.Y };
+    int64x2_t lo = vld1q_s64(min_init);
+    int64x2_t hi = vld1q_s64(max_init);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const int64x2_t v = vld1q_s64(reinterpret_cast<const int64_t*>(points + i));
+        lo = vbslq_s64(vcgtq_s64(lo, v), v, lo);
+        hi = vbslq_s64(vcgtq_s64(v, hi), v, hi);
+    }
+    min = Point2LL(vgetq_lane_s64(lo, 0), vgetq_lane_s64(lo, 1));
+    max = Point2LL(vgetq_lane_s64(hi, 0), vgetq_lane_s64(hi, 1));
+}
+
+#endif
+
+} // namespace
+
+PolygonsSoA::PolygonsSoA(const Polygons& polygons, size_t min_vertices)
+    : source_(polygons)
+    , min_(POINT_MAX, POINT_MAX)
+    , max_(POINT_MIN, POINT_MIN)
+{
+    size_t vertex_count = 0;
+    size_t edge_count = 0;
+    for (const ClipperLib::Path& path : polygons.paths)
+    {
+        vertex_count += path.size();
+        if (path.size() >= 3)
+        {
+            edge_count += path.size();
+        }
+        boundingBox(path.data(), path.size(), min_, max_);
+    }
+    coordinates_in_simd_range_ = vertex_count == 0 || (inSimdRange(min_) && inSimdRange(max_));
+    if (vertex_count < min_vertices)
+    {
+        return;
+    }
+
+    flattened_ = true;
+    x0_.reserve(edge_count);
+    y0_.reserve(edge_count);
+    x1_.reserve(edge_count);
+    y1_.reserve(edge_count);
+    for (const ClipperLib::Path& path : polygons.paths)
+    {
+        if (path.size() < 3)
+        {
+            continue;
+        }
+        // Same edge order as ClipperLib::PointInPolygon: from each vertex to the next, and finally back to the start.
+        for (size_t point_idx = 0; point_idx < path.size(); ++point_idx)
+        {
+            const Point2LL& start = path[point_idx];
+            const Point2LL& end = path[(point_idx + 1) % path.size()];
+            x0_.push_back(start.X);
+            y0_.push_back(start.Y);
+            x1_.push_back(end.X);
+            y1_.push_back(end.Y);
+        }
+    }
+}
+
+bool PolygonsSoA::isFlattened() const
+{
+    return flattened_;
+}
+
+bool PolygonsSoA::isSimdAvailable()
+{
+    return simdLevel() != SimdLevel::NONE;
+}
+
+bool PolygonsSoA::inside(Point2LL p, bool border_result) const
+{
+    if (! flattened_)
+    {
+        return source_.inside(p, border_result);
+    }
+    const size_t count = x0_.size();
+    int result;
+    if (coordinates_in_simd_range_ && inSimdRange(p) && simdLevel() != SimdLevel::NONE)
+    {
+#if defined(CURA_POLYGONS_SOA_AVX2)
+        result = pointInEdgesAvx2(x0_.data(), y0_.data(), x1_.data(), y1_.data(), count, p);
+#elif defined(CURA_POLYGONS_SOA_NEON)
+        result = pointInEdgesNeon(x0_.data(), y0_.data(), x1_.data(), y1_.data(), count, p);
+#else
+        result = pointInEdgesScalar(x0_.data(), y0_.data(), x1_.data(), y1_.data(), 0, count, p);
+#endif
+    }
+    else
+    {
+        result = pointInEdgesScalar(x0_.data(), y0_.data(), x1_.data(), y1_.data(), 0, count, p);
+    }
+    if (result == -1)
+    {
+        return border_result;
+    }
+    return result == 1;
+}
+
+Point2LL PolygonsSoA::min() const
+{
+    return min_;
+}
+
+Point2LL PolygonsSoA::max() const
+{
+    return max_;
+}
+
+void PolygonsSoA::boundingBox(const Point2LL* points, size_t count, Point2LL& min, Point2LL& max)
+{
+#if defined(CURA_POLYGONS_SOA_AVX2)
+    if (simdLevel() == SimdLevel::AVX2)
+    {
+        boundingBoxAvx2(points, count, min, max);
+        return;
+    }
+#elif defined(CURA_POLYGONS_SOA_NEON)
+    boundingBoxNeon(points, count, min, max);
+    return;
+#endif
+    boundingBoxScalar(points, 0, count, min, max);
+}
+
+} // namespace cura
@@ -0,0 +1,123 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/SeamCornerCache.h"
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "utils/Counters.h"
+
+namespace cura
+{
+
+namespace
+{
+
+/*!
+ * The most vertices that are remembered at once. Each takes about 24 bytes.
+ */
+constexpr size_t max_cached_vertices = size_t(1) << 20;
+
+struct Entry
+{
+    std::vector<Point2LL> shape; //!< The offsets of the vertices to the first vertex.
+    std::shared_ptr<const SeamCornerCache::Angles> angles;
+};
+
+struct CacheState
+{
+    std::shared_mutex mutex;
+    std::unordered_multimap<size_t, Entry> entries; //!< By the hash of their shape.
+    size_t vertex_count = 0;
+};
+
+CacheState& state()
+{
+    static CacheState cache_state;
+    return cache_state;
+}
+
+size_t hashShape(ConstPolygonRef polygon)
+{
+    const Point2LL& origin = polygon.front();
+    size_t hash = polygon.size();
+    for (const Point2LL& point : polygon)
+    {
+        const Point2LL offset = point - origin;
+        hash ^= std::hash<Point2LL>()(offset) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+bool hasShape(const Entry& entry, ConstPolygonRef polygon)
+{
+    const Point2LL& origin = polygon.front();
+    return std::equal(
+        entry.shape.begin(),
+        entry.shape.end(),
+        polygon.begin(),
+        polygon.end(),
+        [&origin](const Point2LL& offset, const Point2LL& point)
+        {
+            return offset == point - origin;
+        });
+}
+
+} // namespace
+
+std::shared_ptr<const SeamCornerCache::Angles> SeamCornerCache::get(ConstPolygonRef polygon, const std::function<Angles()>& compute_angles)
+{
+    if (polygon.empty())
+    {
+        return std::make_shared<const Angles>(compute_angles());
+    }
+
+    CacheState& cache = state();
+    const size_t hash = hashShape(polygon);
+    {
+        std::shared_lock lock(cache.mutex);
+        const auto [begin, end] = cache.entries.equal_range(hash);
+        for (auto entry = begin; entry != end; ++entry)
+        {
+            if (hasShape(entry->second, polygon))
+            {
+                Counters::add(Counter::SEAM_CORNER_CACHE_HITS);
+                return entry->second.angles;
+            }
+        }
+    }
+    Counters::add(Counter::SEAM_CORNER_CACHE_MISSES);
+
+    // Computed without holding the lock. If another thread computes the same polygon at the same time, both results are equal anyway.
+    Entry entry;
+    entry.shape.reserve(polygon.size());
+    for (const Point2LL& point : polygon)
+    {
+        entry.shape.push_back(point - polygon.front());
+    }
+    entry.angles = std::make_shared<const Angles>(compute_angles());
+    std::shared_ptr<const Angles> angles = entry.angles;
+
+    std::unique_lock lock(cache.mutex);
+    if (cache.vertex_count + polygon.size() > max_cached_vertices)
+    {
+        cache.entries.clear();
+        cache.vertex_count = 0;
+    }
+    cache.vertex_count += polygon.size();
+    cache.entries.emplace(hash, std::move(entry));
+    return angles;
+}
+
+void SeamCornerCache::clear()
+{
+    CacheState& cache = state();
+    std::unique_lock lock(cache.mutex);
+    cache.entries.clear();
+    cache.vertex_count = 0;
+}
+
+} // namespace cura
@@ -3,9 +3,6 @@
 
 #include "utils/Simplify.h"
 
-#include <limits>
-#include <queue> //Priority queue to prioritise removing unimportant vertices.
-
 namespace cura
 {
 
@@ -67,20 +64,15 @@ ExtrusionLine Simplify::polyline(const ExtrusionLine& polyline) const
     return simplify(polyline, is_closed);
 }
 
-size_t Simplify::nextNotDeleted(size_t index, const std::vector<bool>& to_delete) const
-{
-    const size_t size = to_delete.size();
-    for (index = (index + 1) % size; to_delete[index]; index = (index + 1) % size)
-        ; // Changes the index variable in-place until we found one that is not deleted.
-    return index;
-}
-
-size_t Simplify::previousNotDeleted(size_t index, const std::vector<bool>& to_delete) const
+Simplify::RemainingVertices::RemainingVertices(const size_t size)
+    : previous_(size)
+    , next_(size)
 {
-    const size_t size = to_delete.size();
-    for (index = (index + size - 1) % size; to_delete[index]; index = (index + size - 1) % size)
-        ; // Changes the index variable in-place until we found one that is not deleted.
-    return index;
+    for (size_t i = 0; i < size; ++i)
+    {
+        previous_[i] = (i + size - 1) % size;
+        next_[i] = (i + 1) % size;
+    }
 }
 
 Polygon Simplify::createEmpty([[maybe_unused]] const Polygon& original) const
@@ -0,0 +1,171 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/Trace.h"
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace cura
+{
+
+namespace
+{
+
+struct TraceEvent
+{
+    const char* name;
+    int64_t start_us;
+    int64_t duration_us;
+    int64_t layer_nr;
+    std::string mesh;
+};
+
+/*!
+ * The spans recorded by one thread. Only that thread appends to it.
+ */
+struct ThreadBuffer
+{
+    size_t thread_idx;
+    std::vector<TraceEvent> events;
+};
+
+struct TraceState
+{
+    std::mutex mutex; //!< Guards the list of buffers, not their contents.
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers; //!< Owned here rather than by the threads, so that they survive threads that end before the trace is written.
+    std::filesystem::path output_file;
+    std::chrono::steady_clock::time_point start;
+};
+
+TraceState& state()
+{
+    static TraceState trace_state;
+    return trace_state;
+}
+
+ThreadBuffer& threadBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr)
+    {
+        TraceState& trace_state = state();
+        std::lock_guard<std::mutex> lock(trace_state.mutex);
+        buffer = trace_state.buffers.emplace_back(std::make_unique<ThreadBuffer>(ThreadBuffer{ trace_state.buffers.size(), {} })).get();
+    }
+    return *buffer;
+}
+
+/*!
+ * Write a string as a JSON string literal.
+ */
+void writeJsonString(std::ostream& out, const std::string_view str)
+{
+    out << '"';
+    for (const char c : str)
+    {
+        switch (c)
+        {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out << fmt::format("\\u{:04x}", static_cast<int>(c));
+            }
+            else
+            {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+std::atomic<bool> Trace::enabled_{ false };
+
+void Trace::enable(const std::filesystem::path& output_file)
+{
+    TraceState& trace_state = state();
+    {
+        std::lock_guard<std::mutex> lock(trace_state.mutex);
+        trace_state.output_file = output_file;
+        trace_state.start = std::chrono::steady_clock::now();
+    }
+    enabled_.store(true, std::memory_order_relaxed);
+    spdlog::info("Recording a performance trace to {}", output_file.string());
+}
+
+void Trace::record(const char* name, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end, int64_t layer_nr, std::string_view mesh)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    const std::chrono::steady_clock::time_point trace_start = state().start; // Only written before tracing is enabled.
+    threadBuffer().events.push_back(TraceEvent{ .name = name,
+                                                .start_us = duration_cast<microseconds>(start - trace_start).count(),
+                                                .duration_us = duration_cast<microseconds>(end - start).count(),
+                                                .layer_nr = layer_nr,
+                                                .mesh = std::string(mesh) });
+}
+
+void Trace::write()
+{
+    if (! isEnabled())
+    {
+        return;
+    }
+    enabled_.store(false, std::memory_order_relaxed);
+
+    TraceState& trace_state = state();
+    std::lock_guard<std::mutex> lock(trace_state.mutex);
+    std::ofstream out(trace_state.output_file);
+    if (! out)
+    {
+        spdlog::error("Couldn't open {} to write the performance trace.", trace_state.output_file.string());
+        return;
+    }
+
+    size_t event_count = 0;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : trace_state.buffers)
+    {
+        out << (first ? "" : ",\n") << fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{0},"args":{{"name":"thread {0}"}}}})", buffer->thread_idx);
+        first = false;
+        for (const TraceEvent& event : buffer->events)
+        {
+            out << ",\n";
+            out << fmt::format(R"({{"ph":"X","pid":1,"tid":{},"ts":{},"dur":{},"name":)", buffer->thread_idx, event.start_us, event.duration_us);
+            writeJsonString(out, event.name);
+            out << ",\"args\":{";
+            if (event.layer_nr != TraceSpan::no_layer)
+            {
+                out << fmt::format(R"("layer":{})", event.layer_nr) << (event.mesh.empty() ? "" : ",");
+            }
+            if (! event.mesh.empty())
+            {
+                out << "\"mesh\":";
+                writeJsonString(out, event.mesh);
+            }
+            out << "}}";
+        }
+        event_count += buffer->events.size();
+        buffer->events.clear();
+    }
+    out << "\n]}\n";
+    spdlog::info("Wrote {} trace events to {}", event_count, trace_state.output_file.string());
+}
+
+} // namespace cura
@@ -76,10 +76,10 @@ bool ConstPolygonRef::_inside(Point2LL p, bool border_result) const
 Polygons ConstPolygonRef::intersection(const ConstPolygonRef& other) const
 {
     Polygons ret;
-    ClipperLib::Clipper clipper(clipper_init);
-    clipper.AddPath(*path, ClipperLib::ptSubject, true);
-    clipper.AddPath(*other.path, ClipperLib::ptClip, true);
-    clipper.Execute(ClipperLib::ctIntersection, ret.paths);
+    PooledClipperBoolean clipper;
+    clipper->AddPath(*path, ClipperLib::ptSubject, true);
+    clipper->AddPath(*other.path, ClipperLib::ptClip, true);
+    clipper->Execute(ClipperLib::ctIntersection, ret.paths);
     return ret;
 }
 
@@ -99,9 +99,9 @@ Polygons Polygons::approxConvexHull(int extra_outset)
     for (const ClipperLib::Path& path : paths)
     {
         Polygons offset_result;
-        ClipperLib::ClipperOffset offsetter(1.2, 10.0);
-        offsetter.AddPath(path, ClipperLib::jtRound, ClipperLib::etClosedPolygon);
-        offsetter.Execute(offset_result.paths, overshoot);
+        PooledClipperOffset offsetter(1.2, 10.0);
+        offsetter->AddPath(path, ClipperLib::jtRound, ClipperLib::etClosedPolygon);
+        offsetter->Execute(offset_result.paths, overshoot);
         convex_hull.add(offset_result);
     }
     return convex_hull.unionPolygons().offset(-overshoot + extra_outset, ClipperLib::jtRound);
@@ -306,10 +306,11 @@ Polygons Polygons::intersectionPolyLines(const Polygons& polylines, bool restitc
     Polygons split_polylines = polylines.splitPolylinesIntoSegments();
 
     ClipperLib::PolyTree result;
-    ClipperLib::Clipper clipper(clipper_init);
-    clipper.AddPaths(split_polylines.paths, ClipperLib::ptSubject, false);
-    clipper.AddPaths(paths, ClipperLib::ptClip, true);
-    clipper.Execute(ClipperLib::ctIntersection, result);
+    countBooleanOperation(split_polylines.paths, paths);
+    PooledClipperBoolean clipper;
+    clipper->AddPaths(split_polylines.paths, ClipperLib::ptSubject, false);
+    clipper->AddPaths(paths, ClipperLib::ptClip, true);
+    clipper->Execute(ClipperLib::ctIntersection, result);
     Polygons ret;
     ClipperLib::OpenPathsFromPolyTree(result, ret.paths);
 
@@ -390,10 +391,57 @@ Polygons Polygons::offset(coord_t distance, ClipperLib::JoinType join_type, doub
         return *this;
     }
     Polygons ret;
-    ClipperLib::ClipperOffset clipper(miter_limit, 10.0);
-    clipper.AddPaths(unionPolygons().paths, join_type, ClipperLib::etClosedPolygon);
-    clipper.MiterLimit = miter_limit;
-    clipper.Execute(ret.paths, distance);
+    const Polygons unioned = unionPolygons();
+    countOffset(unioned.paths);
+    PooledClipperOffset clipper(miter_limit, 10.0);
+    clipper->AddPaths(unioned.paths, join_type, ClipperLib::etClosedPolygon);
+    clipper->Execute(ret.paths, distance);
+    return ret;
+}
+
+Polygons Polygons::offsetSequence(const std::vector<coord_t>& distances, ClipperLib::JoinType join_type, double miter_limit) const
+{
+    if (std::all_of(
+            distances.begin(),
+            distances.end(),
+            [](const coord_t distance)
+            {
+                return distance == 0;
+            }))
+    {
+        return *this;
+    }
+    Polygons ret = unionPolygons();
+    for (const coord_t distance : distances)
+    {
+        if (distance == 0)
+        {
+            continue;
+        }
+        countOffset(ret.paths);
+        PooledClipperOffset clipper(miter_limit, 10.0);
+        clipper->AddPaths(ret.paths, join_type, ClipperLib::etClosedPolygon);
+        clipper->Execute(ret.paths, distance);
+    }
+    return ret;
+}
+
+std::vector<Polygons> Polygons::offsetMulti(const std::vector<coord_t>& distances, ClipperLib::JoinType join_type, double miter_limit) const
+{
+    std::vector<Polygons> ret(distances.size());
+    const Polygons unioned = unionPolygons();
+    PooledClipperOffset clipper(miter_limit, 10.0);
+    clipper->AddPaths(unioned.paths, join_type, ClipperLib::etClosedPolygon);
+    for (size_t distance_idx = 0; distance_idx < distances.size(); ++distance_idx)
+    {
+        if (distances[distance_idx] == 0)
+        {
+            ret[distance_idx] = *this;
+            continue;
+        }
+        countOffset(unioned.paths);
+        clipper->Execute(ret[distance_idx].paths, distances[distance_idx]);
+    }
     return ret;
 }
 
@@ -454,10 +502,10 @@ Polygons ConstPolygonRef::offset(int distance, ClipperLib::JoinType join_type, d
         return ret;
     }
     Polygons ret;
-    ClipperLib::ClipperOffset clipper(miter_limit, 10.0);
-    clipper.AddPath(*path, join_type, ClipperLib::etClosedPolygon);
-    clipper.MiterLimit = miter_limit;
-    clipper.Execute(ret.paths, distance);
+    Polygons::countOffset(std::span<const ClipperLib::Path>(path, 1));
+    PooledClipperOffset clipper(miter_limit, 10.0);
+    clipper->AddPath(*path, join_type, ClipperLib::etClosedPolygon);
+    clipper->Execute(ret.paths, distance);
     return ret;
 }
 
@@ -557,11 +605,11 @@ void PolygonRef::applyMatrix(const Point3Matrix& matrix)
 Polygons Polygons::getOutsidePolygons() const
 {
     Polygons ret;
-    ClipperLib::Clipper clipper(clipper_init);
+    PooledClipperBoolean clipper;
     ClipperLib::PolyTree poly_tree;
     constexpr bool paths_are_closed_polys = true;
-    clipper.AddPaths(paths, ClipperLib::ptSubject, paths_are_closed_polys);
-    clipper.Execute(ClipperLib::ctUnion, poly_tree);
+    clipper->AddPaths(paths, ClipperLib::ptSubject, paths_are_closed_polys);
+    clipper->Execute(ClipperLib::ctUnion, poly_tree);
 
     for (int outer_poly_idx = 0; outer_poly_idx < poly_tree.ChildCount(); outer_poly_idx++)
     {
@@ -1496,13 +1544,13 @@ double Polygons::area() const
 std::vector<PolygonsPart> Polygons::splitIntoParts(bool unionAll) const
 {
     std::vector<PolygonsPart> ret;
-    ClipperLib::Clipper clipper(clipper_init);
+    PooledClipperBoolean clipper;
     ClipperLib::PolyTree resultPolyTree;
-    clipper.AddPaths(paths, ClipperLib::ptSubject, true);
+    clipper->AddPaths(paths, ClipperLib::ptSubject, true);
     if (unionAll)
-        clipper.Execute(ClipperLib::ctUnion, resultPolyTree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        clipper->Execute(ClipperLib::ctUnion, resultPolyTree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     else
-        clipper.Execute(ClipperLib::ctUnion, resultPolyTree);
+        clipper->Execute(ClipperLib::ctUnion, resultPolyTree);
 
     splitIntoParts_processPolyTreeNode(&resultPolyTree, ret);
     return ret;
@@ -1527,10 +1575,10 @@ void Polygons::splitIntoParts_processPolyTreeNode(ClipperLib::PolyNode* node, st
 std::vector<Polygons> Polygons::sortByNesting() const
 {
     std::vector<Polygons> ret;
-    ClipperLib::Clipper clipper(clipper_init);
+    PooledClipperBoolean clipper;
     ClipperLib::PolyTree resultPolyTree;
-    clipper.AddPaths(paths, ClipperLib::ptSubject, true);
-    clipper.Execute(ClipperLib::ctUnion, resultPolyTree);
+    clipper->AddPaths(paths, ClipperLib::ptSubject, true);
+    clipper->Execute(ClipperLib::ctUnion, resultPolyTree);
 
     sortByNesting_processPolyTreeNode(&resultPolyTree, 0, ret);
     return ret;
@@ -1659,13 +1707,13 @@ PartsView Polygons::splitIntoPartsView(bool unionAll)
 {
     Polygons reordered;
     PartsView partsView(*this);
-    ClipperLib::Clipper clipper(clipper_init);
+    PooledClipperBoolean clipper;
     ClipperLib::PolyTree resultPolyTree;
-    clipper.AddPaths(paths, ClipperLib::ptSubject, true);
+    clipper->AddPaths(paths, ClipperLib::ptSubject, true);
     if (unionAll)
-        clipper.Execute(ClipperLib::ctUnion, resultPolyTree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
+        clipper->Execute(ClipperLib::ctUnion, resultPolyTree, ClipperLib::pftNonZero, ClipperLib::pftNonZero);
     else
-        clipper.Execute(ClipperLib::ctUnion, resultPolyTree);
+        clipper->Execute(ClipperLib::ctUnion, resultPolyTree);
 
     splitIntoPartsView_processPolyTreeNode(partsView, reordered, &resultPolyTree);
 
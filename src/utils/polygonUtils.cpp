@@ -994,6 +994,7 @@ std::unique_ptr<LocToLineGrid> PolygonUtils::createLocToLineGrid(const Polygons&
             ret->insert(PolygonsPointIndex(&polygons, poly_idx, point_idx));
         }
     }
+    ret->compact();
     return ret;
 }
 
@@ -1,14 +1,27 @@
-// Copyright (c) 2023 UltiMaker
+// Copyright (c) 2024 UltiMaker
 // CuraEngine is released under the terms of the AGPLv3 or higher
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <csignal>
 #include <docopt/docopt.h>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <sched.h>
+#include <source_location>
+#include <sstream>
 #include <string_view>
+#include <sys/mman.h>
 #include <sys/wait.h>
+#include <thread>
 #include <unistd.h>
 #include <vector>
 
@@ -20,11 +33,16 @@
 #include <spdlog/spdlog.h>
 
 #include "WallsComputation.h"
+#include "infill.h"
 #include "rapidjson/document.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
+#include "settings/EnumSettings.h"
 #include "settings/Settings.h"
+#include "settings/types/Angle.h"
+#include "settings/types/LayerIndex.h"
 #include "sliceDataStorage.h"
+#include "utils/Counters.h"
 #include "utils/polygon.h"
 
 
@@ -33,14 +51,19 @@ constexpr std::string_view USAGE = R"(Stress Benchmark.
 Executes a Stress Benchmark on CuraEngine.
 
 Usage:
-  stress_benchmark -o FILE
+  stress_benchmark -o FILE [-n REPETITIONS] [-w WARMUPS] [-j JOBS] [-b BASELINE] [-t TOLERANCE]
   stress_benchmark (-h | --help)
   stress_benchmark --version
 
 Options:
-  -h --help                      Show this screen.
-  --version                      Show version.
-  -o FILE                        Specify the output Json file.
+  -h --help                                  Show this screen.
+  --version                                  Show version.
+  -o FILE                                    Specify the output Json file.
+  -n REPETITIONS --repetitions=REPETITIONS   Number of timed runs of every test case [default: 1].
+  -w WARMUPS --warmups=WARMUPS               Number of untimed runs before the timed runs [default: 0].
+  -j JOBS --jobs=JOBS                        Number of test cases to run at the same time, 0 for one per core [default: 0].
+  -b BASELINE --baseline=BASELINE            Json file of an earlier run to check for regressions against.
+  -t TOLERANCE --tolerance=TOLERANCE         Percentage by which a timing may be slower than the baseline [default: 10].
 )";
 
 struct Resource
@@ -142,21 +165,323 @@ std::vector<Resource> getResources()
     return resources;
 }
 
-void handleChildProcess(const auto& shapes, const auto& settings)
+/*!
+ * The stages of the engine that every test case runs, in this order.
+ */
+enum class Stage : size_t
 {
+    WALLS,
+    INFILL,
+    SKIN,
+    SUPPORT,
+    COUNT // Not a stage, but the number of stages.
+};
+
+constexpr size_t stage_count = static_cast<size_t>(Stage::COUNT);
+constexpr std::array<std::string_view, stage_count> stage_names{ "Walls", "Infill", "Skin", "Support" };
+
+/*!
+ * Upper limit to the number of repetitions, so that the timings of a test case
+ * always fit in the buffer of the pipe they are sent through.
+ */
+constexpr size_t max_repetitions = 1000;
+
+/*!
+ * The time a single repetition of a test case may take before it's killed and
+ * counted as a crash.
+ */
+constexpr std::chrono::seconds repetition_timeout{ 30 };
+
+struct Options
+{
+    std::filesystem::path output_file;
+    size_t repetitions;
+    size_t warmups;
+    size_t jobs;
+    std::optional<std::filesystem::path> baseline_file;
+    double tolerance; // Fraction by which a timing may exceed the baseline before it's a regression.
+};
+
+/*!
+ * The timings of one repetition of a test case, in milliseconds per stage.
+ */
+using StageTimes = std::array<double, stage_count>;
+
+/*!
+ * Summary of the timings of one stage over all repetitions.
+ */
+struct Statistics
+{
+    double median;
+    double p95;
+    double ci_low; // Lower bound of the 95% confidence interval of the median.
+    double ci_high; // Upper bound of the 95% confidence interval of the median.
+};
+
+struct CaseResult
+{
+    bool crashed{ false };
+    Stage crashed_stage{ Stage::WALLS }; // The stage that was running when the test case crashed.
+    std::vector<StageTimes> times; // The timings of every repetition.
+    std::array<Statistics, stage_count> stages{};
+};
+
+/*!
+ * Patterns that need the 3D structures of a whole mesh can't be generated on a
+ * single layer. Those are replaced by grid infill, which is similar in cost.
+ */
+cura::EFillMethod planarPattern(const cura::EFillMethod pattern)
+{
+    switch (pattern)
+    {
+    case cura::EFillMethod::CUBICSUBDIV:
+    case cura::EFillMethod::CROSS:
+    case cura::EFillMethod::CROSS_3D:
+    case cura::EFillMethod::LIGHTNING:
+    case cura::EFillMethod::PLUGIN:
+        return cura::EFillMethod::GRID;
+    default:
+        return pattern;
+    }
+}
+
+void fillArea(
+    const cura::Polygons& area,
+    const cura::Settings& settings,
+    const cura::EFillMethod pattern,
+    const cura::coord_t line_width,
+    const cura::coord_t line_distance,
+    const cura::AngleDegrees angle,
+    const bool zig_zaggify,
+    const cura::SectionType section_type)
+{
+    if (area.empty() || line_distance == 0 || pattern == cura::EFillMethod::NONE)
+    {
+        return;
+    }
+    const cura::LayerIndex layer_idx(100);
+    cura::Infill infill(
+        planarPattern(pattern),
+        zig_zaggify,
+        settings.get<bool>("connect_infill_polygons"),
+        area,
+        line_width,
+        line_distance,
+        0,
+        settings.get<size_t>("infill_multiplier"),
+        angle,
+        layer_idx * settings.get<cura::coord_t>("layer_height"),
+        0,
+        settings.get<cura::coord_t>("meshfix_maximum_resolution"),
+        settings.get<cura::coord_t>("meshfix_maximum_deviation"));
+    std::vector<cura::VariableWidthLines> toolpaths;
+    cura::Polygons polygons;
+    cura::Polygons lines;
+    infill.generate(toolpaths, polygons, lines, settings, layer_idx, section_type);
+}
+
+/*!
+ * Run all stages on the shapes of a test case once.
+ * \param current_stage Gets the stage that is running, so that the parent
+ * process knows which stage a crash happened in.
+ * \return The time each of the stages took, in milliseconds.
+ */
+StageTimes runStages(const std::vector<cura::Polygons>& shapes, const cura::Settings& settings, std::atomic<size_t>& current_stage)
+{
+    StageTimes times{};
+    const auto time_stage = [&times, &current_stage](const Stage stage, auto&& run)
+    {
+        current_stage.store(static_cast<size_t>(stage), std::memory_order_relaxed);
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        times[static_cast<size_t>(stage)] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
     cura::SliceLayer layer;
-    for (const cura::Polygons& shape : shapes)
+    time_stage(
+        Stage::WALLS,
+        [&]()
+        {
+            for (const cura::Polygons& shape : shapes)
+            {
+                layer.parts.emplace_back();
+                cura::SliceLayerPart& part = layer.parts.back();
+                part.outline.add(shape);
+            }
+            cura::LayerIndex layer_idx(100);
+            cura::WallsComputation walls_computation(settings, layer_idx);
+            walls_computation.generateWalls(&layer, cura::SectionType::WALL);
+        });
+
+    // The other stages fill the areas that the walls leave, or in the case of support, the shapes themselves.
+    time_stage(
+        Stage::INFILL,
+        [&]()
+        {
+            for (const cura::SliceLayerPart& part : layer.parts)
+            {
+                fillArea(
+                    part.inner_area,
+                    settings,
+                    settings.get<cura::EFillMethod>("infill_pattern"),
+                    settings.get<cura::coord_t>("infill_line_width"),
+                    settings.get<cura::coord_t>("infill_line_distance"),
+                    cura::AngleDegrees(45),
+                    settings.get<bool>("zig_zaggify_infill"),
+                    cura::SectionType::INFILL);
+            }
+        });
+    time_stage(
+        Stage::SKIN,
+        [&]()
+        {
+            for (const cura::SliceLayerPart& part : layer.parts)
+            {
+                const cura::coord_t skin_line_width = settings.get<cura::coord_t>("skin_line_width");
+                fillArea(
+                    part.inner_area,
+                    settings,
+                    settings.get<cura::EFillMethod>("top_bottom_pattern"),
+                    skin_line_width,
+                    skin_line_width,
+                    cura::AngleDegrees(45),
+                    false,
+                    cura::SectionType::SKIN);
+            }
+        });
+    time_stage(
+        Stage::SUPPORT,
+        [&]()
+        {
+            for (const cura::SliceLayerPart& part : layer.parts)
+            {
+                fillArea(
+                    part.outline,
+                    settings,
+                    settings.get<cura::EFillMethod>("support_pattern"),
+                    settings.get<cura::coord_t>("support_line_width"),
+                    settings.get<cura::coord_t>("support_line_distance"),
+                    cura::AngleDegrees(0),
+                    settings.get<bool>("zig_zaggify_support"),
+                    cura::SectionType::SUPPORT);
+            }
+        });
+    return times;
+}
+
+/*!
+ * Keep this process on one core, so that concurrent test cases don't migrate
+ * between cores and disturb each other's caches.
+ */
+void pinToCore([[maybe_unused]] const size_t core)
+{
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(core, &cpu_set);
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == -1)
     {
-        layer.parts.emplace_back();
-        cura::SliceLayerPart& part = layer.parts.back();
-        part.outline.add(shape);
+        spdlog::warn("Unable to pin test case to core {}", core);
     }
-    cura::LayerIndex layer_idx(100);
-    cura::WallsComputation walls_computation(settings, layer_idx);
-    walls_computation.generateWalls(&layer, cura::SectionType::WALL);
+#endif
+}
+
+[[noreturn]] void handleChildProcess(const Resource& resource, const Options& options, const size_t core, const int results_fd, std::atomic<size_t>& current_stage)
+{
+    pinToCore(core);
+    const std::vector<cura::Polygons> shapes = resource.polygons();
+    const cura::Settings settings = resource.settings();
+
+    // The counters are deterministic, so they are taken from the first run only.
+    std::vector<StageTimes> times;
+    cura::Counters::Snapshot counters;
+    for (size_t run = 0; run < options.warmups + options.repetitions; ++run)
+    {
+        const StageTimes run_times = runStages(shapes, settings, current_stage);
+        if (run == 0)
+        {
+            counters = cura::Counters::snapshot();
+        }
+        if (run >= options.warmups)
+        {
+            times.push_back(run_times);
+        }
+    }
+
+    // Hand the results of this test case to the parent process. Nothing is written if the engine crashes.
+    [[maybe_unused]] auto written = write(results_fd, times.data(), times.size() * sizeof(StageTimes));
+    written = write(results_fd, &counters, sizeof(counters));
     exit(EXIT_SUCCESS);
 }
 
+/*!
+ * The median, 95th percentile and a distribution-free 95% confidence interval
+ * of the median, which is taken from the order statistics of the samples so
+ * that it holds for the skewed distributions timings tend to have.
+ */
+Statistics computeStatistics(std::vector<double> samples)
+{
+    std::ranges::sort(samples);
+    const size_t n = samples.size();
+    const auto quantile = [&samples, n](const double fraction)
+    {
+        const double position = fraction * static_cast<double>(n - 1);
+        const auto below = static_cast<size_t>(std::floor(position));
+        const size_t above = std::min(below + 1, n - 1);
+        return samples[below] + (position - static_cast<double>(below)) * (samples[above] - samples[below]);
+    };
+
+    const double half_width = 0.98 * std::sqrt(static_cast<double>(n)); // 1.96 standard deviations of the binomial distribution of the rank of the median.
+    const double low_rank = std::floor(static_cast<double>(n) / 2.0 - half_width);
+    const double high_rank = std::ceil(static_cast<double>(n) / 2.0 + half_width);
+    return Statistics{ .median = quantile(0.5),
+                       .p95 = quantile(0.95),
+                       .ci_low = samples[static_cast<size_t>(std::max(low_rank, 0.0))],
+                       .ci_high = samples[static_cast<size_t>(std::min(high_rank, static_cast<double>(n - 1)))] };
+}
+
+/*!
+ * Read the results that a child process sent.
+ * \return Whether the results were complete.
+ */
+bool readResults(const int results_fd, const Options& options, CaseResult& result, cura::Counters::Snapshot& counters)
+{
+    std::vector<StageTimes>& times = result.times;
+    times.resize(options.repetitions);
+    const auto read_exactly = [results_fd](void* data, const size_t size)
+    {
+        size_t total = 0;
+        while (total < size)
+        {
+            const auto bytes = read(results_fd, static_cast<char*>(data) + total, size - total);
+            if (bytes <= 0)
+            {
+                return false;
+            }
+            total += static_cast<size_t>(bytes);
+        }
+        return true;
+    };
+    cura::Counters::Snapshot case_counters;
+    if (! read_exactly(times.data(), times.size() * sizeof(StageTimes)) || ! read_exactly(&case_counters, sizeof(case_counters)))
+    {
+        return false;
+    }
+    counters += case_counters;
+
+    for (size_t stage_idx = 0; stage_idx < stage_count; ++stage_idx)
+    {
+        std::vector<double> samples;
+        samples.reserve(times.size());
+        for (const StageTimes& run_times : times)
+        {
+            samples.push_back(run_times[stage_idx]);
+        }
+        result.stages[stage_idx] = computeStatistics(std::move(samples));
+    }
+    return true;
+}
+
 size_t checkCrashCount(size_t crashCount, int status, const auto& resource)
 {
     if (WIFSIGNALED(status))
@@ -171,6 +496,106 @@ size_t checkCrashCount(size_t crashCount, int status, const auto& resource)
     return crashCount;
 }
 
+/*!
+ * A test case that is running in a child process.
+ */
+struct RunningCase
+{
+    size_t resource_idx;
+    size_t core;
+    int results_fd;
+    std::atomic<size_t>* current_stage; // Shared with the child process.
+    std::chrono::steady_clock::time_point deadline;
+};
+
+/*!
+ * Run all test cases, each in a child process of its own so that a crash
+ * doesn't end the benchmark. Up to \ref Options::jobs test cases run at the
+ * same time, each pinned to a core of its own.
+ */
+std::vector<CaseResult> runCases(const std::vector<Resource>& resources, const Options& options, cura::Counters::Snapshot& counters)
+{
+    std::vector<CaseResult> results(resources.size());
+    std::map<pid_t, RunningCase> running;
+    std::vector<size_t> free_cores(options.jobs);
+    std::iota(free_cores.rbegin(), free_cores.rend(), 0);
+    const std::chrono::steady_clock::duration timeout = repetition_timeout * (options.warmups + options.repetitions);
+
+    size_t crash_count = 0;
+    size_t next_resource_idx = 0;
+    while (next_resource_idx < resources.size() || ! running.empty())
+    {
+        while (next_resource_idx < resources.size() && ! free_cores.empty())
+        {
+            const Resource& resource = resources[next_resource_idx];
+            spdlog::critical("Starting test case {}", resource.stem());
+            int results_pipe[2];
+            if (pipe(results_pipe) == -1)
+            {
+                spdlog::critical("Unable to create a pipe for the results");
+                exit(EXIT_FAILURE);
+            }
+            void* shared_memory = mmap(nullptr, sizeof(std::atomic<size_t>), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+            if (shared_memory == MAP_FAILED)
+            {
+                spdlog::critical("Unable to share the current stage with the engine");
+                exit(EXIT_FAILURE);
+            }
+            std::atomic<size_t>* current_stage = new (shared_memory) std::atomic<size_t>(static_cast<size_t>(Stage::WALLS));
+            const size_t core = free_cores.back();
+            const pid_t engine_pid = fork();
+            if (engine_pid == -1)
+            {
+                spdlog::critical("Unable to fork - engine");
+                exit(EXIT_FAILURE);
+            }
+            else if (engine_pid == 0)
+            {
+                close(results_pipe[0]);
+                handleChildProcess(resource, options, core, results_pipe[1], *current_stage);
+            }
+            close(results_pipe[1]); // So that reading the results ends if the engine crashes.
+            free_cores.pop_back();
+            running.emplace(engine_pid, RunningCase{ next_resource_idx, core, results_pipe[0], current_stage, std::chrono::steady_clock::now() + timeout });
+            ++next_resource_idx;
+        }
+
+        int status;
+        const pid_t finished_pid = waitpid(-1, &status, WNOHANG);
+        if (finished_pid <= 0)
+        {
+            const auto now = std::chrono::steady_clock::now();
+            for (const auto& [pid, running_case] : running)
+            {
+                if (now > running_case.deadline)
+                {
+                    kill(pid, SIGKILL);
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        const auto running_case = running.find(finished_pid);
+        if (running_case == running.end())
+        {
+            continue;
+        }
+        const RunningCase finished = running_case->second;
+        running.erase(running_case);
+        free_cores.push_back(finished.core);
+
+        const Resource& resource = resources[finished.resource_idx];
+        CaseResult& result = results[finished.resource_idx];
+        const auto old_crash_count = crash_count;
+        crash_count = checkCrashCount(crash_count, status, resource);
+        result.crashed = old_crash_count != crash_count || ! readResults(finished.results_fd, options, result, counters);
+        result.crashed_stage = static_cast<Stage>(finished.current_stage->load(std::memory_order_relaxed));
+        close(finished.results_fd);
+        munmap(finished.current_stage, sizeof(std::atomic<size_t>));
+    }
+    return results;
+}
+
 rapidjson::Value
     createRapidJSONObject(rapidjson::Document::AllocatorType& allocator, const std::string& test_name, const auto value, const std::string& unit, const std::string& extra_info)
 {
@@ -190,7 +615,120 @@ rapidjson::Value
     return obj;
 }
 
-void createAndWriteJson(const std::filesystem::path& out_file, double stress_level, const std::string& extra_info, const size_t no_test_cases)
+/*!
+ * A timing to report, with the confidence interval to compare it against the
+ * baseline with.
+ */
+struct Timing
+{
+    std::string name;
+    Statistics statistics;
+};
+
+/*!
+ * The timings per test case and stage, followed by the totals per stage.
+ *
+ * The statistics of a total are those of the sums of the repetitions of all
+ * test cases, not the sums of the statistics of the test cases, since the sum
+ * of the bounds of confidence intervals isn't a confidence interval of the sum.
+ */
+std::vector<Timing> collectTimings(const std::vector<Resource>& resources, const std::vector<CaseResult>& results, const size_t repetitions)
+{
+    std::vector<Timing> timings;
+    std::array<std::vector<double>, stage_count> totals;
+    totals.fill(std::vector<double>(repetitions, 0.0));
+    for (size_t resource_idx = 0; resource_idx < resources.size(); ++resource_idx)
+    {
+        const CaseResult& result = results[resource_idx];
+        if (result.crashed)
+        {
+            continue;
+        }
+        for (size_t stage_idx = 0; stage_idx < stage_count; ++stage_idx)
+        {
+            const Statistics& statistics = result.stages[stage_idx];
+            timings.push_back(Timing{ .name = fmt::format("{} {}", resources[resource_idx].stem(), stage_names[stage_idx]), .statistics = statistics });
+            for (size_t repetition = 0; repetition < repetitions; ++repetition)
+            {
+                totals[stage_idx][repetition] += result.times[repetition][stage_idx];
+            }
+        }
+    }
+    for (size_t stage_idx = 0; stage_idx < stage_count; ++stage_idx)
+    {
+        timings.push_back(Timing{ .name = fmt::format("{} total", stage_names[stage_idx]), .statistics = computeStatistics(std::move(totals[stage_idx])) });
+    }
+    return timings;
+}
+
+/*!
+ * Compare the timings against the medians in a previous output file.
+ *
+ * A timing only counts as a regression if even the lower bound of its
+ * confidence interval is slower than the baseline by more than the tolerance,
+ * so that noise doesn't fail the benchmark.
+ * \return The number of regressions.
+ */
+size_t compareToBaseline(const std::filesystem::path& baseline_file, const std::vector<Timing>& timings, const double tolerance)
+{
+    std::ifstream file{ baseline_file };
+    if (! file)
+    {
+        spdlog::critical("Failed to open the baseline: {}", baseline_file.string());
+        exit(EXIT_FAILURE);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    rapidjson::Document baseline;
+    baseline.Parse(buffer.str().c_str());
+    if (baseline.HasParseError() || ! baseline.IsArray())
+    {
+        spdlog::critical("The baseline is not a benchmark result: {}", baseline_file.string());
+        exit(EXIT_FAILURE);
+    }
+
+    std::map<std::string, double> baseline_medians;
+    for (const rapidjson::Value& entry : baseline.GetArray())
+    {
+        if (entry.HasMember("name") && entry.HasMember("value") && entry.HasMember("unit") && std::string_view(entry["unit"].GetString()) == "ms")
+        {
+            baseline_medians.emplace(entry["name"].GetString(), entry["value"].GetDouble());
+        }
+    }
+
+    size_t regression_count = 0;
+    for (const Timing& timing : timings)
+    {
+        const auto baseline_median = baseline_medians.find(timing.name);
+        if (baseline_median == baseline_medians.end())
+        {
+            continue;
+        }
+        if (timing.statistics.ci_low > baseline_median->second * (1.0 + tolerance))
+        {
+            ++regression_count;
+            spdlog::error(
+                "# Regression in {}: median {:.3f} ms (95% CI {:.3f} - {:.3f}), baseline {:.3f} ms",
+                timing.name,
+                timing.statistics.median,
+                timing.statistics.ci_low,
+                timing.statistics.ci_high,
+                baseline_median->second);
+        }
+    }
+    spdlog::info("{} regressions compared to {}", regression_count, baseline_file.string());
+    return regression_count;
+}
+
+void createAndWriteJson(
+    const std::filesystem::path& out_file,
+    double stress_level,
+    const std::string& extra_info,
+    double fill_stress_level,
+    const std::string& fill_extra_info,
+    const size_t no_test_cases,
+    const std::vector<Timing>& timings,
+    const cura::Counters::Snapshot& counters)
 {
     rapidjson::Document doc;
     doc.SetArray();
@@ -201,6 +739,31 @@ void createAndWriteJson(const std::filesystem::path& out_file, double stress_lev
     auto stress_obj = createRapidJSONObject(allocator, "General Stress Level", stress_level, "%", extra_info);
     doc.PushBack(stress_obj, allocator);
 
+    auto fill_stress_obj = createRapidJSONObject(allocator, "Infill, Skin and Support Stress Level", fill_stress_level, "%", fill_extra_info);
+    doc.PushBack(fill_stress_obj, allocator);
+
+    for (const Timing& timing : timings)
+    {
+        const Statistics& statistics = timing.statistics;
+        auto timing_obj = createRapidJSONObject(
+            allocator,
+            timing.name,
+            statistics.median,
+            "ms",
+            fmt::format("p95: {:.3f} ms, 95% CI of the median: {:.3f} - {:.3f} ms", statistics.p95, statistics.ci_low, statistics.ci_high));
+        doc.PushBack(timing_obj, allocator);
+    }
+
+    if constexpr (cura::Counters::enabled)
+    {
+        for (size_t counter_idx = 0; counter_idx < cura::Counters::counter_count; ++counter_idx)
+        {
+            const auto counter = static_cast<cura::Counter>(counter_idx);
+            auto counter_obj = createRapidJSONObject(allocator, std::string(cura::Counters::name(counter)), counters[counter], "-", "Summed over all test cases");
+            doc.PushBack(counter_obj, allocator);
+        }
+    }
+
     rapidjson::StringBuffer buffer;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
     doc.Accept(writer);
@@ -216,63 +779,65 @@ void createAndWriteJson(const std::filesystem::path& out_file, double stress_lev
     file.close();
 }
 
+Options parseOptions(const std::map<std::string, docopt::value>& args)
+{
+    Options options{ .output_file = args.at("-o").asString(),
+                     .repetitions = std::clamp<size_t>(std::stoul(args.at("--repetitions").asString()), 1, max_repetitions),
+                     .warmups = std::stoul(args.at("--warmups").asString()),
+                     .jobs = std::stoul(args.at("--jobs").asString()),
+                     .baseline_file = std::nullopt,
+                     .tolerance = std::stod(args.at("--tolerance").asString()) / 100.0 };
+    if (options.jobs == 0)
+    {
+        options.jobs = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    if (args.at("--baseline"))
+    {
+        options.baseline_file = args.at("--baseline").asString();
+    }
+    return options;
+}
+
 int main(int argc, const char** argv)
 {
     constexpr bool show_help = true;
-    constexpr std::string_view version = "0.1.0";
+    constexpr std::string_view version = "0.2.0";
     const std::map<std::string, docopt::value> args = docopt::docopt(fmt::format("{}", USAGE), { argv + 1, argv + argc }, show_help, fmt::format("{}", version));
+    const Options options = parseOptions(args);
 
     const auto resources = getResources();
-    size_t crash_count = 0;
-    std::vector<std::string> extra_infos;
+    spdlog::info("Running {} test cases {} times after {} warmups, {} at a time", resources.size(), options.repetitions, options.warmups, options.jobs);
+    cura::Counters::Snapshot counters;
+    const std::vector<CaseResult> results = runCases(resources, options, counters);
 
-    for (const auto& resource : resources)
+    // Crashes in the walls are the general stress level, as they were before the other stages were added. Crashes in the other stages are reported apart from them.
+    std::vector<std::string> extra_infos;
+    std::vector<std::string> fill_extra_infos;
+    for (size_t resource_idx = 0; resource_idx < resources.size(); ++resource_idx)
     {
-        const auto& shapes = resource.polygons();
-        const auto& settings = resource.settings();
-
-        spdlog::critical("Starting test case {}", resource.stem());
-        pid_t engine_pid = fork();
-        if (engine_pid == -1)
+        if (results[resource_idx].crashed)
         {
-            spdlog::critical("Unable to fork - engine");
-            return EXIT_FAILURE;
-        }
-        else if (engine_pid == 0)
-        {
-            handleChildProcess(shapes, settings);
-            return EXIT_SUCCESS;
-        }
-        else
-        {
-            pid_t waiter_pid = fork();
-            if (waiter_pid == -1)
-            {
-                spdlog::critical("Unable to fork - waiter");
-                return EXIT_FAILURE;
-            }
-            else if (waiter_pid == 0)
-            {
-                sleep(30);
-                kill(engine_pid, SIGKILL);
-                return EXIT_SUCCESS;
-            }
-            else
-            {
-                int status;
-                waitpid(engine_pid, &status, 0);
-                const auto old_crash_count = crash_count;
-                crash_count = checkCrashCount(crash_count, status, resource);
-                if (old_crash_count != crash_count)
-                {
-                    extra_infos.emplace_back(resource.stem());
-                }
-            }
+            (results[resource_idx].crashed_stage == Stage::WALLS ? extra_infos : fill_extra_infos).emplace_back(resources[resource_idx].stem());
         }
     }
-    const double stress_level = static_cast<double>(crash_count) / static_cast<double>(resources.size()) * 100.0;
-    spdlog::info("Stress level: {:.2f} [%]", stress_level);
-
-    createAndWriteJson(std::filesystem::path{ args.at("-o").asString() }, stress_level, fmt::format("Crashes in: {}", fmt::join(extra_infos, ", ")), resources.size());
+    const double stress_level = static_cast<double>(extra_infos.size()) / static_cast<double>(resources.size()) * 100.0;
+    const double fill_stress_level = static_cast<double>(fill_extra_infos.size()) / static_cast<double>(resources.size()) * 100.0;
+    spdlog::info("Stress level: {:.2f} [%], infill, skin and support stress level: {:.2f} [%]", stress_level, fill_stress_level);
+
+    const std::vector<Timing> timings = collectTimings(resources, results, options.repetitions);
+    createAndWriteJson(
+        options.output_file,
+        stress_level,
+        fmt::format("Crashes in: {}", fmt::join(extra_infos, ", ")),
+        fill_stress_level,
+        fmt::format("Crashes in: {}", fmt::join(fill_extra_infos, ", ")),
+        resources.size(),
+        timings,
+        counters);
+
+    if (options.baseline_file.has_value() && compareToBaseline(options.baseline_file.value(), timings, options.tolerance) > 0)
+    {
+        return EXIT_FAILURE;
+    }
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,158 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "LayerSpill.h" // The class under test.
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Application.h" //To provide settings for the slice data storage.
+#include "Slice.h"
+#include "mesh.h"
+#include "sliceDataStorage.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+class LayerSpillTest : public testing::Test
+{
+public:
+    static constexpr size_t layer_count = 5;
+
+    std::unique_ptr<SliceDataStorage> storage;
+
+    // Copies of the layers as they were before they were spilled.
+    std::vector<SliceLayer> expected_layers;
+    std::vector<SupportLayer> expected_support_layers;
+
+    static Polygons square(const coord_t x, const coord_t y, const coord_t size)
+    {
+        Polygons result;
+        Polygon polygon;
+        polygon.add(Point2LL(x, y));
+        polygon.add(Point2LL(x + size, y));
+        polygon.add(Point2LL(x + size, y + size));
+        polygon.add(Point2LL(x, y + size));
+        result.add(polygon);
+        return result;
+    }
+
+    void SetUp() override
+    {
+        Application::getInstance().current_slice_ = new Slice(1);
+        Settings& settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
+        settings.add("machine_width", "1000");
+        settings.add("machine_depth", "1000");
+        settings.add("machine_height", "1000");
+        settings.add("machine_center_is_zero", "false");
+        Application::getInstance().current_slice_->scene.extruders.emplace_back(0, &settings);
+
+        storage = std::make_unique<SliceDataStorage>();
+        Mesh mesh(settings);
+        storage->meshes.push_back(std::make_shared<SliceMeshStorage>(&mesh, layer_count));
+        storage->support.supportLayers.resize(layer_count);
+        for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+        {
+            const coord_t offset = static_cast<coord_t>(layer_nr) * 1000;
+
+            SliceLayer& layer = storage->meshes[0]->layers[layer_nr];
+            layer.printZ = 200 + offset;
+            layer.thickness = 200;
+            SliceLayerPart& part = layer.parts.emplace_back();
+            part.outline.add(square(offset, -offset, 10000));
+            part.boundaryBox = AABB(part.outline);
+            part.inner_area = square(offset + 400, -offset + 400, 9200);
+            part.infill_area = part.inner_area;
+            ExtrusionLine wall(0, false, true);
+            wall.junctions_.emplace_back(Point2LL(offset, -offset), 400, 0);
+            wall.junctions_.emplace_back(Point2LL(offset + 10000, -offset), 420, 0);
+            wall.junctions_.emplace_back(Point2LL(offset + 10000, -offset + 10000), 380, 0);
+            part.wall_toolpaths.emplace_back().push_back(wall);
+            SkinPart& skin_part = part.skin_parts.emplace_back();
+            skin_part.outline.add(square(offset + 400, -offset + 400, 2000));
+            skin_part.skin_fill = skin_part.outline;
+            layer.top_surface.areas = square(offset, offset, 500);
+            expected_layers.push_back(layer);
+
+            SupportLayer& support_layer = storage->support.supportLayers[layer_nr];
+            PolygonsPart support_outline;
+            support_outline.add(square(-20000, offset, 3000));
+            support_layer.support_infill_parts.emplace_back(support_outline, 400, false, 1);
+            support_layer.support_roof = square(-30000, offset, 1000);
+            expected_support_layers.push_back(support_layer);
+        }
+    }
+
+    void TearDown() override
+    {
+        storage.reset();
+        delete Application::getInstance().current_slice_;
+        Application::getInstance().current_slice_ = nullptr;
+    }
+
+    void expectLayersRestored()
+    {
+        for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+        {
+            const SliceLayer& layer = storage->meshes[0]->layers[layer_nr];
+            const SliceLayer& expected = expected_layers[layer_nr];
+            EXPECT_EQ(layer.printZ, expected.printZ) << "The height of layer " << layer_nr << " is kept while spilled.";
+            ASSERT_EQ(layer.parts.size(), expected.parts.size());
+            const SliceLayerPart& part = layer.parts[0];
+            const SliceLayerPart& expected_part = expected.parts[0];
+            EXPECT_EQ(part.outline.paths, expected_part.outline.paths) << "Layer " << layer_nr;
+            EXPECT_EQ(part.inner_area.paths, expected_part.inner_area.paths) << "Layer " << layer_nr;
+            EXPECT_EQ(part.infill_area.paths, expected_part.infill_area.paths) << "Layer " << layer_nr;
+            EXPECT_EQ(part.boundaryBox.min_, expected_part.boundaryBox.min_) << "Layer " << layer_nr;
+            EXPECT_EQ(part.boundaryBox.max_, expected_part.boundaryBox.max_) << "Layer " << layer_nr;
+            ASSERT_EQ(part.wall_toolpaths.size(), 1);
+            ASSERT_EQ(part.wall_toolpaths[0].size(), 1);
+            const ExtrusionLine& wall = part.wall_toolpaths[0][0];
+            const ExtrusionLine& expected_wall = expected_part.wall_toolpaths[0][0];
+            EXPECT_EQ(wall.is_closed_, expected_wall.is_closed_);
+            ASSERT_EQ(wall.junctions_.size(), expected_wall.junctions_.size());
+            for (size_t junction_idx = 0; junction_idx < wall.junctions_.size(); ++junction_idx)
+            {
+                EXPECT_EQ(wall.junctions_[junction_idx].p_, expected_wall.junctions_[junction_idx].p_);
+                EXPECT_EQ(wall.junctions_[junction_idx].w_, expected_wall.junctions_[junction_idx].w_);
+            }
+            ASSERT_EQ(part.skin_parts.size(), 1);
+            EXPECT_EQ(part.skin_parts[0].outline.paths, expected_part.skin_parts[0].outline.paths) << "Layer " << layer_nr;
+            EXPECT_EQ(part.skin_parts[0].skin_fill.paths, expected_part.skin_parts[0].skin_fill.paths) << "Layer " << layer_nr;
+            EXPECT_EQ(layer.top_surface.areas.paths, expected.top_surface.areas.paths) << "Layer " << layer_nr;
+
+            const SupportLayer& support_layer = storage->support.supportLayers[layer_nr];
+            const SupportLayer& expected_support = expected_support_layers[layer_nr];
+            ASSERT_EQ(support_layer.support_infill_parts.size(), 1);
+            EXPECT_EQ(support_layer.support_infill_parts[0].outline_.paths, expected_support.support_infill_parts[0].outline_.paths) << "Layer " << layer_nr;
+            EXPECT_EQ(support_layer.support_infill_parts[0].support_line_width_, expected_support.support_infill_parts[0].support_line_width_);
+            EXPECT_EQ(support_layer.support_infill_parts[0].inset_count_to_generate_, expected_support.support_infill_parts[0].inset_count_to_generate_);
+            EXPECT_EQ(support_layer.support_roof.paths, expected_support.support_roof.paths) << "Layer " << layer_nr;
+        }
+    }
+};
+
+TEST_F(LayerSpillTest, ScratchFileRoundTrip)
+{
+    LayerSpill::enable(std::filesystem::temp_directory_path());
+    LayerSpill layer_spill;
+    ASSERT_TRUE(layer_spill.spill(*storage));
+    for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        EXPECT_TRUE(storage->meshes[0]->layers[layer_nr].parts.empty()) << "Spilled layers are released.";
+        EXPECT_TRUE(storage->support.supportLayers[layer_nr].support_infill_parts.empty()) << "Spilled layers are released.";
+    }
+
+    // Restoring in overlapping windows, as the layers are processed, reads every layer back once.
+    layer_spill.restore(*storage, -3, 1);
+    layer_spill.restore(*storage, 0, 2);
+    layer_spill.restore(*storage, 2, 10);
+    expectLayersRestored();
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
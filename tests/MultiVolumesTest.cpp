@@ -0,0 +1,192 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "multiVolumes.h" // The functions under test.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Application.h" // To provide settings for the volumes.
+#include "Slice.h"
+#include "mesh.h"
+#include "slicer.h"
+#include "utils/AABB.h"
+#include "utils/polygon.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+class MultiVolumesTest : public testing::Test
+{
+public:
+    static constexpr size_t layer_count = 2;
+
+    std::vector<Mesh> meshes;
+    std::vector<std::unique_ptr<Slicer>> slicers;
+    std::vector<Slicer*> volumes;
+
+    static Polygons square(const coord_t x, const coord_t y, const coord_t size)
+    {
+        Polygons result;
+        Polygon polygon;
+        polygon.add(Point2LL(x, y));
+        polygon.add(Point2LL(x + size, y));
+        polygon.add(Point2LL(x + size, y + size));
+        polygon.add(Point2LL(x, y + size));
+        result.add(polygon);
+        return result;
+    }
+
+    void SetUp() override
+    {
+        Application::getInstance().startThreadPool();
+        Application::getInstance().current_slice_ = new Slice(1);
+        Settings& settings = Application::getInstance().current_slice_->scene.current_mesh_group->settings;
+        settings.add("slicing_tolerance", "middle");
+        settings.add("layer_height_0", "0.2");
+        settings.add("layer_height", "0.1");
+        settings.add("layer_0_z_overlap", "0.0");
+        settings.add("raft_airgap", "0.0");
+        settings.add("raft_base_thickness", "0.2");
+        settings.add("raft_interface_thickness", "0.2");
+        settings.add("raft_interface_layers", "1");
+        settings.add("raft_surface_thickness", "0.2");
+        settings.add("raft_surface_layers", "1");
+        settings.add("raft_surface_extruder_nr", "0");
+        settings.add("magic_mesh_surface_mode", "normal");
+        settings.add("meshfix_extensive_stitching", "false");
+        settings.add("meshfix_keep_open_polygons", "false");
+        settings.add("meshfix_union_all", "true");
+        settings.add("minimum_polygon_circumference", "1");
+        settings.add("meshfix_maximum_resolution", "0.04");
+        settings.add("meshfix_maximum_deviation", "0.02");
+        settings.add("meshfix_maximum_extrusion_area_deviation", "2000");
+        settings.add("xy_offset", "0");
+        settings.add("xy_offset_layer_0", "0");
+        settings.add("hole_xy_offset", "0");
+        settings.add("hole_xy_offset_max_diameter", "0");
+        settings.add("support_mesh", "false");
+        settings.add("anti_overhang_mesh", "false");
+        settings.add("cutting_mesh", "false");
+        settings.add("infill_mesh", "false");
+        settings.add("adhesion_type", "none");
+        settings.add("alternate_carve_order", "false");
+        settings.add("multiple_mesh_overlap", "0.15");
+
+        // Two volumes that overlap on the first layer, and one that is far away from both of them. The second volume is missing on the second layer.
+        const std::vector<Polygons> outlines{ square(0, 0, 10000), square(5000, 5000, 10000), square(50000, 0, 10000) };
+        meshes.reserve(outlines.size()); // The slicers point to the meshes.
+        for (size_t volume_idx = 0; volume_idx < outlines.size(); ++volume_idx)
+        {
+            Mesh& mesh = meshes.emplace_back(settings);
+            mesh.settings_.add("infill_mesh_order", std::to_string(volume_idx)); // Carve in a well-defined order.
+
+            slicers.push_back(std::make_unique<Slicer>(&mesh, 100, layer_count, false, nullptr));
+            for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+            {
+                if (volume_idx != 1 || layer_nr == 0)
+                {
+                    slicers.back()->layers[layer_nr].polygons = outlines[volume_idx];
+                }
+            }
+
+            // Give the mesh the bounding box that its layers have.
+            const AABB box(outlines[volume_idx]);
+            Point3LL v0(box.min_.X, box.min_.Y, 0);
+            Point3LL v1(box.max_.X, box.min_.Y, 0);
+            Point3LL v2(box.max_.X, box.max_.Y, 300);
+            mesh.addFace(v0, v1, v2);
+
+            volumes.push_back(slicers.back().get());
+        }
+    }
+
+    std::vector<std::vector<Polygons>> layers() const
+    {
+        std::vector<std::vector<Polygons>> result;
+        for (const Slicer* volume : volumes)
+        {
+            std::vector<Polygons>& volume_layers = result.emplace_back();
+            for (const SlicerLayer& layer : volume->layers)
+            {
+                volume_layers.push_back(layer.polygons);
+            }
+        }
+        return result;
+    }
+
+    static void expectSameOutlines(const std::vector<std::vector<Polygons>>& expected, const std::vector<std::vector<Polygons>>& actual)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t volume_idx = 0; volume_idx < expected.size(); ++volume_idx)
+        {
+            ASSERT_EQ(actual[volume_idx].size(), expected[volume_idx].size());
+            for (size_t layer_nr = 0; layer_nr < expected[volume_idx].size(); ++layer_nr)
+            {
+                const Polygons& expected_outline = expected[volume_idx][layer_nr];
+                const Polygons& actual_outline = actual[volume_idx][layer_nr];
+                EXPECT_DOUBLE_EQ(actual_outline.area(), expected_outline.area()) << "Volume " << volume_idx << " on layer " << layer_nr;
+                EXPECT_EQ(actual_outline.xorPolygons(expected_outline).area(), 0.0) << "Volume " << volume_idx << " on layer " << layer_nr;
+            }
+        }
+    }
+};
+
+TEST_F(MultiVolumesTest, CarveMatchesCarvingEveryPair)
+{
+    // Carve every pair of volumes on every layer, without skipping the pairs that can't overlap.
+    std::vector<std::vector<Polygons>> expected = layers();
+    for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        for (size_t volume_1_idx = 1; volume_1_idx < expected.size(); ++volume_1_idx)
+        {
+            for (size_t volume_2_idx = 0; volume_2_idx < volume_1_idx; ++volume_2_idx)
+            {
+                expected[volume_1_idx][layer_nr] = expected[volume_1_idx][layer_nr].difference(expected[volume_2_idx][layer_nr]);
+            }
+        }
+    }
+
+    carveMultipleVolumes(volumes);
+
+    expectSameOutlines(expected, layers());
+    EXPECT_DOUBLE_EQ(volumes[1]->layers[0].polygons.area(), 75000000.0) << "The overlapping volume is carved.";
+    EXPECT_DOUBLE_EQ(volumes[2]->layers[0].polygons.area(), 100000000.0) << "The far away volume is left alone.";
+}
+
+TEST_F(MultiVolumesTest, OverlapMatchesOverlappingEveryVolume)
+{
+    // Grow every volume into all other volumes on every layer, without skipping the volumes that are too far away.
+    constexpr coord_t offset_to_merge_other_merged_volumes = 20;
+    constexpr coord_t overlap = 150;
+    std::vector<std::vector<Polygons>> expected = layers();
+    for (size_t layer_nr = 0; layer_nr < layer_count; ++layer_nr)
+    {
+        for (size_t volume_idx = 0; volume_idx < expected.size(); ++volume_idx)
+        {
+            Polygons all_other_volumes;
+            for (size_t other_idx = 0; other_idx < expected.size(); ++other_idx)
+            {
+                if (other_idx != volume_idx)
+                {
+                    all_other_volumes = all_other_volumes.unionPolygons(expected[other_idx][layer_nr].offset(offset_to_merge_other_merged_volumes), ClipperLib::pftNonZero);
+                }
+            }
+            Polygons& outline = expected[volume_idx][layer_nr];
+            outline = outline.unionPolygons(all_other_volumes.intersection(outline.offset(overlap / 2)), ClipperLib::pftNonZero);
+        }
+    }
+
+    generateMultipleVolumesOverlap(volumes);
+
+    expectSameOutlines(expected, layers());
+    EXPECT_GT(volumes[0]->layers[0].polygons.area(), 100000000.0) << "The volume grows into the volume that overlaps with it.";
+    EXPECT_DOUBLE_EQ(volumes[2]->layers[0].polygons.area(), 100000000.0) << "The far away volume doesn't grow.";
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -3,8 +3,15 @@
 
 #include "PathOrderOptimizer.h" //The code under test.
 
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <vector>
+
 #include <gtest/gtest.h> //To run the tests.
 
+#include "utils/SeamCornerCache.h" //To check whether corner angles are computed.
+
 // NOLINTBEGIN(*-magic-numbers)
 namespace cura
 {
@@ -73,5 +80,90 @@ TEST_F(PathOrderOptimizerTest, ThreeTrianglesShortestOrder)
     EXPECT_EQ(optimizer.paths_[2].vertices_->front(), Point2LL(1000, 1000)) << "Far triangle last.";
 }
 
+/*!
+ * With many paths, the closest path is found through a spatial search. That
+ * should find the same order as checking all paths that are left.
+ */
+TEST_F(PathOrderOptimizerTest, ManyPolylinesNearestOrder)
+{
+    constexpr size_t line_count = 300;
+    std::vector<Polygon> lines;
+    lines.reserve(line_count); // The optimizer refers to the lines, so they can't move.
+    for (size_t line_idx = 0; line_idx < line_count; ++line_idx)
+    {
+        // Scatter the lines over a 30x30 lattice of 1mm, by stepping through it with a stride that has no common factor with its size.
+        const size_t lattice_idx = (line_idx * 457) % 900;
+        const Point2LL start(static_cast<coord_t>(lattice_idx % 30) * 1000, static_cast<coord_t>(lattice_idx / 30) * 1000);
+        Polygon& line = lines.emplace_back();
+        line.add(start);
+        line.add(start + Point2LL(300, 100));
+        optimizer.addPolyline(line);
+    }
+
+    optimizer.optimize();
+
+    // Greedily pick the closest line end every time.
+    std::vector<bool> picked(line_count, false);
+    Point2LL position(0, 0);
+    ASSERT_EQ(optimizer.paths_.size(), line_count);
+    for (size_t order_idx = 0; order_idx < line_count; ++order_idx)
+    {
+        size_t closest_idx = line_count;
+        coord_t closest_distance2 = std::numeric_limits<coord_t>::max();
+        for (size_t line_idx = 0; line_idx < line_count; ++line_idx)
+        {
+            const coord_t distance2 = std::min(vSize2(lines[line_idx].front() - position), vSize2(lines[line_idx].back() - position));
+            if (! picked[line_idx] && distance2 < closest_distance2)
+            {
+                closest_idx = line_idx;
+                closest_distance2 = distance2;
+            }
+        }
+        picked[closest_idx] = true;
+        const bool backwards = vSize2(lines[closest_idx].back() - position) < vSize2(lines[closest_idx].front() - position);
+        position = backwards ? lines[closest_idx].front() : lines[closest_idx].back();
+
+        EXPECT_EQ(optimizer.paths_[order_idx].vertices_->front(), lines[closest_idx].front()) << "Line " << order_idx << " should be the closest one left.";
+        EXPECT_EQ(optimizer.paths_[order_idx].backwards_, backwards);
+    }
+}
+
+/*!
+ * Without a corner preference, the corner angles don't matter for the seam, so
+ * they shouldn't be computed or cached at all.
+ */
+TEST_F(PathOrderOptimizerTest, NoCornerPreferenceSkipsCornerAngles)
+{
+    Polygon circle; // Enough vertices to be eligible for the corner angle cache.
+    for (size_t vertex_idx = 0; vertex_idx < 32; ++vertex_idx)
+    {
+        const double angle = 2 * std::numbers::pi * static_cast<double>(vertex_idx) / 32;
+        circle.add(Point2LL(10000 + std::llrint(std::cos(angle) * 5000), 10000 + std::llrint(std::sin(angle) * 5000)));
+    }
+    bool computed = false;
+    const auto compute_angles = [&computed, &circle]()
+    {
+        computed = true;
+        return SeamCornerCache::Angles(circle.size(), 0.0);
+    };
+
+    SeamCornerCache::clear();
+    PathOrderOptimizer<ConstPolygonPointer> no_preference(Point2LL(20000, 10000), ZSeamConfig(EZSeamType::SHORTEST, Point2LL(0, 0), EZSeamCornerPrefType::Z_SEAM_CORNER_PREF_NONE));
+    no_preference.addPolygon(circle);
+    no_preference.optimize();
+    EXPECT_EQ(no_preference.paths_[0].start_vertex_, 0) << "The vertex closest to the start point.";
+    SeamCornerCache::get(circle, compute_angles);
+    EXPECT_TRUE(computed) << "Without a preference, the angles of the circle weren't cached.";
+
+    SeamCornerCache::clear();
+    PathOrderOptimizer<ConstPolygonPointer> inner_preference(Point2LL(20000, 10000), ZSeamConfig(EZSeamType::SHORTEST, Point2LL(0, 0), EZSeamCornerPrefType::Z_SEAM_CORNER_PREF_INNER));
+    inner_preference.addPolygon(circle);
+    inner_preference.optimize();
+    computed = false;
+    SeamCornerCache::get(circle, compute_angles);
+    EXPECT_FALSE(computed) << "With a preference, the angles of the circle were cached.";
+    SeamCornerCache::clear();
+}
+
 } // namespace cura
 // NOLINTEND(*-magic-numbers)
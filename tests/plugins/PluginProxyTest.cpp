@@ -0,0 +1,130 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "plugins/pluginproxy.h" // The class under test.
+
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <gtest/gtest.h>
+
+#include "cura/plugins/slots/handshake/v0/handshake.grpc.pb.h"
+#include "cura/plugins/slots/postprocess/v0/modify.grpc.pb.h"
+#include "plugins/converters.h"
+#include "plugins/exception.h"
+#include "plugins/validator.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura::plugins
+{
+
+/*!
+ * Answers the handshake as a plugin for the postprocess slot.
+ */
+class TestHandshakeService : public slots::handshake::v0::HandshakeService::Service
+{
+public:
+    grpc::Status Call(grpc::ServerContext*, const slots::handshake::v0::CallRequest* request, slots::handshake::v0::CallResponse* response) override
+    {
+        response->set_plugin_name(request->plugin_name());
+        response->set_plugin_version(request->plugin_version());
+        response->set_slot_version_range(">=0.1.0-alpha");
+        return grpc::Status::OK;
+    }
+};
+
+/*!
+ * Appends a comment to the G-code it gets, or fails if it gets "fail".
+ */
+class TestPostprocessService : public slots::postprocess::v0::modify::PostprocessModifyService::Service
+{
+public:
+    grpc::Status Call(grpc::ServerContext*, const slots::postprocess::v0::modify::CallRequest* request, slots::postprocess::v0::modify::CallResponse* response) override
+    {
+        if (request->gcode_word() == "fail")
+        {
+            return grpc::Status(grpc::StatusCode::INTERNAL, "Asked to fail.");
+        }
+        response->set_gcode_word(request->gcode_word() + ";postprocessed");
+        return grpc::Status::OK;
+    }
+};
+
+class PluginProxyTest : public testing::Test
+{
+public:
+    using proxy_type
+        = PluginProxy<v0::SlotID::POSTPROCESS_MODIFY, "0.1.0-alpha", slots::postprocess::v0::modify::PostprocessModifyService::Stub, Validator, postprocess_request, postprocess_response>;
+
+    TestHandshakeService handshake_service;
+    TestPostprocessService postprocess_service;
+    std::unique_ptr<grpc::Server> server;
+    std::optional<proxy_type> proxy;
+
+    void SetUp() override
+    {
+        grpc::ServerBuilder builder;
+        builder.RegisterService(&handshake_service);
+        builder.RegisterService(&postprocess_service);
+        server = builder.BuildAndStart();
+        ASSERT_NE(server, nullptr);
+        proxy.emplace("TestPostprocessPlugin", "1.0.0", server->InProcessChannel(grpc::ChannelArguments{}));
+    }
+
+    void TearDown() override
+    {
+        proxy.reset();
+        server->Shutdown();
+    }
+};
+
+TEST_F(PluginProxyTest, ModifyAsync)
+{
+    std::string gcode = "G1 X10";
+    std::future<std::string> result = proxy->modifyAsync(gcode);
+    EXPECT_EQ(result.get(), "G1 X10;postprocessed");
+    EXPECT_EQ(proxy->modify(gcode), "G1 X10;postprocessed") << "The blocking call gives the same result.";
+}
+
+TEST_F(PluginProxyTest, ModifyAsyncOutlivesProxy)
+{
+    std::vector<std::string> gcodes;
+    for (size_t call_idx = 0; call_idx < 8; ++call_idx)
+    {
+        gcodes.push_back(fmt::format("G1 X{}", call_idx));
+    }
+
+    // All calls are in flight together, and are made through copies of the proxy that are gone before any result is retrieved.
+    std::vector<std::future<std::string>> results;
+    for (std::string& gcode : gcodes)
+    {
+        proxy_type copy = proxy.value();
+        results.push_back(copy.modifyAsync(gcode));
+    }
+    proxy.reset();
+
+    for (size_t call_idx = 0; call_idx < gcodes.size(); ++call_idx)
+    {
+        EXPECT_EQ(results[call_idx].get(), fmt::format("G1 X{};postprocessed", call_idx));
+    }
+}
+
+TEST_F(PluginProxyTest, FailedCallThrowsOnRetrieval)
+{
+    std::string gcode = "fail";
+    std::future<std::string> result;
+    {
+        proxy_type copy = proxy.value();
+        result = copy.modifyAsync(gcode);
+    }
+    EXPECT_THROW(result.get(), exceptions::RemoteException);
+}
+
+} // namespace cura::plugins
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,180 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "plugins/sharedmemoryring.h" // The class under test.
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "utils/polygon.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura::plugins
+{
+
+class SharedMemoryRingTest : public testing::Test
+{
+public:
+    std::string name; // Unique per test, so that tests running in parallel don't open each other's rings.
+
+    void SetUp() override
+    {
+        const testing::TestInfo* test_info = testing::UnitTest::GetInstance()->current_test_info();
+        name = fmt::format("cura_ring_test_{}_{}", test_info->name(), std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    }
+
+    static Polygons makeShape(const coord_t offset, const size_t polygon_count)
+    {
+        Polygons shape;
+        for (size_t polygon_idx = 0; polygon_idx < polygon_count; ++polygon_idx)
+        {
+            PolygonRef polygon = shape.newPoly();
+            for (size_t point_idx = 0; point_idx < 3 + polygon_idx; ++point_idx)
+            {
+                polygon.emplace_back(offset + static_cast<coord_t>(point_idx * 1000), offset - static_cast<coord_t>(polygon_idx * 500));
+            }
+        }
+        return shape;
+    }
+
+    static void expectEqual(const Polygons& actual, const Polygons& expected)
+    {
+        ASSERT_EQ(actual.size(), expected.size());
+        for (size_t polygon_idx = 0; polygon_idx < expected.size(); ++polygon_idx)
+        {
+            EXPECT_EQ(*actual[polygon_idx], *expected[polygon_idx]);
+        }
+    }
+};
+
+TEST_F(SharedMemoryRingTest, MessagesRoundTrip)
+{
+    SharedMemoryRing producer = SharedMemoryRing::create(name, 1024);
+    SharedMemoryRing consumer = SharedMemoryRing::open(name);
+    EXPECT_EQ(consumer.capacity(), 1024);
+
+    std::vector<std::byte> received;
+    EXPECT_FALSE(consumer.tryPop(received)) << "A new ring is empty.";
+
+    const std::vector<std::byte> message{ std::byte{ 1 }, std::byte{ 2 }, std::byte{ 3 } };
+    ASSERT_TRUE(producer.tryPush(message));
+    ASSERT_TRUE(producer.tryPush(std::span<const std::byte>()));
+    ASSERT_TRUE(consumer.tryPop(received));
+    EXPECT_EQ(received, message);
+    ASSERT_TRUE(consumer.tryPop(received));
+    EXPECT_TRUE(received.empty());
+    EXPECT_FALSE(consumer.tryPop(received));
+}
+
+TEST_F(SharedMemoryRingTest, FullRingRejectsMessages)
+{
+    SharedMemoryRing producer = SharedMemoryRing::create(name, 64);
+    SharedMemoryRing consumer = SharedMemoryRing::open(name);
+
+    const std::vector<std::byte> message(24); // Takes 32 bytes with its size field.
+    EXPECT_TRUE(producer.tryPush(message));
+    EXPECT_TRUE(producer.tryPush(message));
+    EXPECT_FALSE(producer.tryPush(message));
+    EXPECT_FALSE(producer.tryPush(std::vector<std::byte>(100))) << "Larger than the whole ring.";
+    EXPECT_THROW(producer.push(std::vector<std::byte>(100)), std::length_error);
+
+    std::vector<std::byte> received;
+    ASSERT_TRUE(consumer.tryPop(received));
+    EXPECT_TRUE(producer.tryPush(message)) << "Popping made room again.";
+}
+
+TEST_F(SharedMemoryRingTest, PolygonsWrapAround)
+{
+    SharedMemoryRing producer = SharedMemoryRing::create(name, 1000); // Not a multiple of the message sizes, so the messages end up split over the end of the ring.
+    SharedMemoryRing consumer = SharedMemoryRing::open(name);
+
+    for (coord_t round = 0; round < 50; ++round)
+    {
+        const Polygons shape = makeShape(round * 7, static_cast<size_t>(round % 5));
+        ASSERT_TRUE(producer.tryPush(shape));
+        Polygons received = makeShape(-1, 2); // Gets replaced.
+        ASSERT_TRUE(consumer.tryPop(received));
+        expectEqual(received, shape);
+    }
+}
+
+TEST_F(SharedMemoryRingTest, MalformedPolygonsAreRejected)
+{
+    SharedMemoryRing producer = SharedMemoryRing::create(name, 1024);
+    SharedMemoryRing consumer = SharedMemoryRing::open(name);
+
+    const auto message = [](const std::vector<uint64_t>& fields)
+    {
+        std::vector<std::byte> bytes(fields.size() * sizeof(uint64_t));
+        std::memcpy(bytes.data(), fields.data(), bytes.size());
+        return bytes;
+    };
+    ASSERT_TRUE(producer.tryPush(message({ uint64_t(1) << 60 }))) << "Far more polygons than the payload holds.";
+    ASSERT_TRUE(producer.tryPush(message({ 1, uint64_t(1) << 60 }))) << "Far more vertices than the payload holds.";
+    ASSERT_TRUE(producer.tryPush(message({ 1, 0, 0 }))) << "Trailing bytes that no polygon accounts for.";
+    ASSERT_TRUE(producer.tryPush(makeShape(0, 2)));
+
+    Polygons received;
+    EXPECT_THROW(consumer.tryPop(received), std::runtime_error);
+    EXPECT_THROW(consumer.tryPop(received), std::runtime_error);
+    EXPECT_THROW(consumer.tryPop(received), std::runtime_error);
+    ASSERT_TRUE(consumer.tryPop(received)) << "The malformed messages were dropped, so the valid one comes next.";
+    expectEqual(received, makeShape(0, 2));
+    EXPECT_FALSE(consumer.tryPop(received));
+}
+
+/*!
+ * A plugin on the other side of a pair of rings, which moves all polygons it receives. It runs on a thread here, but only talks to the test through the shared memory.
+ */
+TEST_F(SharedMemoryRingTest, EchoPlugin)
+{
+    SharedMemoryRing requests = SharedMemoryRing::create(name + "_request", 4096);
+    SharedMemoryRing responses = SharedMemoryRing::create(name + "_response", 4096);
+    constexpr coord_t message_count = 500;
+
+    std::thread plugin(
+        [this]()
+        {
+            SharedMemoryRing plugin_requests = SharedMemoryRing::open(name + "_request");
+            SharedMemoryRing plugin_responses = SharedMemoryRing::open(name + "_response");
+            for (coord_t message_idx = 0; message_idx < message_count; ++message_idx)
+            {
+                Polygons shape;
+                plugin_requests.pop(shape);
+                shape.translate(Point2LL(10, 20));
+                plugin_responses.push(shape);
+            }
+        });
+
+    coord_t received_count = 0;
+    Polygons received;
+    for (coord_t message_idx = 0; message_idx < message_count; ++message_idx)
+    {
+        requests.push(makeShape(message_idx, 4));
+        while (responses.tryPop(received)) // Keep both directions flowing, so neither side waits for a full ring forever.
+        {
+            Polygons expected = makeShape(received_count, 4);
+            expected.translate(Point2LL(10, 20));
+            expectEqual(received, expected);
+            ++received_count;
+        }
+    }
+    while (received_count < message_count)
+    {
+        responses.pop(received);
+        Polygons expected = makeShape(received_count, 4);
+        expected.translate(Point2LL(10, 20));
+        expectEqual(received, expected);
+        ++received_count;
+    }
+    plugin.join();
+}
+
+} // namespace cura::plugins
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,123 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/AABBGrid.h" // The class under test.
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "utils/AABB.h"
+#include "utils/Coord_t.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+class AABBGridTest : public testing::Test
+{
+public:
+    std::vector<AABB> boxes;
+
+    void SetUp() override
+    {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<coord_t> position(-10000, 10000);
+        std::uniform_int_distribution<coord_t> size(0, 800);
+        for (size_t i = 0; i < 500; ++i)
+        {
+            const Point2LL min(position(rng), position(rng));
+            boxes.emplace_back(min, min + Point2LL(size(rng), size(rng)));
+        }
+        boxes.emplace_back(Point2LL(-20000, -20000), Point2LL(20000, 20000)); // Covers everything, so it goes into the list of large boxes.
+        boxes.emplace_back(); // Invalid box, overlaps nothing.
+    }
+
+    std::vector<const AABB*> bruteForce(const AABB& query) const
+    {
+        std::vector<const AABB*> result;
+        for (const AABB& box : boxes)
+        {
+            if (box.hit(query))
+            {
+                result.push_back(&box);
+            }
+        }
+        return result;
+    }
+
+    std::vector<const AABB*> filteredQuery(const AABBGrid<const AABB*>& grid, const AABB& query) const
+    {
+        std::vector<const AABB*> candidates;
+        grid.query(query, candidates);
+        std::vector<const AABB*> result;
+        for (const AABB* box : candidates)
+        {
+            if (box->hit(query))
+            {
+                result.push_back(box);
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+TEST_F(AABBGridTest, QueryFindsAllOverlaps)
+{
+    AABBGrid<const AABB*> grid(400);
+    for (const AABB& box : boxes)
+    {
+        grid.insert(&box, box);
+    }
+    for (const AABB& query : boxes)
+    {
+        std::vector<const AABB*> expected = bruteForce(query);
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(filteredQuery(grid, query), expected);
+    }
+}
+
+TEST_F(AABBGridTest, QueryReturnsEachHandleOnce)
+{
+    AABBGrid<const AABB*> grid(50);
+    for (const AABB& box : boxes)
+    {
+        grid.insert(&box, box);
+    }
+    std::vector<const AABB*> candidates;
+    grid.query(AABB(Point2LL(-5000, -5000), Point2LL(5000, 5000)), candidates);
+    std::vector<const AABB*> deduplicated = candidates;
+    std::sort(deduplicated.begin(), deduplicated.end());
+    deduplicated.erase(std::unique(deduplicated.begin(), deduplicated.end()), deduplicated.end());
+    EXPECT_EQ(candidates.size(), deduplicated.size());
+}
+
+TEST_F(AABBGridTest, RemovedBoxesAreNotFound)
+{
+    AABBGrid<const AABB*> grid(400);
+    for (const AABB& box : boxes)
+    {
+        grid.insert(&box, box);
+    }
+    for (size_t i = 0; i < boxes.size(); i += 2)
+    {
+        grid.remove(&boxes[i], boxes[i]);
+    }
+    for (const AABB& query : boxes)
+    {
+        std::vector<const AABB*> expected;
+        for (const AABB* box : bruteForce(query))
+        {
+            if ((box - boxes.data()) % 2 == 1)
+            {
+                expected.push_back(box);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(filteredQuery(grid, query), expected);
+    }
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
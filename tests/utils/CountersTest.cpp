@@ -0,0 +1,87 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/Counters.h" // The class under test.
+
+#include <sstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+TEST(CountersTest, Buckets)
+{
+    EXPECT_EQ(Counters::bucket(0), 0);
+    EXPECT_EQ(Counters::bucket(1), 1);
+    EXPECT_EQ(Counters::bucket(2), 2);
+    EXPECT_EQ(Counters::bucket(3), 2);
+    EXPECT_EQ(Counters::bucket(4), 3);
+    EXPECT_EQ(Counters::bucket(1000), 10);
+    EXPECT_EQ(Counters::bucket(uint64_t(1) << 40), Counters::bucket_count - 1);
+}
+
+TEST(CountersTest, MergesThreads)
+{
+    if constexpr (! Counters::enabled)
+    {
+        GTEST_SKIP() << "Performance counters are not enabled in this build.";
+    }
+    Counters::reset();
+    Counters::add(Counter::COMB_ATTEMPTS);
+    Counters::record(Histogram::PATH_ORDER_OPTIMIZER_PATHS, 3);
+    std::thread worker(
+        []()
+        {
+            Counters::add(Counter::COMB_ATTEMPTS, 2);
+            Counters::record(Histogram::PATH_ORDER_OPTIMIZER_PATHS, 1000);
+        });
+    worker.join();
+
+    const Counters::Snapshot snapshot = Counters::snapshot();
+    EXPECT_EQ(snapshot[Counter::COMB_ATTEMPTS], 3);
+    EXPECT_EQ(snapshot[Counter::COMB_FALLBACKS], 0);
+    const Counters::Snapshot::HistogramData& paths = snapshot[Histogram::PATH_ORDER_OPTIMIZER_PATHS];
+    EXPECT_EQ(paths.count, 2);
+    EXPECT_EQ(paths.sum, 1003);
+    EXPECT_EQ(paths.buckets[2], 1);
+    EXPECT_EQ(paths.buckets[10], 1);
+
+    Counters::reset();
+    EXPECT_EQ(Counters::snapshot()[Counter::COMB_ATTEMPTS], 0);
+}
+
+TEST(CountersTest, WritesJson)
+{
+    Counters::Snapshot snapshot;
+    snapshot.counters[static_cast<size_t>(Counter::SETTINGS_GET_CALLS)] = 42;
+    snapshot.histograms[static_cast<size_t>(Histogram::CLIPPER_OFFSET_VERTICES)].count = 3;
+    snapshot.histograms[static_cast<size_t>(Histogram::CLIPPER_OFFSET_VERTICES)].sum = 70;
+    snapshot.histograms[static_cast<size_t>(Histogram::CLIPPER_OFFSET_VERTICES)].buckets[0] = 1;
+    snapshot.histograms[static_cast<size_t>(Histogram::CLIPPER_OFFSET_VERTICES)].buckets[6] = 2;
+    Counters::Snapshot doubled = snapshot;
+    doubled += snapshot;
+
+    std::ostringstream out;
+    doubled.writeJson(out);
+    rapidjson::Document document;
+    document.Parse(out.str().c_str());
+    ASSERT_FALSE(document.HasParseError()) << out.str();
+
+    EXPECT_EQ(document["counters"]["settings_get_calls"].GetUint64(), 84);
+    EXPECT_EQ(document["counters"]["comb_fallbacks"].GetUint64(), 0);
+    const rapidjson::Value& offsets = document["histograms"]["clipper_offset_vertices"];
+    EXPECT_EQ(offsets["count"].GetUint64(), 6);
+    EXPECT_EQ(offsets["sum"].GetUint64(), 140);
+    ASSERT_EQ(offsets["buckets"].Size(), 2); // Empty buckets are left out.
+    EXPECT_EQ(offsets["buckets"][0]["from"].GetUint64(), 0);
+    EXPECT_EQ(offsets["buckets"][0]["count"].GetUint64(), 2);
+    EXPECT_EQ(offsets["buckets"][1]["from"].GetUint64(), 32);
+    EXPECT_EQ(offsets["buckets"][1]["count"].GetUint64(), 4);
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
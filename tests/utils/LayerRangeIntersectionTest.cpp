@@ -0,0 +1,68 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/LayerRangeIntersection.h" // The class under test.
+
+#include <gtest/gtest.h>
+
+#include "utils/Coord_t.h"
+#include "utils/polygon.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+class LayerRangeIntersectionTest : public testing::Test
+{
+public:
+    std::vector<Polygons> layers; // Squares that shift and change size from layer to layer.
+
+    void SetUp() override
+    {
+        for (coord_t layer_nr = 0; layer_nr < 23; ++layer_nr)
+        {
+            const coord_t size = 1000 + (layer_nr % 5) * 100;
+            const coord_t shift = (layer_nr % 3) * 50;
+            Polygon square;
+            square.emplace_back(shift, 0);
+            square.emplace_back(shift + size, 0);
+            square.emplace_back(shift + size, size);
+            square.emplace_back(shift, size);
+            Polygons layer;
+            layer.add(square);
+            layers.push_back(layer);
+        }
+    }
+};
+
+TEST_F(LayerRangeIntersectionTest, MatchesChainedIntersections)
+{
+    constexpr size_t max_range_length = 7;
+    const LayerRangeIntersection table(layers, max_range_length);
+    ASSERT_EQ(table.size(), layers.size());
+
+    for (size_t first = 0; first < layers.size(); ++first)
+    {
+        for (size_t last = first; last < std::min(layers.size(), first + max_range_length); ++last)
+        {
+            Polygons expected = layers[first];
+            for (size_t layer_nr = first + 1; layer_nr <= last; ++layer_nr)
+            {
+                expected = expected.intersection(layers[layer_nr]);
+            }
+            const Polygons result = table.query(first, last);
+            EXPECT_EQ(result.area(), expected.area()) << "Range " << first << " to " << last << ".";
+            EXPECT_TRUE(result.xorPolygons(expected).empty()) << "Range " << first << " to " << last << ".";
+        }
+    }
+}
+
+TEST_F(LayerRangeIntersectionTest, BeyondLastLayerIsEmpty)
+{
+    const LayerRangeIntersection table(layers, 4);
+    EXPECT_TRUE(table.query(layers.size() - 2, layers.size() + 1).empty());
+    EXPECT_FALSE(table.query(layers.size() - 2, layers.size() - 1).empty());
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
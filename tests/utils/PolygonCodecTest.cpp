@@ -0,0 +1,75 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/PolygonCodec.h" // The class under test.
+
+#include <limits>
+
+#include <gtest/gtest.h>
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+TEST(PolygonCodecTest, Integers)
+{
+    std::vector<uint8_t> buffer;
+    PolygonEncoder encoder(buffer);
+    encoder.writeUnsigned(0);
+    encoder.writeUnsigned(127);
+    encoder.writeUnsigned(128);
+    encoder.writeUnsigned(std::numeric_limits<uint64_t>::max());
+    encoder.writeSigned(-1);
+    encoder.writeSigned(63);
+    encoder.writeSigned(-64);
+    encoder.writeSigned(std::numeric_limits<int64_t>::min());
+    encoder.writeSigned(std::numeric_limits<int64_t>::max());
+
+    PolygonDecoder decoder(buffer);
+    EXPECT_EQ(decoder.readUnsigned(), 0);
+    EXPECT_EQ(decoder.readUnsigned(), 127);
+    EXPECT_EQ(decoder.readUnsigned(), 128);
+    EXPECT_EQ(decoder.readUnsigned(), std::numeric_limits<uint64_t>::max());
+    EXPECT_EQ(decoder.readSigned(), -1);
+    EXPECT_EQ(decoder.readSigned(), 63);
+    EXPECT_EQ(decoder.readSigned(), -64);
+    EXPECT_EQ(decoder.readSigned(), std::numeric_limits<int64_t>::min());
+    EXPECT_EQ(decoder.readSigned(), std::numeric_limits<int64_t>::max());
+    EXPECT_TRUE(decoder.atEnd());
+}
+
+TEST(PolygonCodecTest, SmallValuesTakeOneByte)
+{
+    std::vector<uint8_t> buffer;
+    PolygonEncoder encoder(buffer);
+    encoder.writeSigned(-64);
+    encoder.writeSigned(63);
+    EXPECT_EQ(buffer.size(), 2);
+}
+
+TEST(PolygonCodecTest, Polygons)
+{
+    Polygons polygons;
+    polygons.paths.push_back({ Point2LL(0, 0), Point2LL(1000, 0), Point2LL(1000, 1000), Point2LL(0, 1000) });
+    polygons.paths.push_back({ Point2LL(-5000000, 200), Point2LL(7000000, -300), Point2LL(100, 9000000) });
+    polygons.paths.emplace_back(); // An empty path is kept as well.
+
+    std::vector<uint8_t> buffer;
+    PolygonEncoder encoder(buffer);
+    encoder.writePolygons(polygons);
+    encoder.writePolygons(Polygons());
+    EXPECT_EQ(encoder.pointCount(), 7);
+    encoder.writePolygons(polygons);
+
+    PolygonDecoder decoder(buffer);
+    EXPECT_EQ(decoder.readPolygons().paths, polygons.paths);
+    EXPECT_TRUE(decoder.readPolygons().empty());
+    EXPECT_EQ(decoder.readPolygons().paths, polygons.paths);
+    EXPECT_TRUE(decoder.atEnd());
+
+    // Consecutive vertices are close together, so the encoding is smaller than the coordinates themselves.
+    EXPECT_LT(buffer.size(), 2 * 7 * sizeof(Point2LL));
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
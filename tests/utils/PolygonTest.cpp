@@ -141,6 +141,45 @@ TEST_F(PolygonTest, polygonOffsetBugTest)
     }
 }
 
+TEST_F(PolygonTest, offsetSequenceMatchesChainedOffsets)
+{
+    Polygons polys;
+    polys.add(pointy_square);
+    const Polygons chained = polys.offset(-10).offset(30).offset(-20);
+    const Polygons sequence = polys.offsetSequence({ -10, 30, -20 });
+
+    EXPECT_EQ(sequence.size(), chained.size());
+    EXPECT_NEAR(sequence.area(), chained.area(), 1.0);
+    EXPECT_TRUE(sequence.xorPolygons(chained).offset(-2).empty()) << "The sequence should cover the same area as the chained offsets.";
+}
+
+TEST_F(PolygonTest, morphologicalOpenRemovesSpikes)
+{
+    Polygons polys;
+    polys.add(pointy_square);
+    const Polygons opened = polys.morphologicalOpen(10);
+
+    EXPECT_FALSE(opened.inside(Point2LL(50, 170))) << "The spike is thinner than 20 and should be removed.";
+    EXPECT_TRUE(opened.inside(Point2LL(50, 50)));
+}
+
+TEST_F(PolygonTest, offsetMultiMatchesOffset)
+{
+    Polygons polys;
+    polys.add(test_square);
+    polys.add(triangle);
+    const std::vector<coord_t> distances = { -20, 0, 15, 60 };
+    const std::vector<Polygons> offsetted = polys.offsetMulti(distances);
+
+    ASSERT_EQ(offsetted.size(), distances.size());
+    for (size_t distance_idx = 0; distance_idx < distances.size(); ++distance_idx)
+    {
+        const Polygons expected = polys.offset(distances[distance_idx]);
+        EXPECT_EQ(offsetted[distance_idx].size(), expected.size()) << "Offset " << distances[distance_idx];
+        EXPECT_EQ(offsetted[distance_idx].area(), expected.area()) << "Offset " << distances[distance_idx];
+    }
+}
+
 TEST_F(PolygonTest, isOutsideTest)
 {
     Polygons test_triangle;
@@ -0,0 +1,110 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/PolygonsSoA.h" // The class under test.
+
+#include <cmath>
+#include <numbers>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "utils/AABB.h"
+#include "utils/Coord_t.h"
+#include "utils/polygon.h"
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+class PolygonsSoATest : public testing::Test
+{
+public:
+    Polygons shape; // Jagged outline with a hole, snapped to a coarse grid so that many query points end up exactly on edges and vertices.
+    std::vector<Point2LL> queries;
+
+    void SetUp() override
+    {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<coord_t> jitter(-3, 3);
+
+        Polygon outline;
+        constexpr size_t vertex_count = 301;
+        for (size_t i = 0; i < vertex_count; ++i)
+        {
+            const double angle = 2.0 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(vertex_count);
+            const coord_t radius = 100 + ((i % 2 == 0) ? 0 : 40) + jitter(rng);
+            outline.emplace_back(static_cast<coord_t>(std::llround(std::cos(angle) * radius)) * 10, static_cast<coord_t>(std::llround(std::sin(angle) * radius)) * 10);
+        }
+        shape.add(outline);
+
+        Polygon hole;
+        hole.emplace_back(-200, -200);
+        hole.emplace_back(-200, 200);
+        hole.emplace_back(200, 200);
+        hole.emplace_back(200, -200);
+        shape.add(hole);
+
+        Polygon degenerate; // Fewer than three vertices, so it doesn't count for inside checks.
+        degenerate.emplace_back(0, 0);
+        degenerate.emplace_back(500, 0);
+        shape.add(degenerate);
+
+        std::uniform_int_distribution<coord_t> coordinate(-160, 160);
+        for (size_t i = 0; i < 5000; ++i)
+        {
+            queries.emplace_back(coordinate(rng) * 10, coordinate(rng) * 10);
+        }
+        for (const ConstPolygonRef poly : shape)
+        {
+            for (const Point2LL& vertex : poly)
+            {
+                queries.push_back(vertex);
+            }
+        }
+    }
+};
+
+TEST_F(PolygonsSoATest, InsideMatchesPolygons)
+{
+    const PolygonsSoA view(shape);
+    ASSERT_TRUE(view.isFlattened()) << "The test shape is large enough to get flattened.";
+    for (const Point2LL& query : queries)
+    {
+        for (const bool border_result : { false, true })
+        {
+            EXPECT_EQ(view.inside(query, border_result), shape.inside(query, border_result)) << "Query point " << query << " with border_result " << border_result << ".";
+        }
+    }
+}
+
+TEST_F(PolygonsSoATest, SmallShapeDelegates)
+{
+    const PolygonsSoA view(shape, shape.pointCount() + 1);
+    EXPECT_FALSE(view.isFlattened());
+    for (const Point2LL& query : queries)
+    {
+        EXPECT_EQ(view.inside(query, true), shape.inside(query, true));
+    }
+}
+
+TEST_F(PolygonsSoATest, BoundingBoxMatchesAABB)
+{
+    const PolygonsSoA view(shape);
+    const AABB aabb(shape);
+    EXPECT_EQ(view.min(), aabb.min_);
+    EXPECT_EQ(view.max(), aabb.max_);
+}
+
+TEST(PolygonsSoABoundingBoxTest, OddPointCount)
+{
+    const std::vector<Point2LL> points = { Point2LL(5, -3), Point2LL(-7, 2), Point2LL(1, 9) };
+    Point2LL min(POINT_MAX, POINT_MAX);
+    Point2LL max(POINT_MIN, POINT_MIN);
+    PolygonsSoA::boundingBox(points.data(), points.size(), min, max);
+    EXPECT_EQ(min, Point2LL(-7, -3));
+    EXPECT_EQ(max, Point2LL(5, 9));
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
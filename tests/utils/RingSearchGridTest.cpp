@@ -0,0 +1,99 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/RingSearchGrid.h" // The class under test.
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+/*!
+ * Find the nearest point with a ring search, stopping as soon as the rings
+ * can't contain anything closer.
+ */
+size_t findNearest(RingSearchGrid<size_t>& grid, const Point2LL& query, const std::vector<bool>& removed)
+{
+    coord_t best_distance2 = std::numeric_limits<coord_t>::max();
+    size_t best_idx = std::numeric_limits<size_t>::max();
+    grid.processByDistance(
+        query,
+        [&best_distance2](const coord_t min_distance2)
+        {
+            return min_distance2 <= best_distance2;
+        },
+        [&](const RingSearchGrid<size_t>::Elem& elem)
+        {
+            if (removed[elem.val])
+            {
+                return false;
+            }
+            const coord_t distance2 = vSize2(elem.point - query);
+            if (distance2 < best_distance2 || (distance2 == best_distance2 && elem.val < best_idx))
+            {
+                best_distance2 = distance2;
+                best_idx = elem.val;
+            }
+            return true;
+        });
+    return best_idx;
+}
+
+TEST(RingSearchGridTest, EmptyGrid)
+{
+    RingSearchGrid<size_t> grid(100);
+    EXPECT_TRUE(grid.empty());
+    EXPECT_EQ(findNearest(grid, Point2LL(0, 0), {}), std::numeric_limits<size_t>::max());
+}
+
+TEST(RingSearchGridTest, FarAwayQuery)
+{
+    RingSearchGrid<size_t> grid(10);
+    grid.insert(Point2LL(0, 0), 0);
+    grid.insert(Point2LL(5, 95), 1);
+    EXPECT_EQ(findNearest(grid, Point2LL(100000, 100000), { false, false }), 1);
+    EXPECT_EQ(findNearest(grid, Point2LL(-100000, -3), { false, false }), 0);
+}
+
+TEST(RingSearchGridTest, MatchesBruteForceWhileRemoving)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<coord_t> coordinate(-50000, 50000);
+    constexpr size_t point_count = 500;
+    std::vector<Point2LL> points;
+    RingSearchGrid<size_t> grid(3000);
+    for (size_t point_idx = 0; point_idx < point_count; ++point_idx)
+    {
+        points.emplace_back(coordinate(generator), coordinate(generator));
+        grid.insert(points.back(), point_idx);
+    }
+
+    // A greedy tour removes every point it visits, leaving ever sparser points to search through.
+    std::vector<bool> removed(point_count, false);
+    Point2LL position(0, 0);
+    for (size_t step = 0; step < point_count; ++step)
+    {
+        size_t expected = point_count;
+        for (size_t point_idx = 0; point_idx < point_count; ++point_idx)
+        {
+            if (! removed[point_idx] && (expected == point_count || vSize2(points[point_idx] - position) < vSize2(points[expected] - position)))
+            {
+                expected = point_idx;
+            }
+        }
+        const size_t nearest = findNearest(grid, position, removed);
+        ASSERT_EQ(nearest, expected) << "Step " << step;
+        removed[nearest] = true;
+        position = points[nearest];
+    }
+    findNearest(grid, position, removed); // Removes the last point.
+    EXPECT_TRUE(grid.empty());
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -0,0 +1,66 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/SeamCornerCache.h" // The class under test.
+
+#include <gtest/gtest.h>
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+class SeamCornerCacheTest : public testing::Test
+{
+public:
+    Polygon square;
+    size_t computations = 0;
+
+    void SetUp() override
+    {
+        SeamCornerCache::clear();
+        computations = 0;
+        square.clear();
+        square.add(Point2LL(0, 0));
+        square.add(Point2LL(1000, 0));
+        square.add(Point2LL(1000, 1000));
+        square.add(Point2LL(0, 1000));
+    }
+
+    SeamCornerCache::Angles compute(const double angle)
+    {
+        ++computations;
+        return SeamCornerCache::Angles(3, angle);
+    }
+};
+
+TEST_F(SeamCornerCacheTest, TranslatedShapeIsReused)
+{
+    const auto first = SeamCornerCache::get(square, [this]() { return compute(0.5); });
+    square.translate(Point2LL(12345, -678));
+    const auto second = SeamCornerCache::get(square, [this]() { return compute(-0.5); });
+
+    EXPECT_EQ(computations, 1);
+    EXPECT_EQ(*second, *first);
+}
+
+TEST_F(SeamCornerCacheTest, DifferentShapeIsComputed)
+{
+    SeamCornerCache::get(square, [this]() { return compute(0.5); });
+    square[2] = Point2LL(1000, 1001);
+    const auto other = SeamCornerCache::get(square, [this]() { return compute(-0.5); });
+
+    EXPECT_EQ(computations, 2);
+    EXPECT_EQ(other->front(), -0.5);
+}
+
+TEST_F(SeamCornerCacheTest, ClearedAnglesStayValid)
+{
+    const auto angles = SeamCornerCache::get(square, [this]() { return compute(0.5); });
+    SeamCornerCache::clear();
+    EXPECT_EQ(angles->size(), 3);
+    SeamCornerCache::get(square, [this]() { return compute(0.5); });
+    EXPECT_EQ(computations, 2);
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)
@@ -350,6 +350,21 @@ TEST_F(SimplifyTest, Collinear)
     EXPECT_EQ(simplified.size(), 4) << "The square has 4 corners. All other extra vertices deviate by less than the minimum resolution.";
 }
 
+/*!
+ * Tests that simplifying a second time doesn't change anything, whether the
+ * first pass left nothing to remove or not.
+ */
+TEST_F(SimplifyTest, AlreadySimplified)
+{
+    Polygon simplified = simplifier.polygon(circle);
+    ASSERT_LT(simplified.size(), circle.size()) << "The first pass should have removed vertices.";
+    Polygon simplified_again = simplifier.polygon(simplified);
+    EXPECT_EQ(*simplified_again, *simplified) << "Every vertex that could be removed was already removed.";
+
+    Polygon simplified_polyline = simplifier.polyline(spiral);
+    EXPECT_EQ(*simplifier.polyline(simplified_polyline), *simplified_polyline) << "Every vertex that could be removed was already removed.";
+}
+
 /*!
  * Tests that duplicate vertices are always removed.
  */
@@ -300,4 +300,73 @@ TEST_F(GetNearestTest, Equal)
         << ")."; // FIXME: simplify once fmt or we use C++20 is added as a dependency
 }
 
+TEST_F(GetNearestTest, EqualInSameCellPrefersLatest)
+{
+    constexpr coord_t grid_size = 10;
+    const Point2LL target(100, 100);
+    SparsePointGridInclusive<Point2LL> grid(grid_size);
+    grid.insert(Point2LL(102, 100), Point2LL(102, 100));
+    grid.insert(Point2LL(100, 102), Point2LL(100, 102)); // Same cell and same distance.
+
+    typename SparsePointGridInclusive<Point2LL>::Elem result;
+    ASSERT_TRUE(grid.getNearest(target, grid_size, result));
+    EXPECT_EQ(result.val, Point2LL(100, 102)) << "Of two equally near points in the same cell, the one inserted last is found, like with the unordered_multimap grid before.";
+
+    grid.compact();
+    ASSERT_TRUE(grid.getNearest(target, grid_size, result));
+    EXPECT_EQ(result.val, Point2LL(100, 102)) << "Compacting doesn't change which point is found.";
+}
+
+TEST(SparseGridCompactTest, VisitsCellFromNewestToOldest)
+{
+    constexpr coord_t grid_size = 10;
+    SparsePointGridInclusive<size_t> grid(grid_size);
+    for (size_t val = 0; val < 5; ++val)
+    {
+        grid.insert(Point2LL(51, 52), val);
+    }
+    const std::vector<size_t> expected{ 4, 3, 2, 1, 0 };
+    EXPECT_EQ(grid.getNearbyVals(Point2LL(55, 55), 1), expected);
+
+    grid.compact();
+    EXPECT_EQ(grid.getNearbyVals(Point2LL(55, 55), 1), expected);
+
+    grid.insert(Point2LL(53, 54), 5);
+    const std::vector<size_t> expected_after_insert{ 5, 4, 3, 2, 1, 0 };
+    EXPECT_EQ(grid.getNearbyVals(Point2LL(55, 55), 1), expected_after_insert);
+}
+
+TEST(SparseGridCompactTest, CompactKeepsCellContents)
+{
+    constexpr coord_t grid_size = 10;
+    SparsePointGridInclusive<size_t> grid(grid_size);
+    std::vector<Point2LL> points;
+    for (coord_t x = -200; x <= 200; x += 7)
+    {
+        for (coord_t y = -200; y <= 200; y += 13)
+        {
+            grid.insert(Point2LL(x, y), points.size());
+            points.emplace_back(x, y);
+        }
+    }
+
+    const Point2LL target(33, -41);
+    std::vector<size_t> before = grid.getNearbyVals(target, grid_size * 3);
+    grid.compact();
+    std::vector<size_t> after = grid.getNearbyVals(target, grid_size * 3);
+    EXPECT_EQ(before, after) << "Compacting the grid must not change which elements are visited, nor their order.";
+    EXPECT_EQ(grid.size(), points.size());
+
+    // Inserting after compaction must keep the earlier elements reachable.
+    grid.insert(target, points.size());
+    points.push_back(target);
+    after = grid.getNearbyVals(target, grid_size * 3);
+    EXPECT_EQ(after.size(), before.size() + 1);
+    EXPECT_NE(std::find(after.begin(), after.end(), points.size() - 1), after.end());
+    for (const size_t idx : before)
+    {
+        EXPECT_NE(std::find(after.begin(), after.end(), idx), after.end());
+    }
+}
+
 } // namespace cura
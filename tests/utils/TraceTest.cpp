@@ -0,0 +1,72 @@
+// Copyright (c) 2024 UltiMaker
+// CuraEngine is released under the terms of the AGPLv3 or higher.
+
+#include "utils/Trace.h" // The class under test.
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+// NOLINTBEGIN(*-magic-numbers)
+namespace cura
+{
+
+TEST(TraceTest, WritesChromeTrace)
+{
+    const std::filesystem::path trace_file = std::filesystem::temp_directory_path() / "cura_trace_test.json";
+    {
+        TraceSpan before_enabled("notRecorded");
+    }
+    Trace::enable(trace_file);
+    {
+        TraceSpan outer("outer");
+        TraceSpan layer("layer", 12);
+        TraceSpan mesh("mesh \"quoted\"", 3, "some\\mesh.stl");
+    }
+    std::thread worker(
+        []()
+        {
+            TraceSpan span("worker");
+        });
+    worker.join();
+    Trace::write();
+    EXPECT_FALSE(Trace::isEnabled());
+
+    std::ifstream in(trace_file);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    rapidjson::Document document;
+    document.Parse(contents.str().c_str());
+    ASSERT_FALSE(document.HasParseError()) << contents.str();
+
+    const rapidjson::Value& events = document["traceEvents"];
+    ASSERT_TRUE(events.IsArray());
+    std::map<std::string, const rapidjson::Value*> spans;
+    for (const rapidjson::Value& event : events.GetArray())
+    {
+        if (std::string(event["ph"].GetString()) == "X")
+        {
+            spans[event["name"].GetString()] = &event;
+        }
+    }
+    EXPECT_EQ(spans.size(), 4);
+    EXPECT_FALSE(spans.contains("notRecorded"));
+    ASSERT_TRUE(spans.contains("layer"));
+    EXPECT_EQ((*spans["layer"])["args"]["layer"].GetInt64(), 12);
+    ASSERT_TRUE(spans.contains("mesh \"quoted\""));
+    EXPECT_EQ(std::string((*spans["mesh \"quoted\""])["args"]["mesh"].GetString()), "some\\mesh.stl");
+    ASSERT_TRUE(spans.contains("worker"));
+    EXPECT_NE((*spans["worker"])["tid"].GetInt(), (*spans["outer"])["tid"].GetInt());
+    EXPECT_GE((*spans["outer"])["dur"].GetInt64(), (*spans["layer"])["dur"].GetInt64());
+
+    std::filesystem::remove(trace_file);
+}
+
+} // namespace cura
+// NOLINTEND(*-magic-numbers)